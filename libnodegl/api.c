@@ -40,6 +40,8 @@ struct ngl_ctx *ngl_create(void)
     if (!s)
         return NULL;
 
+    s->prefetch_margin = 0.25;
+
     LOG(INFO, "Context create in node.gl v%d.%d.%d",
         NODEGL_VERSION_MAJOR, NODEGL_VERSION_MINOR, NODEGL_VERSION_MICRO);
     return s;
@@ -54,6 +56,15 @@ int ngl_set_glcontext(struct ngl_ctx *s, void *display, void *window, void *hand
     return ngli_glcontext_load_extensions(s->glcontext);
 }
 
+int ngl_set_glcontext_offscreen(struct ngl_ctx *s, int width, int height, int platform, int api)
+{
+    s->glcontext = ngli_glcontext_new_offscreen(width, height, platform, api);
+    if (!s->glcontext)
+        return -1;
+
+    return 0;
+}
+
 int ngl_set_glstates(struct ngl_ctx *s, int nb_glstates, struct ngl_node **glstates)
 {
     for (int i = 0; i < s->nb_glstates; i++) {
@@ -85,6 +96,7 @@ int ngl_set_glstates(struct ngl_ctx *s, int nb_glstates, struct ngl_node **glsta
 int ngl_set_scene(struct ngl_ctx *s, struct ngl_node *scene)
 {
     if (s->scene) {
+        ngli_node_reset_graph(s);
         ngli_node_detach_ctx(s->scene);
         ngl_node_unrefp(&s->scene);
     }
@@ -95,9 +107,203 @@ int ngl_set_scene(struct ngl_ctx *s, struct ngl_node *scene)
 
     ngl_node_ref(scene);
     s->scene = scene;
+    return ngli_node_compile_graph(s);
+}
+
+int ngl_set_nb_threads(struct ngl_ctx *s, int nb_threads)
+{
+    ngli_threadpool_freep(&s->threadpool);
+
+    if (nb_threads <= 0)
+        return 0;
+
+    s->threadpool = ngli_threadpool_create(nb_threads);
+    if (!s->threadpool)
+        return -1;
+
+    return 0;
+}
+
+int ngl_set_async_prefetch(struct ngl_ctx *s, int enabled)
+{
+    if (s->scene) {
+        LOG(ERROR, "async prefetch can not be changed while a scene is set");
+        return -1;
+    }
+
+    ngli_loader_freep(&s->loader);
+
+    if (!enabled)
+        return 0;
+
+    if (!s->glcontext || !s->glcontext->loaded) {
+        LOG(ERROR, "glcontext not loaded");
+        return -1;
+    }
+
+    s->loader = ngli_loader_create(s->glcontext);
+    if (!s->loader)
+        return -1;
+
+    return 0;
+}
+
+int ngl_set_gpu_memory_budget(struct ngl_ctx *s, int64_t budget)
+{
+    if (budget < 0)
+        return -1;
+    s->gpu_memory_budget = budget;
+    return 0;
+}
+
+int64_t ngl_get_gpu_memory(struct ngl_ctx *s, int type)
+{
+    if (type == NGL_GPU_MEMORY_TOTAL)
+        return s->gpu_memory_total;
+    if (type < 0 || type >= NGLI_GPU_MEMORY_NB)
+        return -1;
+    return s->gpu_memory[type];
+}
+
+int ngl_set_prefetch_margin(struct ngl_ctx *s, double margin)
+{
+    if (margin < 0)
+        return -1;
+    s->prefetch_margin = margin;
+    return 0;
+}
+
+int ngl_set_program_cache_dir(struct ngl_ctx *s, const char *dir)
+{
+    /* The loader thread may be reading the directory to load or save a binary */
+    if (s->scene && s->loader) {
+        LOG(ERROR, "program cache directory can not be changed while a scene is set with async prefetch");
+        return -1;
+    }
+
+    return ngli_programcache_set_dir(s, dir);
+}
+
+int ngl_prepare_shaders(struct ngl_ctx *s)
+{
+    if (!s->glcontext->loaded) {
+        LOG(ERROR, "glcontext not loaded");
+        return -1;
+    }
+
+    if (!s->scene) {
+        LOG(ERROR, "scene is not set, can not prepare shaders");
+        return -1;
+    }
+
+    if (s->graph_changed) {
+        int ret = ngli_node_compile_graph(s);
+        if (ret < 0)
+            return ret;
+    }
+
+    return ngli_node_finalize_shaders(s);
+}
+
+int ngl_set_stats(struct ngl_ctx *s, int enabled)
+{
+    s->stats_enabled = enabled;
+    if (enabled)
+        ngli_stats_reset(s);
     return 0;
 }
 
+char *ngl_get_stats(struct ngl_ctx *s)
+{
+    if (!s->scene) {
+        LOG(ERROR, "scene is not set, no statistics available");
+        return NULL;
+    }
+
+    if (s->graph_changed) {
+        int ret = ngli_node_compile_graph(s);
+        if (ret < 0)
+            return NULL;
+    }
+
+    return ngli_stats_report(s);
+}
+
+int ngl_set_trace(struct ngl_ctx *s, int nb_events)
+{
+    /* The loader thread may be recording a prefetch */
+    if (s->scene && s->loader) {
+        LOG(ERROR, "trace can not be changed while a scene is set with async prefetch");
+        return -1;
+    }
+
+    ngli_trace_freep(&s->trace);
+
+    if (nb_events <= 0)
+        return 0;
+
+    s->trace = ngli_trace_create(nb_events);
+    if (!s->trace)
+        return -1;
+
+    return 0;
+}
+
+char *ngl_get_gl_log(struct ngl_ctx *s)
+{
+    if (!s->glcontext || s->glcontext->platform != NGL_GLPLATFORM_NULL) {
+        LOG(ERROR, "GL calls are only recorded with the null GL platform");
+        return NULL;
+    }
+
+    return ngli_glcontext_null_get_log(s->glcontext);
+}
+
+char *ngl_get_trace(struct ngl_ctx *s)
+{
+    if (!s->trace) {
+        LOG(ERROR, "trace is not enabled");
+        return NULL;
+    }
+
+    return ngli_trace_dump(s->trace);
+}
+
+int ngl_prepare(struct ngl_ctx *s, double t_start, double t_end,
+                ngl_progress_callback_type callback, void *arg)
+{
+    if (!s->glcontext->loaded) {
+        LOG(ERROR, "glcontext not loaded");
+        return -1;
+    }
+
+    if (!s->scene) {
+        LOG(ERROR, "scene is not set, can not prepare it");
+        return -1;
+    }
+
+    if (t_end < t_start) {
+        LOG(ERROR, "invalid time window [%f,%f]", t_start, t_end);
+        return -1;
+    }
+
+    if (s->graph_changed) {
+        int ret = ngli_node_compile_graph(s);
+        if (ret < 0)
+            return ret;
+    }
+
+    /* The user may have altered the GL state since the last frame */
+    ngli_glcache_invalidate(s->glcontext);
+
+    if (s->trace)
+        ngli_trace_add(s->trace, NGLI_TRACE_PREPARE, 'B', NULL, NULL, t_start);
+    int ret = ngli_node_prepare(s, t_start, t_end, callback, arg);
+    if (s->trace)
+        ngli_trace_add(s->trace, NGLI_TRACE_PREPARE, 'E', NULL, NULL, t_start);
+    return ret;
+}
+
 int ngl_draw(struct ngl_ctx *s, double t)
 {
     struct glcontext *glcontext = s->glcontext;
@@ -114,18 +320,36 @@ int ngl_draw(struct ngl_ctx *s, double t)
         return -1;
     }
 
+    if (s->graph_changed) {
+        int ret = ngli_node_compile_graph(s);
+        if (ret < 0)
+            return ret;
+    }
+
     LOG(DEBUG, "draw scene %s @ t=%f", scene->name, t);
 
+    s->frame_index++;
+
+    if (s->trace)
+        ngli_trace_add(s->trace, NGLI_TRACE_FRAME, 'B', NULL, NULL, t);
+
+    /* The user may have altered the GL state since the last frame */
+    ngli_glcache_invalidate(glcontext);
+
     ngli_honor_glstates(s, s->nb_glstates, s->glstates);
 
     ngli_glClear(gl, GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
-    ngli_node_check_resources(scene, t);
-    ngli_node_update(scene, t);
-    ngli_node_draw(scene);
+    ngli_node_check_resources(s, t);
+    ngli_node_update_graph(s, t);
+    ngli_node_draw_graph(s);
+    ngli_node_honor_gpu_memory_budget(s);
 
     ngli_restore_glstates(s, s->nb_glstates, s->glstates);
 
+    if (s->trace)
+        ngli_trace_add(s->trace, NGLI_TRACE_FRAME, 'E', NULL, NULL, t);
+
     if (ngli_glcontext_check_gl_error(glcontext))
         return -1;
 
@@ -140,9 +364,14 @@ void ngl_free(struct ngl_ctx **ss)
         return;
 
     if (s->scene) {
+        ngli_node_reset_graph(s);
         ngli_node_detach_ctx(s->scene);
         ngl_node_unrefp(&s->scene);
     }
+    ngli_threadpool_freep(&s->threadpool);
+    ngli_programcache_reset(s);
+    ngli_loader_freep(&s->loader);
+    ngli_trace_freep(&s->trace);
     ngli_glcontext_freep(&s->glcontext);
     free(*ss);
     *ss = NULL;
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "log.h"
+#include "utils.h"
+
+#define BLOCK_SIZE (64 * 1024)
+
+struct block {
+    struct block *next;
+    size_t size;
+    size_t used;
+    uint8_t *data;
+};
+
+struct arena {
+    int refcount;
+    struct block *blocks; /* the current block is the first one */
+};
+
+struct arena *ngli_arena_create(void)
+{
+    struct arena *arena = calloc(1, sizeof(*arena));
+    if (!arena)
+        return NULL;
+    arena->refcount = 1;
+    return arena;
+}
+
+struct arena *ngli_arena_ref(struct arena *arena)
+{
+    arena->refcount++;
+    return arena;
+}
+
+static struct block *block_create(size_t size)
+{
+    struct block *block = calloc(1, sizeof(*block));
+    if (!block)
+        return NULL;
+
+    void *data = NULL;
+    if (posix_memalign(&data, NGLI_ALIGN, size)) {
+        free(block);
+        return NULL;
+    }
+    block->data = data;
+    block->size = size;
+    return block;
+}
+
+void *ngli_arena_allocz(struct arena *arena, size_t size)
+{
+    size = (size + NGLI_ALIGN - 1) & ~(size_t)(NGLI_ALIGN - 1);
+
+    struct block *block = arena->blocks;
+    if (!block || block->size - block->used < size) {
+        block = block_create(NGLI_MAX(size, BLOCK_SIZE));
+        if (!block)
+            return NULL;
+
+        /*
+         * Keep filling the current block if the new one is dedicated to an
+         * allocation larger than the regular block size.
+         */
+        if (size > BLOCK_SIZE && arena->blocks) {
+            block->next = arena->blocks->next;
+            arena->blocks->next = block;
+        } else {
+            block->next = arena->blocks;
+            arena->blocks = block;
+        }
+    }
+
+    void *ptr = block->data + block->used;
+    block->used += size;
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+void ngli_arena_unrefp(struct arena **arenap)
+{
+    struct arena *arena = *arenap;
+
+    if (!arena)
+        return;
+
+    if (--arena->refcount == 0) {
+        size_t total = 0;
+        struct block *block = arena->blocks;
+        while (block) {
+            struct block *next = block->next;
+            total += block->size;
+            free(block->data);
+            free(block);
+            block = next;
+        }
+        LOG(VERBOSE, "release arena of %zu bytes", total);
+        free(arena);
+    }
+    *arenap = NULL;
+}
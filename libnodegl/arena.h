@@ -0,0 +1,40 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/*
+ * Refcounted bump allocator. Allocations are never freed individually: the
+ * memory is released all at once when the last reference is dropped.
+ */
+struct arena;
+
+struct arena *ngli_arena_create(void);
+struct arena *ngli_arena_ref(struct arena *arena);
+void ngli_arena_unrefp(struct arena **arenap);
+
+/* Return zeroed memory aligned on NGLI_ALIGN */
+void *ngli_arena_allocz(struct arena *arena, size_t size);
+
+#endif
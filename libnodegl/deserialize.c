@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "arena.h"
 #include "log.h"
 #include "nodegl.h"
 #include "nodes.h"
@@ -318,6 +319,7 @@ struct ngl_node *ngl_node_deserialize(const char *str)
 {
     struct ngl_node *node = NULL;
     struct serial_ctx sctx = {0};
+    struct arena *arena = NULL;
 
     char *s = ngli_strdup(str);
     if (!s)
@@ -341,12 +343,20 @@ struct ngl_node *ngl_node_deserialize(const char *str)
     }
     s += strcspn(s, "\n");
 
+    /*
+     * All the nodes of the scene and their private data are allocated
+     * contiguously in a shared arena, released with the last node.
+     */
+    arena = ngli_arena_create();
+    if (!arena)
+        goto end;
+
     while (s < end) {
         const int type = strtol(s, &s, 16);
         if (*s == ' ')
             s++;
 
-        node = ngli_node_create_noconstructor(type);
+        node = ngli_node_create_noconstructor(arena, type);
         if (!node)
             break;
 
@@ -356,6 +366,10 @@ struct ngl_node *ngl_node_deserialize(const char *str)
         s[eol] = 0;
 
         set_node_params(&sctx, s, node);
+        if (ngli_node_cache_children(node) < 0) {
+            node = NULL;
+            break;
+        }
 
         s += eol + 1;
     }
@@ -368,6 +382,7 @@ struct ngl_node *ngl_node_deserialize(const char *str)
     free(sctx.nodes);
 
 end:
+    ngli_arena_unrefp(&arena);
     free(sstart);
     return node;
 }
@@ -23,15 +23,12 @@
 #include <string.h>
 
 #include "bstr.h"
-#include "ndict.h"
 #include "nodegl.h"
 #include "nodes.h"
 
 #define LB "<br align=\"left\"/>"
 #define HSLFMT "\"%f 0.6 0.9\""
 
-extern const struct node_param ngli_base_node_params[];
-
 struct decl {
     const void *id;
     struct decl *next;
@@ -125,7 +122,6 @@ static void print_custom_priv_options(struct bstr *b, const struct ngl_node *nod
 }
 
 static void print_decls(struct bstr *b, const struct ngl_node *node,
-                        const struct node_param *p, uint8_t *priv,
                         struct decl **idxdecls);
 
 static void print_all_decls(struct bstr *b, const struct ngl_node *node, struct decl **idxdecls)
@@ -138,16 +134,15 @@ static void print_all_decls(struct bstr *b, const struct ngl_node *node, struct
     print_custom_priv_options(b, node);
     ngli_bstr_print(b, ">,color="HSLFMT"]\n", get_hue(node->class->name));
 
-    print_decls(b, node, ngli_base_node_params, (uint8_t *)node, idxdecls);
-    print_decls(b, node, node->class->params, node->priv_data, idxdecls);
+    print_decls(b, node, idxdecls);
 }
 
 static void print_packed_decls(struct bstr *b, const char *name,
-                               struct ngl_node **children, int nb_children)
+                               const struct node_child *children, int nb_children)
 {
     ngli_bstr_print(b, "    %s_%p[label=<<b>%s</b> (x%d)", name, children, name, nb_children);
     for (int i = 0; i < nb_children; i++) {
-        const struct ngl_node *node = children[i];
+        const struct ngl_node *node = children[i].node;
         char *info_str = node->class->info_str ? node->class->info_str(node) : NULL;
         ngli_bstr_print(b, LB "- %s", info_str ? info_str : "?");
         free(info_str);
@@ -155,42 +150,41 @@ static void print_packed_decls(struct bstr *b, const char *name,
     ngli_bstr_print(b, LB ">,shape=box,color="HSLFMT"]\n", get_hue(name));
 }
 
+/*
+ * Return the number of children packed in a single box starting at the given
+ * index, or 0 if the child is not part of a packed list.
+ */
+static int get_nb_packed(const struct ngl_node *node, int start)
+{
+    const struct node_param *par = node->children[start].par;
+
+    if (par->type != PARAM_TYPE_NODELIST || !(par->flags & PARAM_FLAG_DOT_DISPLAY_PACKED))
+        return 0;
+
+    int i = start;
+    while (i < node->nb_children && node->children[i].par == par)
+        i++;
+    return i - start;
+}
+
 static void print_decls(struct bstr *b, const struct ngl_node *node,
-                        const struct node_param *p, uint8_t *priv,
                         struct decl **idxdecls)
 {
-    while (p && p->key) {
-        switch (p->type) {
-            case PARAM_TYPE_NODE: {
-                const struct ngl_node *child = *(struct ngl_node **)(priv + p->offset);
-                if (child)
-                    print_all_decls(b, child, idxdecls);
-                break;
-            }
-            case PARAM_TYPE_NODELIST: {
-                struct ngl_node **children = *(struct ngl_node ***)(priv + p->offset);
-                const int nb_children = *(int *)(priv + p->offset + sizeof(struct ngl_node **));
-
-                if (nb_children && (p->flags & PARAM_FLAG_DOT_DISPLAY_PACKED)) {
-                    if (list_check(idxdecls, children))
-                        break;
-                    print_packed_decls(b, p->key, children, nb_children);
-                    break;
-                }
-
-                for (int i = 0; i < nb_children; i++)
-                    print_all_decls(b, children[i], idxdecls);
-                break;
-            }
-            case PARAM_TYPE_NODEDICT: {
-                struct ndict *ndict = *(struct ndict **)(priv + p->offset);
-                struct ndict_entry *entry = NULL;
-                while ((entry = ngli_ndict_get(ndict, NULL, entry)))
-                    print_all_decls(b, entry->node, idxdecls);
-                break;
-            }
+    int i = 0;
+
+    while (i < node->nb_children) {
+        const struct node_child *child = &node->children[i];
+        const int nb_packed = get_nb_packed(node, i);
+
+        if (nb_packed) {
+            if (!list_check(idxdecls, child))
+                print_packed_decls(b, child->par->key, child, nb_packed);
+            i += nb_packed;
+            continue;
         }
-        p++;
+
+        print_all_decls(b, child->node, idxdecls);
+        i++;
     }
 }
 
@@ -235,84 +229,42 @@ static void print_link(struct bstr *b,
                     x->class->name, x, y->class->name, y, label);
 }
 
-static void print_links(struct bstr *b, const struct ngl_node *node,
-                        const struct node_param *p, uint8_t *priv,
-                        struct link **idxlinks);
-
 static void print_all_links(struct bstr *b, const struct ngl_node *node, struct link **idxlinks)
 {
-    print_links(b, node, ngli_base_node_params, (uint8_t *)node, idxlinks);
-    print_links(b, node, node->class->params, node->priv_data, idxlinks);
-}
+    int i = 0;
+
+    while (i < node->nb_children) {
+        const struct node_child *child = &node->children[i];
+        const struct node_param *p = child->par;
+        const int fieldname = p->flags & PARAM_FLAG_DOT_DISPLAY_FIELDNAME;
+        const int nb_packed = get_nb_packed(node, i);
+
+        if (nb_packed) {
+            if (!list_check_links(idxlinks, node, child))
+                ngli_bstr_print(b, "    %s_%p -> %s_%p[label=\"%s\"]\n",
+                                node->class->name, node, p->key, child,
+                                fieldname ? p->key : "");
+            i += nb_packed;
+            continue;
+        }
 
-static void print_links(struct bstr *b, const struct ngl_node *node,
-                        const struct node_param *p, uint8_t *priv,
-                        struct link **idxlinks)
-{
-    while (p && p->key) {
-        char *label = ngli_asprintf("[label=\"%s\"]",
-                                    (p->flags & PARAM_FLAG_DOT_DISPLAY_FIELDNAME) ? p->key : "");
-        switch (p->type) {
-            case PARAM_TYPE_NODE: {
-                const struct ngl_node *child = *(struct ngl_node **)(priv + p->offset);
-                if (child) {
-                    if (list_check_links(idxlinks, node, child))
-                        break;
-                    print_link(b, node, child, label);
-                    print_all_links(b, child, idxlinks);
-                }
-                break;
-            }
-            case PARAM_TYPE_NODELIST: {
-                struct ngl_node **children = *(struct ngl_node ***)(priv + p->offset);
-                const int nb_children = *(int *)(priv + p->offset + sizeof(struct ngl_node **));
-
-                if (nb_children && (p->flags & PARAM_FLAG_DOT_DISPLAY_PACKED)) {
-                    if (list_check_links(idxlinks, node, children))
-                        break;
-                    ngli_bstr_print(b, "    %s_%p -> %s_%p%s\n",
-                                    node->class->name, node, p->key, children, label);
-                    break;
-                }
-
-                for (int i = 0; i < nb_children; i++) {
-                    const struct ngl_node *child = children[i];
-
-                    if (list_check_links(idxlinks, node, child))
-                        continue;
-                    print_link(b, node, child, label);
-                    print_all_links(b, child, idxlinks);
-                }
-                break;
-            }
-            case PARAM_TYPE_NODEDICT: {
-                struct ndict *ndict = *(struct ndict **)(priv + p->offset);
-                struct ndict_entry *entry = NULL;
-
-                while ((entry = ngli_ndict_get(ndict, NULL, entry))) {
-                    char *key;
-                    const struct ngl_node *child = entry->node;
-
-                    if (p->flags & PARAM_FLAG_DOT_DISPLAY_FIELDNAME)
-                        key = ngli_asprintf("[label=\"%s:%s\"]", p->key, entry->name);
-                    else
-                        key = ngli_asprintf("[label=\"%s\"]", entry->name);
-
-                    if (!key)
-                        return;
-
-                    if (list_check_links(idxlinks, node, child))
-                        continue;
-                    print_link(b, node, child, key);
-                    print_all_links(b, child, idxlinks);
-
-                    free(key);
-                }
-                break;
-            }
+        char *label;
+        if (p->type == PARAM_TYPE_NODEDICT && fieldname)
+            label = ngli_asprintf("[label=\"%s:%s\"]", p->key, child->key);
+        else if (p->type == PARAM_TYPE_NODEDICT)
+            label = ngli_asprintf("[label=\"%s\"]", child->key);
+        else
+            label = ngli_asprintf("[label=\"%s\"]", fieldname ? p->key : "");
+        if (!label)
+            return;
+
+        if (!list_check_links(idxlinks, node, child->node)) {
+            print_link(b, node, child->node, label);
+            print_all_links(b, child->node, idxlinks);
         }
+
         free(label);
-        p++;
+        i++;
     }
 }
 
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#if defined(TARGET_LINUX)
+#define _GNU_SOURCE /* syscall() */
+#endif
+
+#include <errno.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(TARGET_LINUX)
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "framering.h"
+#include "log.h"
+#include "nodegl.h"
+
+#if defined(TARGET_LINUX)
+
+/* Delay between 2 checks of the consumer liveness while waiting for it */
+#define CONSUMER_CHECK_DELAY_NS 100000000
+
+struct framering {
+    struct ngl_framering_header *header;
+    struct ngl_framering_slot *slots;
+    uint8_t *data;
+    size_t map_size;
+    uint64_t nb_written;
+    int dropping;
+};
+
+static int futex_wait(uint32_t *addr, uint32_t val, const struct timespec *timeout)
+{
+    return syscall(SYS_futex, addr, FUTEX_WAIT, val, timeout, NULL, 0);
+}
+
+static void futex_wake(uint32_t *addr)
+{
+    syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+static int fill_layout(struct ngl_framering_header *h, int width, int height, int format)
+{
+    const uint32_t luma_size = width * height;
+
+    switch (format) {
+    case NGL_PIXFMT_RGBA:
+        h->nb_planes = 1;
+        h->linesizes[0] = width * 4;
+        h->frame_size = (uint64_t)luma_size * 4;
+        break;
+    case NGL_PIXFMT_NV12:
+        h->nb_planes = 2;
+        h->linesizes[0] = width;
+        h->linesizes[1] = width;
+        h->plane_offsets[1] = luma_size;
+        h->frame_size = (uint64_t)luma_size * 3 / 2;
+        break;
+    case NGL_PIXFMT_I420:
+        h->nb_planes = 3;
+        h->linesizes[0] = width;
+        h->linesizes[1] = width / 2;
+        h->linesizes[2] = width / 2;
+        h->plane_offsets[1] = luma_size;
+        h->plane_offsets[2] = luma_size + luma_size / 4;
+        h->frame_size = (uint64_t)luma_size * 3 / 2;
+        break;
+    default:
+        LOG(ERROR, "unsupported frame ring format %d", format);
+        return -1;
+    }
+
+    return 0;
+}
+
+int ngl_framering_create(int width, int height, int format, int nb_slots)
+{
+    if (width <= 0 || height <= 0 || nb_slots <= 0) {
+        LOG(ERROR, "invalid frame ring dimensions %dx%d with %d slots", width, height, nb_slots);
+        return -1;
+    }
+
+    struct ngl_framering_header h = {
+        .magic    = NGL_FRAMERING_MAGIC,
+        .version  = NGL_FRAMERING_VERSION,
+        .format   = format,
+        .width    = width,
+        .height   = height,
+        .nb_slots = nb_slots,
+    };
+    if (fill_layout(&h, width, height, format) < 0)
+        return -1;
+
+    const uint64_t page_size = sysconf(_SC_PAGESIZE);
+    const uint64_t header_size = sizeof(h) + nb_slots * sizeof(struct ngl_framering_slot);
+    h.data_offset = (header_size + page_size - 1) / page_size * page_size;
+    h.slot_size = (h.frame_size + page_size - 1) / page_size * page_size;
+    const uint64_t size = h.data_offset + nb_slots * h.slot_size;
+
+    const int fd = syscall(SYS_memfd_create, "nodegl-framering", 0);
+    if (fd < 0) {
+        LOG(ERROR, "unable to create frame ring: %s", strerror(errno));
+        return -1;
+    }
+
+    if (ftruncate(fd, size) < 0) {
+        LOG(ERROR, "unable to allocate %llu bytes for the frame ring: %s",
+            (unsigned long long)size, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, sizeof(h), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        LOG(ERROR, "unable to map frame ring: %s", strerror(errno));
+        close(fd);
+        return -1;
+    }
+    memcpy(map, &h, sizeof(h));
+    munmap(map, sizeof(h));
+
+    return fd;
+}
+
+struct framering *ngli_framering_open(int fd, int width, int height, int format)
+{
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < sizeof(struct ngl_framering_header)) {
+        LOG(ERROR, "FD=%d is not a frame ring", fd);
+        return NULL;
+    }
+
+    struct framering *s = calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->map_size = st.st_size;
+    void *map = mmap(NULL, s->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        LOG(ERROR, "unable to map frame ring FD=%d: %s", fd, strerror(errno));
+        free(s);
+        return NULL;
+    }
+    s->header = map;
+
+    struct ngl_framering_header *h = s->header;
+    if (h->magic != NGL_FRAMERING_MAGIC || h->version != NGL_FRAMERING_VERSION ||
+        h->data_offset + h->nb_slots * h->slot_size > s->map_size) {
+        LOG(ERROR, "FD=%d is not a frame ring", fd);
+        goto fail;
+    }
+
+    if (h->width != width || h->height != height || h->format != format) {
+        LOG(ERROR, "frame ring holds %dx%d frames of format %d instead of %dx%d of format %d",
+            h->width, h->height, h->format, width, height, format);
+        goto fail;
+    }
+
+    s->slots = (struct ngl_framering_slot *)(h + 1);
+    s->data = (uint8_t *)map + h->data_offset;
+    s->nb_written = __atomic_load_n(&h->nb_written, __ATOMIC_ACQUIRE);
+    h->producer_pid = getpid();
+    __atomic_store_n(&h->eos, 0, __ATOMIC_RELEASE);
+
+    return s;
+
+fail:
+    ngli_framering_freep(&s);
+    return NULL;
+}
+
+static int consumer_exited(const struct ngl_framering_header *h)
+{
+    const pid_t pid = __atomic_load_n(&h->consumer_pid, __ATOMIC_RELAXED);
+    return pid > 0 && kill(pid, 0) < 0 && errno == ESRCH;
+}
+
+uint8_t *ngli_framering_get_buffer(struct framering *s)
+{
+    struct ngl_framering_header *h = s->header;
+    const struct timespec timeout = {.tv_nsec = CONSUMER_CHECK_DELAY_NS};
+
+    while (!s->dropping) {
+        const uint32_t nb_read = __atomic_load_n(&h->nb_read, __ATOMIC_ACQUIRE);
+        if ((uint32_t)s->nb_written - nb_read < h->nb_slots)
+            break;
+        if (futex_wait(&h->nb_read, nb_read, &timeout) < 0 &&
+            errno == ETIMEDOUT && consumer_exited(h)) {
+            LOG(ERROR, "frame ring consumer exited, dropping frames");
+            s->dropping = 1;
+        }
+    }
+
+    return s->data + (s->nb_written % h->nb_slots) * h->slot_size;
+}
+
+void ngli_framering_queue(struct framering *s, double t)
+{
+    struct ngl_framering_header *h = s->header;
+
+    if (s->dropping)
+        return;
+
+    struct ngl_framering_slot *slot = &s->slots[s->nb_written % h->nb_slots];
+    slot->frame_index = s->nb_written;
+    slot->time = t;
+
+    s->nb_written++;
+    __atomic_store_n(&h->nb_written, (uint32_t)s->nb_written, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&h->seq, 1, __ATOMIC_RELEASE);
+    futex_wake(&h->seq);
+}
+
+void ngli_framering_freep(struct framering **sp)
+{
+    struct framering *s = *sp;
+
+    if (!s)
+        return;
+
+    if (s->slots) {
+        struct ngl_framering_header *h = s->header;
+        __atomic_store_n(&h->eos, 1, __ATOMIC_RELEASE);
+        __atomic_add_fetch(&h->seq, 1, __ATOMIC_RELEASE);
+        futex_wake(&h->seq);
+    }
+
+    munmap(s->header, s->map_size);
+    free(s);
+    *sp = NULL;
+}
+
+#else
+
+int ngl_framering_create(int width, int height, int format, int nb_slots)
+{
+    LOG(ERROR, "frame rings are not supported on this platform");
+    return -1;
+}
+
+struct framering *ngli_framering_open(int fd, int width, int height, int format)
+{
+    LOG(ERROR, "frame rings are not supported on this platform");
+    return NULL;
+}
+
+uint8_t *ngli_framering_get_buffer(struct framering *s)
+{
+    return NULL;
+}
+
+void ngli_framering_queue(struct framering *s, double t)
+{
+}
+
+void ngli_framering_freep(struct framering **sp)
+{
+}
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FRAMERING_H
+#define FRAMERING_H
+
+#include <stdint.h>
+
+struct framering;
+
+/*
+ * Map a frame ring created with ngl_framering_create() as its producer. The
+ * ring must hold frames of the specified dimensions and format
+ * (NGL_PIXFMT_*). The file descriptor is not owned by the returned object.
+ */
+struct framering *ngli_framering_open(int fd, int width, int height, int format);
+
+/*
+ * Get the next slot to fill, waiting for the consumer to release it. The
+ * frames are dropped once the consumer is known to have exited.
+ */
+uint8_t *ngli_framering_get_buffer(struct framering *s);
+
+/* Publish the slot returned by the last ngli_framering_get_buffer() call */
+void ngli_framering_queue(struct framering *s, double t);
+
+/* Signal the end of the stream to the consumer and unmap the ring */
+void ngli_framering_freep(struct framering **sp);
+
+#endif
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "framewriter.h"
+#include "log.h"
+
+struct framewriter {
+    int fd;
+    size_t frame_size;
+    int nb_frames;
+    uint8_t *buffers;
+
+    pthread_t tid;
+    int started;
+
+    pthread_mutex_t lock;
+    pthread_cond_t queue_cond;
+    pthread_cond_t free_cond;
+    int read_index;
+    int write_index;
+    int nb_queued;
+    int stop;
+};
+
+static int write_frame(int fd, const uint8_t *buf, size_t size)
+{
+    while (size) {
+        const ssize_t n = write(fd, buf, size);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        buf  += n;
+        size -= n;
+    }
+    return 0;
+}
+
+static void *writer_thread(void *arg)
+{
+    struct framewriter *s = arg;
+    int error = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&s->lock);
+        while (!s->stop && !s->nb_queued)
+            pthread_cond_wait(&s->queue_cond, &s->lock);
+        if (!s->nb_queued) {
+            pthread_mutex_unlock(&s->lock);
+            break;
+        }
+        const uint8_t *buf = s->buffers + s->read_index * s->frame_size;
+        pthread_mutex_unlock(&s->lock);
+
+        /* Once the consumer is gone, the frames are dropped so the renderer
+         * does not stall */
+        if (!error && write_frame(s->fd, buf, s->frame_size) < 0) {
+            LOG(ERROR, "unable to write frame to FD=%d: %s", s->fd, strerror(errno));
+            error = 1;
+        }
+
+        pthread_mutex_lock(&s->lock);
+        s->read_index = (s->read_index + 1) % s->nb_frames;
+        s->nb_queued--;
+        pthread_cond_signal(&s->free_cond);
+        pthread_mutex_unlock(&s->lock);
+    }
+
+    return NULL;
+}
+
+struct framewriter *ngli_framewriter_create(int fd, size_t frame_size, int nb_frames)
+{
+    struct framewriter *s = calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->fd = fd;
+    s->frame_size = frame_size;
+    s->nb_frames = nb_frames;
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->queue_cond, NULL);
+    pthread_cond_init(&s->free_cond, NULL);
+
+    s->buffers = malloc(nb_frames * frame_size);
+    if (!s->buffers)
+        goto fail;
+
+    if (pthread_create(&s->tid, NULL, writer_thread, s)) {
+        LOG(ERROR, "unable to create frame writer thread");
+        goto fail;
+    }
+    s->started = 1;
+
+    return s;
+
+fail:
+    ngli_framewriter_freep(&s);
+    return NULL;
+}
+
+uint8_t *ngli_framewriter_get_buffer(struct framewriter *s)
+{
+    pthread_mutex_lock(&s->lock);
+    while (s->nb_queued == s->nb_frames)
+        pthread_cond_wait(&s->free_cond, &s->lock);
+    uint8_t *buf = s->buffers + s->write_index * s->frame_size;
+    pthread_mutex_unlock(&s->lock);
+    return buf;
+}
+
+void ngli_framewriter_queue(struct framewriter *s)
+{
+    pthread_mutex_lock(&s->lock);
+    s->write_index = (s->write_index + 1) % s->nb_frames;
+    s->nb_queued++;
+    pthread_cond_signal(&s->queue_cond);
+    pthread_mutex_unlock(&s->lock);
+}
+
+void ngli_framewriter_freep(struct framewriter **sp)
+{
+    struct framewriter *s = *sp;
+
+    if (!s)
+        return;
+
+    if (s->started) {
+        pthread_mutex_lock(&s->lock);
+        s->stop = 1;
+        pthread_cond_signal(&s->queue_cond);
+        pthread_mutex_unlock(&s->lock);
+        pthread_join(s->tid, NULL);
+    }
+
+    pthread_cond_destroy(&s->free_cond);
+    pthread_cond_destroy(&s->queue_cond);
+    pthread_mutex_destroy(&s->lock);
+    free(s->buffers);
+    free(s);
+    *sp = NULL;
+}
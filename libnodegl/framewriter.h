@@ -0,0 +1,47 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FRAMEWRITER_H
+#define FRAMEWRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct framewriter;
+
+/*
+ * Create a thread writing frames of a fixed size to a file descriptor. The
+ * frames go through a bounded queue of nb_frames buffers, so the caller only
+ * blocks when the consumer of the file descriptor falls behind by that many
+ * frames.
+ */
+struct framewriter *ngli_framewriter_create(int fd, size_t frame_size, int nb_frames);
+
+/* Get the next buffer to fill, waiting for one to be available */
+uint8_t *ngli_framewriter_get_buffer(struct framewriter *s);
+
+/* Queue the buffer returned by the last ngli_framewriter_get_buffer() call */
+void ngli_framewriter_queue(struct framewriter *s);
+
+/* Write the queued frames and destroy the writer */
+void ngli_framewriter_freep(struct framewriter **sp);
+
+#endif
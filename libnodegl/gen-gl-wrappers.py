@@ -28,6 +28,30 @@ cmds_optional = [
     # Framebuffer
     'glBlitFramebuffer',
 
+    # Buffer mapping
+    'glMapBufferRange',
+    'glUnmapBuffer',
+
+    # Program binary
+    'glGetProgramBinary',
+    'glProgramBinary',
+    'glProgramParameteri',
+
+    # Parallel shader compile
+    'glMaxShaderCompilerThreadsKHR',
+
+    # Sync
+    'glDeleteSync',
+    'glFenceSync',
+    'glWaitSync',
+
+    # Timer queries
+    'glDeleteQueries',
+    'glGenQueries',
+    'glGetQueryObjectui64v',
+    'glGetQueryObjectuiv',
+    'glQueryCounter',
+
     # Vertex Arrays
     'glBindVertexArray',
     'glDeleteVertexArrays',
@@ -66,8 +90,13 @@ cmds = [
     'glBlendFuncSeparate',
 
     # Draw
+    'glDrawArrays',
     'glDrawElements',
 
+    # Synchronization
+    'glFinish',
+    'glFlush',
+
     # Texture
     'glActiveTexture',
     'glBindTexture',
@@ -90,6 +119,7 @@ cmds = [
     # Buffer
     'glBindBuffer',
     'glBufferData',
+    'glBufferSubData',
     'glDeleteBuffers',
     'glGenBuffers',
 
@@ -231,6 +261,23 @@ static const struct gldefinition {
     size_t offset;
     int flags;
 } gldefinitions[] = {
+'''
+
+    glnull_ids = do_not_edit + '''
+/*
+ * Stubs of the GL functions for the null GL context (glcontext_null.c). They
+ * only record the call through record_call(), and return 0 when a value is
+ * expected.
+ */
+
+enum {
+'''
+    glnull_stubs = ''
+    glnull_functions = '''
+static const struct glnull_function {
+    const char *name;
+    void *func;
+} glnull_functions[] = {
 '''
 
     xml = ET.parse(gl_xml)
@@ -282,6 +329,15 @@ static inline %(func_ret)s ngli_%(func_name)s(%(wrapper_args_specs)s)
 %(ret_call)s}
 ''' % data
 
+        glnull_ids       += '    GLNULL_%(func_name_nogl)s,\n' % data
+        glnull_functions += '    [GLNULL_%(func_name_nogl)s] = {"%(func_name)s", null_%(func_name_nogl)s},\n' % data
+        glnull_stubs     += '''
+static NGLI_GL_APIENTRY %(func_ret)s null_%(func_name_nogl)s(%(func_args_specs)s)
+{
+    record_call(GLNULL_%(func_name_nogl)s);
+%(null_ret)s}
+''' % dict(data, null_ret='' if funcret == 'void' else '    return 0;\n')
+
         cmds.pop(cmds.index(funcname))
         if not cmds:
             break
@@ -292,10 +348,13 @@ static inline %(func_ret)s ngli_%(func_name)s(%(wrapper_args_specs)s)
     glwrappers    += '\n#endif\n'
     glfunctions   += '};\n\n#endif\n'
     gldefinitions += '};\n'
+    glnull_ids    += '    GLNULL_NB_FUNCTIONS\n};\n\nstatic void record_call(int id);\n'
+    glnull_functions += '};\n'
 
     open('glfunctions.h', 'w').write(glfunctions)
     open('gldefinitions_data.h', 'w').write(gldefinitions)
     open('glwrappers.h', 'w').write(glwrappers)
+    open('glnull_data.h', 'w').write(glnull_ids + glnull_stubs + glnull_functions)
 
 
 if __name__ == '__main__':
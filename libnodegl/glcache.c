@@ -0,0 +1,461 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "glcache.h"
+#include "glcontext.h"
+#include "nodegl.h"
+#include "utils.h"
+
+enum {
+    GLCACHE_VALID_BLEND          = 1 << 0,
+    GLCACHE_VALID_STENCIL        = 1 << 1,
+    GLCACHE_VALID_COLOR_MASK     = 1 << 2,
+    GLCACHE_VALID_VIEWPORT       = 1 << 3,
+    GLCACHE_VALID_FRAMEBUFFERS   = 1 << 4,
+    GLCACHE_VALID_PROGRAM        = 1 << 5,
+    GLCACHE_VALID_VERTEX_ARRAY   = 1 << 6,
+    GLCACHE_VALID_ACTIVE_TEXTURE = 1 << 7,
+};
+
+/* Capabilities tracked by the cache, any other one is forwarded to GL */
+static const GLenum caps[] = {
+    GL_BLEND,
+    GL_CULL_FACE,
+    GL_DEPTH_TEST,
+    GL_DITHER,
+    GL_POLYGON_OFFSET_FILL,
+    GL_SAMPLE_ALPHA_TO_COVERAGE,
+    GL_SAMPLE_COVERAGE,
+    GL_SCISSOR_TEST,
+    GL_STENCIL_TEST,
+#ifdef GL_MULTISAMPLE
+    GL_MULTISAMPLE,
+#endif
+};
+
+static int get_cap_index(GLenum cap)
+{
+    for (int i = 0; i < NGLI_ARRAY_NB(caps); i++)
+        if (caps[i] == cap)
+            return i;
+    return -1;
+}
+
+void ngli_glcache_invalidate(struct glcontext *glcontext)
+{
+    struct glcache *cache = &glcontext->cache;
+    memset(cache, 0, sizeof(*cache));
+}
+
+int ngli_glcache_is_enabled(struct glcontext *glcontext, GLenum cap)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    GLint enabled = 0;
+    const int i = get_cap_index(cap);
+    if (i < 0) {
+        ngli_glGetIntegerv(gl, cap, &enabled);
+        return enabled;
+    }
+
+    const uint32_t mask = 1U << i;
+    if (!(cache->caps_valid & mask)) {
+        ngli_glGetIntegerv(gl, cap, &enabled);
+        cache->caps_valid |= mask;
+        if (enabled)
+            cache->caps_enabled |= mask;
+        else
+            cache->caps_enabled &= ~mask;
+    }
+    return !!(cache->caps_enabled & mask);
+}
+
+void ngli_glcache_set_enabled(struct glcontext *glcontext, GLenum cap, int enabled)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    const int i = get_cap_index(cap);
+    if (i >= 0) {
+        const uint32_t mask = 1U << i;
+        if ((cache->caps_valid & mask) && !!(cache->caps_enabled & mask) == !!enabled)
+            return;
+        cache->caps_valid |= mask;
+        if (enabled)
+            cache->caps_enabled |= mask;
+        else
+            cache->caps_enabled &= ~mask;
+    }
+
+    if (enabled)
+        ngli_glEnable(gl, cap);
+    else
+        ngli_glDisable(gl, cap);
+    glcontext->nb_state_changes++;
+}
+
+const struct glcache_blend *ngli_glcache_get_blend(struct glcontext *glcontext)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if (!(cache->valid & GLCACHE_VALID_BLEND)) {
+        struct glcache_blend *b = &cache->blend;
+        ngli_glGetIntegerv(gl, GL_BLEND_SRC_RGB,        (GLint *)&b->src_rgb);
+        ngli_glGetIntegerv(gl, GL_BLEND_DST_RGB,        (GLint *)&b->dst_rgb);
+        ngli_glGetIntegerv(gl, GL_BLEND_SRC_ALPHA,      (GLint *)&b->src_alpha);
+        ngli_glGetIntegerv(gl, GL_BLEND_DST_ALPHA,      (GLint *)&b->dst_alpha);
+        ngli_glGetIntegerv(gl, GL_BLEND_EQUATION_RGB,   (GLint *)&b->mode_rgb);
+        ngli_glGetIntegerv(gl, GL_BLEND_EQUATION_ALPHA, (GLint *)&b->mode_alpha);
+        cache->valid |= GLCACHE_VALID_BLEND;
+    }
+    return &cache->blend;
+}
+
+void ngli_glcache_set_blend(struct glcontext *glcontext, const struct glcache_blend *blend)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+    struct glcache_blend *b = &cache->blend;
+    const int valid = cache->valid & GLCACHE_VALID_BLEND;
+
+    if (!valid || b->src_rgb   != blend->src_rgb   || b->dst_rgb   != blend->dst_rgb ||
+                  b->src_alpha != blend->src_alpha || b->dst_alpha != blend->dst_alpha) {
+        ngli_glBlendFuncSeparate(gl, blend->src_rgb, blend->dst_rgb,
+                                 blend->src_alpha, blend->dst_alpha);
+        glcontext->nb_state_changes++;
+    }
+
+    if (!valid || b->mode_rgb != blend->mode_rgb || b->mode_alpha != blend->mode_alpha) {
+        ngli_glBlendEquationSeparate(gl, blend->mode_rgb, blend->mode_alpha);
+        glcontext->nb_state_changes++;
+    }
+
+    *b = *blend;
+    cache->valid |= GLCACHE_VALID_BLEND;
+}
+
+const struct glcache_stencil *ngli_glcache_get_stencil(struct glcontext *glcontext)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if (!(cache->valid & GLCACHE_VALID_STENCIL)) {
+        struct glcache_stencil *s = &cache->stencil;
+        ngli_glGetIntegerv(gl, GL_STENCIL_WRITEMASK,          (GLint *)&s->writemask);
+        ngli_glGetIntegerv(gl, GL_STENCIL_FUNC,               (GLint *)&s->func);
+        ngli_glGetIntegerv(gl, GL_STENCIL_REF,                (GLint *)&s->func_ref);
+        ngli_glGetIntegerv(gl, GL_STENCIL_VALUE_MASK,         (GLint *)&s->func_mask);
+        ngli_glGetIntegerv(gl, GL_STENCIL_FAIL,               (GLint *)&s->op_sfail);
+        ngli_glGetIntegerv(gl, GL_STENCIL_PASS_DEPTH_FAIL,    (GLint *)&s->op_dpfail);
+        ngli_glGetIntegerv(gl, GL_STENCIL_PASS_DEPTH_PASS,    (GLint *)&s->op_dppass);
+        cache->valid |= GLCACHE_VALID_STENCIL;
+    }
+    return &cache->stencil;
+}
+
+void ngli_glcache_set_stencil(struct glcontext *glcontext, const struct glcache_stencil *stencil)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+    struct glcache_stencil *s = &cache->stencil;
+    const int valid = cache->valid & GLCACHE_VALID_STENCIL;
+
+    if (!valid || s->writemask != stencil->writemask) {
+        ngli_glStencilMask(gl, stencil->writemask);
+        glcontext->nb_state_changes++;
+    }
+
+    if (!valid || s->func      != stencil->func ||
+                  s->func_ref  != stencil->func_ref ||
+                  s->func_mask != stencil->func_mask) {
+        ngli_glStencilFunc(gl, stencil->func, stencil->func_ref, stencil->func_mask);
+        glcontext->nb_state_changes++;
+    }
+
+    if (!valid || s->op_sfail  != stencil->op_sfail ||
+                  s->op_dpfail != stencil->op_dpfail ||
+                  s->op_dppass != stencil->op_dppass) {
+        ngli_glStencilOp(gl, stencil->op_sfail, stencil->op_dpfail, stencil->op_dppass);
+        glcontext->nb_state_changes++;
+    }
+
+    *s = *stencil;
+    cache->valid |= GLCACHE_VALID_STENCIL;
+}
+
+const GLboolean *ngli_glcache_get_color_mask(struct glcontext *glcontext)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if (!(cache->valid & GLCACHE_VALID_COLOR_MASK)) {
+        ngli_glGetBooleanv(gl, GL_COLOR_WRITEMASK, cache->color_mask);
+        cache->valid |= GLCACHE_VALID_COLOR_MASK;
+    }
+    return cache->color_mask;
+}
+
+void ngli_glcache_set_color_mask(struct glcontext *glcontext, const GLboolean *rgba)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if ((cache->valid & GLCACHE_VALID_COLOR_MASK) &&
+        !memcmp(cache->color_mask, rgba, sizeof(cache->color_mask)))
+        return;
+
+    ngli_glColorMask(gl, rgba[0], rgba[1], rgba[2], rgba[3]);
+    glcontext->nb_state_changes++;
+    memcpy(cache->color_mask, rgba, sizeof(cache->color_mask));
+    cache->valid |= GLCACHE_VALID_COLOR_MASK;
+}
+
+const GLint *ngli_glcache_get_viewport(struct glcontext *glcontext)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if (!(cache->valid & GLCACHE_VALID_VIEWPORT)) {
+        ngli_glGetIntegerv(gl, GL_VIEWPORT, cache->viewport);
+        cache->valid |= GLCACHE_VALID_VIEWPORT;
+    }
+    return cache->viewport;
+}
+
+void ngli_glcache_set_viewport(struct glcontext *glcontext, const GLint *viewport)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if ((cache->valid & GLCACHE_VALID_VIEWPORT) &&
+        !memcmp(cache->viewport, viewport, sizeof(cache->viewport)))
+        return;
+
+    ngli_glViewport(gl, viewport[0], viewport[1], viewport[2], viewport[3]);
+    glcontext->nb_state_changes++;
+    memcpy(cache->viewport, viewport, sizeof(cache->viewport));
+    cache->valid |= GLCACHE_VALID_VIEWPORT;
+}
+
+static void load_framebuffers(struct glcontext *glcontext)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if (cache->valid & GLCACHE_VALID_FRAMEBUFFERS)
+        return;
+
+#if defined(GL_READ_FRAMEBUFFER_BINDING) && defined(GL_DRAW_FRAMEBUFFER_BINDING)
+    if (glcontext->api == NGL_GLAPI_OPENGL3) {
+        ngli_glGetIntegerv(gl, GL_DRAW_FRAMEBUFFER_BINDING, (GLint *)&cache->draw_framebuffer);
+        ngli_glGetIntegerv(gl, GL_READ_FRAMEBUFFER_BINDING, (GLint *)&cache->read_framebuffer);
+    } else
+#endif
+    {
+        ngli_glGetIntegerv(gl, GL_FRAMEBUFFER_BINDING, (GLint *)&cache->draw_framebuffer);
+        cache->read_framebuffer = cache->draw_framebuffer;
+    }
+    cache->valid |= GLCACHE_VALID_FRAMEBUFFERS;
+}
+
+GLuint ngli_glcache_get_framebuffer(struct glcontext *glcontext, GLenum target)
+{
+    struct glcache *cache = &glcontext->cache;
+
+    load_framebuffers(glcontext);
+#ifdef GL_READ_FRAMEBUFFER
+    if (target == GL_READ_FRAMEBUFFER)
+        return cache->read_framebuffer;
+#endif
+    return cache->draw_framebuffer;
+}
+
+void ngli_glcache_bind_framebuffer(struct glcontext *glcontext, GLenum target, GLuint framebuffer)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    load_framebuffers(glcontext);
+
+    int draw = 1, read = 1;
+#if defined(GL_READ_FRAMEBUFFER) && defined(GL_DRAW_FRAMEBUFFER)
+    if (target == GL_READ_FRAMEBUFFER)
+        draw = 0;
+    else if (target == GL_DRAW_FRAMEBUFFER)
+        read = 0;
+#endif
+
+    if ((!draw || cache->draw_framebuffer == framebuffer) &&
+        (!read || cache->read_framebuffer == framebuffer))
+        return;
+
+    ngli_glBindFramebuffer(gl, target, framebuffer);
+    glcontext->nb_state_changes++;
+    if (draw)
+        cache->draw_framebuffer = framebuffer;
+    if (read)
+        cache->read_framebuffer = framebuffer;
+}
+
+void ngli_glcache_use_program(struct glcontext *glcontext, GLuint program)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if ((cache->valid & GLCACHE_VALID_PROGRAM) && cache->program == program)
+        return;
+
+    ngli_glUseProgram(gl, program);
+    glcontext->nb_state_changes++;
+    cache->program = program;
+    cache->valid |= GLCACHE_VALID_PROGRAM;
+}
+
+void ngli_glcache_bind_vertex_array(struct glcontext *glcontext, GLuint vertex_array)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if ((cache->valid & GLCACHE_VALID_VERTEX_ARRAY) && cache->vertex_array == vertex_array)
+        return;
+
+    ngli_glBindVertexArray(gl, vertex_array);
+    glcontext->nb_state_changes++;
+    cache->vertex_array = vertex_array;
+    cache->valid |= GLCACHE_VALID_VERTEX_ARRAY;
+}
+
+void ngli_glcache_active_texture(struct glcontext *glcontext, GLenum texture)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if ((cache->valid & GLCACHE_VALID_ACTIVE_TEXTURE) && cache->active_texture == texture)
+        return;
+
+    ngli_glActiveTexture(gl, texture);
+    glcontext->nb_state_changes++;
+    cache->active_texture = texture;
+    cache->valid |= GLCACHE_VALID_ACTIVE_TEXTURE;
+}
+
+static int get_active_unit(struct glcontext *glcontext)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if (!(cache->valid & GLCACHE_VALID_ACTIVE_TEXTURE)) {
+        ngli_glGetIntegerv(gl, GL_ACTIVE_TEXTURE, (GLint *)&cache->active_texture);
+        cache->valid |= GLCACHE_VALID_ACTIVE_TEXTURE;
+    }
+
+    const int unit = cache->active_texture - GL_TEXTURE0;
+    return unit >= 0 && unit < NGLI_GLCACHE_MAX_TEXTURE_UNITS ? unit : -1;
+}
+
+void ngli_glcache_bind_texture(struct glcontext *glcontext, GLenum target, GLuint texture)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    /*
+     * Only the 2D target is tracked: external textures can be rebound
+     * behind our back by the platform media APIs.
+     */
+    const int unit = target == GL_TEXTURE_2D ? get_active_unit(glcontext) : -1;
+    if (unit < 0) {
+        ngli_glBindTexture(gl, target, texture);
+        glcontext->nb_state_changes++;
+        return;
+    }
+
+    const uint32_t mask = 1U << unit;
+    if ((cache->textures_valid & mask) && cache->textures[unit] == texture)
+        return;
+
+    ngli_glBindTexture(gl, target, texture);
+    glcontext->nb_state_changes++;
+    cache->textures[unit] = texture;
+    cache->textures_valid |= mask;
+}
+
+void ngli_glcache_delete_framebuffers(struct glcontext *glcontext, GLsizei n, const GLuint *framebuffers)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    ngli_glDeleteFramebuffers(gl, n, framebuffers);
+
+    if (!(cache->valid & GLCACHE_VALID_FRAMEBUFFERS))
+        return;
+    for (int i = 0; i < n; i++) {
+        if (cache->draw_framebuffer == framebuffers[i])
+            cache->draw_framebuffer = 0;
+        if (cache->read_framebuffer == framebuffers[i])
+            cache->read_framebuffer = 0;
+    }
+}
+
+void ngli_glcache_delete_program(struct glcontext *glcontext, GLuint program)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    ngli_glDeleteProgram(gl, program);
+
+    /* A program in use is only flagged for deletion, so forget about it */
+    if (cache->program == program)
+        cache->valid &= ~GLCACHE_VALID_PROGRAM;
+}
+
+void ngli_glcache_delete_vertex_arrays(struct glcontext *glcontext, GLsizei n, const GLuint *vertex_arrays)
+{
+    struct glcache *cache = &glcontext->cache;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    ngli_glDeleteVertexArrays(gl, n, vertex_arrays);
+
+    for (int i = 0; i < n; i++)
+        if (cache->vertex_array == vertex_arrays[i])
+            cache->vertex_array = 0;
+}
+
+void ngli_glcache_forget_textures(struct glcontext *glcontext, GLsizei n, const GLuint *textures)
+{
+    struct glcache *cache = &glcontext->cache;
+
+    for (int unit = 0; unit < NGLI_GLCACHE_MAX_TEXTURE_UNITS; unit++)
+        for (int i = 0; i < n; i++)
+            if (cache->textures[unit] == textures[i])
+                cache->textures[unit] = 0;
+}
+
+void ngli_glcache_delete_textures(struct glcontext *glcontext, GLsizei n, const GLuint *textures)
+{
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    ngli_glDeleteTextures(gl, n, textures);
+    ngli_glcache_forget_textures(glcontext, n, textures);
+}
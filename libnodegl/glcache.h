@@ -0,0 +1,112 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef GLCACHE_H
+#define GLCACHE_H
+
+#include <stdint.h>
+
+#include "glincludes.h"
+
+/*
+ * Shadow copy of the GL state altered by the nodes. Every value is fetched
+ * from GL at most once between two invalidations (typically once per
+ * frame) and then answered from memory, while redundant state changes are
+ * dropped.
+ */
+
+#define NGLI_GLCACHE_MAX_TEXTURE_UNITS 32
+
+struct glcontext;
+
+struct glcache_blend {
+    GLenum src_rgb;
+    GLenum dst_rgb;
+    GLenum src_alpha;
+    GLenum dst_alpha;
+    GLenum mode_rgb;
+    GLenum mode_alpha;
+};
+
+struct glcache_stencil {
+    GLuint writemask;
+    GLenum func;
+    GLint  func_ref;
+    GLuint func_mask;
+    GLenum op_sfail;
+    GLenum op_dpfail;
+    GLenum op_dppass;
+};
+
+struct glcache {
+    uint32_t valid;     /* GLCACHE_VALID_* flags, see glcache.c */
+    uint32_t caps_valid;
+    uint32_t caps_enabled;
+
+    struct glcache_blend blend;
+    struct glcache_stencil stencil;
+    GLboolean color_mask[4];
+    GLint viewport[4];
+    GLuint draw_framebuffer;
+    GLuint read_framebuffer;
+    GLuint program;
+    GLuint vertex_array;
+    GLenum active_texture;
+
+    uint32_t textures_valid;
+    GLuint textures[NGLI_GLCACHE_MAX_TEXTURE_UNITS];
+};
+
+void ngli_glcache_invalidate(struct glcontext *glcontext);
+
+int ngli_glcache_is_enabled(struct glcontext *glcontext, GLenum cap);
+void ngli_glcache_set_enabled(struct glcontext *glcontext, GLenum cap, int enabled);
+
+const struct glcache_blend *ngli_glcache_get_blend(struct glcontext *glcontext);
+void ngli_glcache_set_blend(struct glcontext *glcontext, const struct glcache_blend *blend);
+
+const struct glcache_stencil *ngli_glcache_get_stencil(struct glcontext *glcontext);
+void ngli_glcache_set_stencil(struct glcontext *glcontext, const struct glcache_stencil *stencil);
+
+const GLboolean *ngli_glcache_get_color_mask(struct glcontext *glcontext);
+void ngli_glcache_set_color_mask(struct glcontext *glcontext, const GLboolean *rgba);
+
+const GLint *ngli_glcache_get_viewport(struct glcontext *glcontext);
+void ngli_glcache_set_viewport(struct glcontext *glcontext, const GLint *viewport);
+
+GLuint ngli_glcache_get_framebuffer(struct glcontext *glcontext, GLenum target);
+void ngli_glcache_bind_framebuffer(struct glcontext *glcontext, GLenum target, GLuint framebuffer);
+
+void ngli_glcache_use_program(struct glcontext *glcontext, GLuint program);
+void ngli_glcache_bind_vertex_array(struct glcontext *glcontext, GLuint vertex_array);
+void ngli_glcache_active_texture(struct glcontext *glcontext, GLenum texture);
+void ngli_glcache_bind_texture(struct glcontext *glcontext, GLenum target, GLuint texture);
+
+/* Deleting a bound object implicitly resets its binding point */
+void ngli_glcache_delete_framebuffers(struct glcontext *glcontext, GLsizei n, const GLuint *framebuffers);
+void ngli_glcache_delete_program(struct glcontext *glcontext, GLuint program);
+void ngli_glcache_delete_vertex_arrays(struct glcontext *glcontext, GLsizei n, const GLuint *vertex_arrays);
+void ngli_glcache_delete_textures(struct glcontext *glcontext, GLsizei n, const GLuint *textures);
+
+/* Must be called when textures are deleted by a third party (such as CoreVideo) */
+void ngli_glcache_forget_textures(struct glcontext *glcontext, GLsizei n, const GLuint *textures);
+
+#endif /* GLCACHE_H */
@@ -31,6 +31,8 @@
 
 #include "gldefinitions_data.h"
 
+extern const struct glcontext_class ngli_glcontext_null_class;
+
 #ifdef HAVE_PLATFORM_GLX
 extern const struct glcontext_class ngli_glcontext_x11_class;
 #endif
@@ -67,14 +69,18 @@ static const struct glcontext_class *glcontext_class_map[] = {
 #ifdef HAVE_PLATFORM_WGL
     [NGL_GLPLATFORM_WGL] = &ngli_glcontext_wgl_class,
 #endif
+    [NGL_GLPLATFORM_NULL] = &ngli_glcontext_null_class,
 };
 
-static struct glcontext *glcontext_new(void *display, void *window, void *handle, int platform, int api)
+static struct glcontext *glcontext_alloc(int platform, int api)
 {
     struct glcontext *glcontext = NULL;
 
-    if (platform < 0 || platform >= NGLI_ARRAY_NB(glcontext_class_map))
+    if (platform < 0 || platform >= NGLI_ARRAY_NB(glcontext_class_map) ||
+        !glcontext_class_map[platform]) {
+        LOG(ERROR, "GL platform %d is not supported", platform);
         return NULL;
+    }
 
     glcontext = calloc(1, sizeof(*glcontext));
     if (!glcontext)
@@ -84,23 +90,42 @@ static struct glcontext *glcontext_new(void *display, void *window, void *handle
     if (glcontext->class->priv_size) {
         glcontext->priv_data = calloc(1, glcontext->class->priv_size);
         if (!glcontext->priv_data) {
-            goto fail;
+            ngli_glcontext_freep(&glcontext);
+            return NULL;
         }
     }
 
     glcontext->platform = platform;
     glcontext->api = api;
 
+    return glcontext;
+}
+
+static struct glcontext *glcontext_new(void *display, void *window, void *handle, int platform, int api)
+{
+    struct glcontext *glcontext = glcontext_alloc(platform, api);
+    if (!glcontext)
+        return NULL;
+
     if (glcontext->class->init) {
         int ret = glcontext->class->init(glcontext, display, window, handle);
         if (ret < 0)
-            goto fail;
+            ngli_glcontext_freep(&glcontext);
     }
 
     return glcontext;
-fail:
-    ngli_glcontext_freep(&glcontext);
-    return NULL;
+}
+
+static int get_default_api(int api)
+{
+    if (api == NGL_GLAPI_AUTO) {
+#if defined(TARGET_IPHONE) || defined(TARGET_ANDROID)
+        api = NGL_GLAPI_OPENGLES2;
+#else
+        api = NGL_GLAPI_OPENGL3;
+#endif
+    }
+    return api;
 }
 
 struct glcontext *ngli_glcontext_new_wrapped(void *display, void *window, void *handle, int platform, int api)
@@ -124,13 +149,7 @@ struct glcontext *ngli_glcontext_new_wrapped(void *display, void *window, void *
 #endif
     }
 
-    if (api == NGL_GLAPI_AUTO) {
-#if defined(TARGET_IPHONE) || defined(TARGET_ANDROID)
-        api = NGL_GLAPI_OPENGLES2;
-#else
-        api = NGL_GLAPI_OPENGL3;
-#endif
-    }
+    api = get_default_api(api);
 
     glcontext = glcontext_new(display, window, handle, platform, api);
     if (!glcontext)
@@ -153,6 +172,8 @@ struct glcontext *ngli_glcontext_new_shared(struct glcontext *other)
     void *handle  = other->class->get_handle(other);
 
     glcontext = glcontext_new(display, window, handle, other->platform, other->api);
+    if (!glcontext)
+        return NULL;
 
     if (glcontext->class->create) {
         int ret = glcontext->class->create(glcontext, other);
@@ -163,6 +184,86 @@ struct glcontext *ngli_glcontext_new_shared(struct glcontext *other)
     return glcontext;
 }
 
+static int create_offscreen_framebuffer(struct glcontext *glcontext)
+{
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    ngli_glGenTextures(gl, 1, &glcontext->color_texture_id);
+    ngli_glBindTexture(gl, GL_TEXTURE_2D, glcontext->color_texture_id);
+    ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    ngli_glTexImage2D(gl, GL_TEXTURE_2D, 0, GL_RGBA, glcontext->width, glcontext->height,
+                      0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+
+    ngli_glGenRenderbuffers(gl, 1, &glcontext->depth_renderbuffer_id);
+    ngli_glBindRenderbuffer(gl, GL_RENDERBUFFER, glcontext->depth_renderbuffer_id);
+    ngli_glRenderbufferStorage(gl, GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, glcontext->width, glcontext->height);
+    ngli_glBindRenderbuffer(gl, GL_RENDERBUFFER, 0);
+
+    ngli_glGenFramebuffers(gl, 1, &glcontext->framebuffer_id);
+    ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, glcontext->framebuffer_id);
+    ngli_glFramebufferTexture2D(gl, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, glcontext->color_texture_id, 0);
+    ngli_glFramebufferRenderbuffer(gl, GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, glcontext->depth_renderbuffer_id);
+
+    if (ngli_glCheckFramebufferStatus(gl, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        LOG(ERROR, "offscreen framebuffer is not complete");
+        return -1;
+    }
+
+    /*
+     * The framebuffer is left bound: it acts as the default framebuffer since
+     * the GL cache picks up the current binding and viewport at each frame.
+     */
+    ngli_glViewport(gl, 0, 0, glcontext->width, glcontext->height);
+
+    return 0;
+}
+
+struct glcontext *ngli_glcontext_new_offscreen(int width, int height, int platform, int api)
+{
+    if (width <= 0 || height <= 0) {
+        LOG(ERROR, "invalid offscreen size %dx%d", width, height);
+        return NULL;
+    }
+
+    if (platform == NGL_GLPLATFORM_AUTO) {
+#if defined(HAVE_PLATFORM_EGL)
+        platform = NGL_GLPLATFORM_EGL;
+#else
+        LOG(ERROR, "offscreen rendering requires EGL");
+        return NULL;
+#endif
+    }
+
+    api = get_default_api(api);
+
+    struct glcontext *glcontext = glcontext_alloc(platform, api);
+    if (!glcontext)
+        return NULL;
+
+    if (!glcontext->class->create) {
+        LOG(ERROR, "GL platform %d can not create offscreen contexts", platform);
+        goto fail;
+    }
+
+    glcontext->offscreen = 1;
+    glcontext->width = width;
+    glcontext->height = height;
+
+    if (glcontext->class->create(glcontext, NULL) < 0 ||
+        ngli_glcontext_make_current(glcontext, 1) < 0 ||
+        ngli_glcontext_load_extensions(glcontext) < 0 ||
+        create_offscreen_framebuffer(glcontext) < 0)
+        goto fail;
+
+    return glcontext;
+
+fail:
+    ngli_glcontext_freep(&glcontext);
+    return NULL;
+}
+
 int ngli_glcontext_load_extensions(struct glcontext *glcontext)
 {
     const struct glfunctions *gl = &glcontext->funcs;
@@ -189,9 +290,24 @@ int ngli_glcontext_load_extensions(struct glcontext *glcontext)
         ngli_glGetIntegerv(gl, GL_MAJOR_VERSION, &glcontext->major_version);
         ngli_glGetIntegerv(gl, GL_MINOR_VERSION, &glcontext->minor_version);
 
+        /* Pixel buffer objects are core since 2.1 and buffer mapping since 3.0 */
+        glcontext->has_pbo_compatibility = 1;
+
         if (glcontext->major_version >= 4)
             glcontext->has_vao_compatibility = 1;
 
+        if (glcontext->major_version > 4 ||
+            (glcontext->major_version == 4 && glcontext->minor_version >= 1))
+            glcontext->has_program_binary_compatibility = 1;
+
+        if (glcontext->major_version > 3 ||
+            (glcontext->major_version == 3 && glcontext->minor_version >= 2))
+            glcontext->has_sync_compatibility = 1;
+
+        if (glcontext->major_version > 3 ||
+            (glcontext->major_version == 3 && glcontext->minor_version >= 3))
+            glcontext->has_timer_query_compatibility = 1;
+
         ngli_glGetIntegerv(gl, GL_NUM_EXTENSIONS, &nb_extensions);
         for (i = 0; i < nb_extensions; i++) {
             const char *extension = (const char *)ngli_glGetStringi(gl, GL_EXTENSIONS, i);
@@ -201,6 +317,14 @@ int ngli_glcontext_load_extensions(struct glcontext *glcontext)
                 glcontext->has_es2_compatibility = 1;
             } else if (!strcmp(extension, "GL_ARB_vertex_array_object")) {
                 glcontext->has_vao_compatibility = 1;
+            } else if (!strcmp(extension, "GL_ARB_get_program_binary")) {
+                glcontext->has_program_binary_compatibility = 1;
+            } else if (!strcmp(extension, "GL_ARB_sync")) {
+                glcontext->has_sync_compatibility = 1;
+            } else if (!strcmp(extension, "GL_ARB_timer_query")) {
+                glcontext->has_timer_query_compatibility = 1;
+            } else if (!strcmp(extension, "GL_KHR_parallel_shader_compile")) {
+                glcontext->has_parallel_shader_compile = 1;
             }
         }
     } else if (glcontext->api == NGL_GLAPI_OPENGLES2) {
@@ -209,6 +333,8 @@ int ngli_glcontext_load_extensions(struct glcontext *glcontext)
         glcontext->minor_version = 0;
         glcontext->has_es2_compatibility = 1;
         glcontext->has_vao_compatibility = ngli_glcontext_check_extension("GL_OES_vertex_array_object", gl_extensions);
+        glcontext->has_program_binary_compatibility = ngli_glcontext_check_extension("GL_OES_get_program_binary", gl_extensions);
+        glcontext->has_parallel_shader_compile = ngli_glcontext_check_extension("GL_KHR_parallel_shader_compile", gl_extensions);
     }
 
     ngli_glGetIntegerv(gl, GL_MAX_TEXTURE_IMAGE_UNITS, &glcontext->max_texture_image_units);
@@ -223,11 +349,57 @@ int ngli_glcontext_load_extensions(struct glcontext *glcontext)
 
     }
 
-    LOG(INFO, "OpenGL %d.%d ES2_compatibility=%d vertex_array_object=%d",
+    if (glcontext->has_program_binary_compatibility) {
+        GLint nb_formats = 0;
+
+        if (gl->GetProgramBinary && gl->ProgramBinary)
+            ngli_glGetIntegerv(gl, GL_NUM_PROGRAM_BINARY_FORMATS, &nb_formats);
+        glcontext->has_program_binary_compatibility = nb_formats > 0;
+    }
+
+    if (glcontext->has_sync_compatibility) {
+        glcontext->has_sync_compatibility =
+            gl->FenceSync != NULL &&
+            gl->WaitSync != NULL &&
+            gl->DeleteSync != NULL;
+    }
+
+    if (glcontext->has_timer_query_compatibility) {
+        glcontext->has_timer_query_compatibility =
+            gl->GenQueries != NULL &&
+            gl->DeleteQueries != NULL &&
+            gl->QueryCounter != NULL &&
+            gl->GetQueryObjectuiv != NULL &&
+            gl->GetQueryObjectui64v != NULL;
+    }
+
+    if (glcontext->has_pbo_compatibility) {
+        glcontext->has_pbo_compatibility =
+            gl->MapBufferRange != NULL &&
+            gl->UnmapBuffer != NULL;
+    }
+
+    if (glcontext->has_parallel_shader_compile) {
+        glcontext->has_parallel_shader_compile = gl->MaxShaderCompilerThreadsKHR != NULL;
+        /* Let the driver pick the number of compiler threads */
+        if (glcontext->has_parallel_shader_compile)
+            ngli_glMaxShaderCompilerThreadsKHR(gl, 0xFFFFFFFF);
+    }
+
+    glcontext->vendor   = (const char *)ngli_glGetString(gl, GL_VENDOR);
+    glcontext->renderer = (const char *)ngli_glGetString(gl, GL_RENDERER);
+    glcontext->version  = (const char *)ngli_glGetString(gl, GL_VERSION);
+
+    LOG(INFO, "OpenGL %d.%d ES2_compatibility=%d vertex_array_object=%d program_binary=%d parallel_shader_compile=%d sync=%d timer_query=%d pbo=%d",
         glcontext->major_version,
         glcontext->minor_version,
         glcontext->has_es2_compatibility,
-        glcontext->has_vao_compatibility);
+        glcontext->has_vao_compatibility,
+        glcontext->has_program_binary_compatibility,
+        glcontext->has_parallel_shader_compile,
+        glcontext->has_sync_compatibility,
+        glcontext->has_timer_query_compatibility,
+        glcontext->has_pbo_compatibility);
 
     glcontext->loaded = 1;
 
@@ -257,6 +429,14 @@ void ngli_glcontext_freep(struct glcontext **glcontextp)
 
     glcontext = *glcontextp;
 
+    if (glcontext->offscreen && glcontext->loaded) {
+        const struct glfunctions *gl = &glcontext->funcs;
+
+        ngli_glDeleteFramebuffers(gl, 1, &glcontext->framebuffer_id);
+        ngli_glDeleteRenderbuffers(gl, 1, &glcontext->depth_renderbuffer_id);
+        ngli_glDeleteTextures(gl, 1, &glcontext->color_texture_id);
+    }
+
     if (glcontext->class->uninit)
         glcontext->class->uninit(glcontext);
 
@@ -22,6 +22,7 @@
 #ifndef GLCONTEXT_H
 #define GLCONTEXT_H
 
+#include "glcache.h"
 #include "glfunctions.h"
 #include "glwrappers.h"
 
@@ -33,17 +34,38 @@ struct glcontext {
     int platform;
     int api;
     int wrapped;
+    int offscreen;
     void *priv_data;
 
+    /* Offscreen framebuffer, see ngli_glcontext_new_offscreen() */
+    int width;
+    int height;
+    GLuint framebuffer_id;
+    GLuint color_texture_id;
+    GLuint depth_renderbuffer_id;
+
     /* GL api */
     int loaded;
     int major_version;
     int minor_version;
     int has_es2_compatibility;
     int has_vao_compatibility;
+    int has_program_binary_compatibility;
+    int has_parallel_shader_compile;
+    int has_sync_compatibility;
+    int has_timer_query_compatibility;
+    int has_pbo_compatibility;
     int max_texture_image_units;
 
+    const char *vendor;
+    const char *renderer;
+    const char *version;
+
     struct glfunctions funcs;
+
+    /* GL state */
+    struct glcache cache;
+    int64_t nb_state_changes; /* GL calls issued by the cache, see ngl_get_stats() */
 };
 
 struct glcontext_class {
@@ -62,9 +84,11 @@ struct glcontext_class {
 
 struct glcontext *ngli_glcontext_new_wrapped(void *display, void *window, void *handle, int platform, int api);
 struct glcontext *ngli_glcontext_new_shared(struct glcontext *other);
+struct glcontext *ngli_glcontext_new_offscreen(int width, int height, int platform, int api);
 int ngli_glcontext_load_extensions(struct glcontext *glcontext);
 int ngli_glcontext_make_current(struct glcontext *glcontext, int current);
 void ngli_glcontext_swap_buffers(struct glcontext *glcontext);
+char *ngli_glcontext_null_get_log(struct glcontext *glcontext);
 void *ngli_glcontext_get_proc_address(struct glcontext *glcontext, const char *name);
 void *ngli_glcontext_get_handle(struct glcontext *glcontext);
 void *ngli_glcontext_get_texture_cache(struct glcontext *glcontext);
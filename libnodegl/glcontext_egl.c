@@ -21,15 +21,22 @@
 
 #include <stdio.h>
 #include <EGL/egl.h>
+#include <EGL/eglext.h>
 
 #include "glcontext.h"
+#include "log.h"
 #include "nodegl.h"
 
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
 struct glcontext_egl {
     EGLDisplay display;
     EGLSurface surface;
     EGLContext handle;
     EGLConfig config;
+    int own_display;
 };
 
 static int glcontext_egl_init(struct glcontext *glcontext, void *display, void *window, void *handle)
@@ -40,7 +47,8 @@ static int glcontext_egl_init(struct glcontext *glcontext, void *display, void *
     glcontext_egl->surface = window  ? *(EGLSurface *)window  : eglGetCurrentSurface(EGL_DRAW);
     glcontext_egl->handle  = handle  ? *(EGLContext *)handle  : eglGetCurrentContext();
 
-    if (!glcontext_egl->display || !glcontext_egl->surface || !glcontext_egl->handle)
+    /* The surface may legitimately be missing with EGL_KHR_surfaceless_context */
+    if (!glcontext_egl->display || !glcontext_egl->handle)
         return -1;
 
     return 0;
@@ -51,10 +59,39 @@ static void glcontext_egl_uninit(struct glcontext *glcontext)
     struct glcontext_egl *glcontext_egl = glcontext->priv_data;
 
     if (!glcontext->wrapped) {
+        if (glcontext_egl->handle == eglGetCurrentContext())
+            eglMakeCurrent(glcontext_egl->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (glcontext_egl->surface != EGL_NO_SURFACE)
+            eglDestroySurface(glcontext_egl->display, glcontext_egl->surface);
+        if (glcontext_egl->handle != EGL_NO_CONTEXT)
+            eglDestroyContext(glcontext_egl->display, glcontext_egl->handle);
+        if (glcontext_egl->own_display)
+            eglTerminate(glcontext_egl->display);
+    }
+}
 
-        eglDestroySurface(glcontext_egl->display, glcontext_egl->surface);
-        eglDestroyContext(glcontext_egl->display, glcontext_egl->handle);
+/*
+ * Open a display which does not need any window system: Mesa can render
+ * without X11 or a GPU (using its software rasterizer) through its
+ * surfaceless platform, otherwise fallback on the default display, which
+ * works with the EGL device based drivers.
+ */
+static EGLDisplay get_offscreen_display(void)
+{
+    const char *client_extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    if (ngli_glcontext_check_extension("EGL_MESA_platform_surfaceless", client_extensions) &&
+        ngli_glcontext_check_extension("EGL_EXT_platform_base", client_extensions)) {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display =
+            (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (get_platform_display) {
+            EGLDisplay display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+            if (display != EGL_NO_DISPLAY)
+                return display;
+        }
     }
+
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
 }
 
 static int glcontext_egl_create(struct glcontext *glcontext, struct glcontext *other)
@@ -62,10 +99,21 @@ static int glcontext_egl_create(struct glcontext *glcontext, struct glcontext *o
     int ret;
     EGLint error;
     struct glcontext_egl *glcontext_egl = glcontext->priv_data;
-    struct glcontext_egl *other_egl = other->priv_data;
+    struct glcontext_egl *other_egl = other ? other->priv_data : NULL;
+
+    if (!other) {
+        glcontext_egl->display = get_offscreen_display();
+        if (glcontext_egl->display == EGL_NO_DISPLAY) {
+            LOG(ERROR, "could not get an EGL display");
+            return -1;
+        }
+        glcontext_egl->own_display = 1;
+    }
+
+    const int gles = glcontext->api == NGL_GLAPI_OPENGLES2;
 
     const EGLint config_attribs[] = {
-        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+        EGL_RENDERABLE_TYPE, gles ? EGL_OPENGL_ES2_BIT : EGL_OPENGL_BIT,
         EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
         EGL_RED_SIZE,   8,
         EGL_GREEN_SIZE, 8,
@@ -79,11 +127,16 @@ static int glcontext_egl_create(struct glcontext *glcontext, struct glcontext *o
         EGL_NONE
     };
 
-    EGLint width;
-    EGLint height;
+    /*
+     * Contexts created from scratch or sharing a surfaceless context render
+     * into framebuffer objects so their surface size does not matter.
+     */
+    EGLint width = 1;
+    EGLint height = 1;
 
-    if (!eglQuerySurface(other_egl->display, other_egl->surface, EGL_WIDTH, &width) ||
-        !eglQuerySurface(other_egl->display, other_egl->surface, EGL_HEIGHT, &height)) {
+    if (other_egl && other_egl->surface != EGL_NO_SURFACE &&
+        (!eglQuerySurface(other_egl->display, other_egl->surface, EGL_WIDTH, &width) ||
+         !eglQuerySurface(other_egl->display, other_egl->surface, EGL_HEIGHT, &height))) {
         return -1;
     }
 
@@ -97,6 +150,13 @@ static int glcontext_egl_create(struct glcontext *glcontext, struct glcontext *o
     EGLint egl_major;
     ret = eglInitialize (glcontext_egl->display, &egl_major, &egl_minor);
     if (!ret) {
+        LOG(ERROR, "could not initialize EGL");
+        return -1;
+    }
+
+    ret = eglBindAPI(gles ? EGL_OPENGL_ES_API : EGL_OPENGL_API);
+    if (!ret) {
+        LOG(ERROR, "could not bind the EGL rendering API");
         return -1;
     }
 
@@ -105,16 +165,28 @@ static int glcontext_egl_create(struct glcontext *glcontext, struct glcontext *o
 
     ret = eglChooseConfig(glcontext_egl->display, config_attribs, &config, 1, &nb_configs);
     if (!ret || !nb_configs) {
+        LOG(ERROR, "could not find a suitable EGL config");
         return -1;
     }
 
-    glcontext_egl->handle = eglCreateContext(glcontext_egl->display, config, other_egl->handle, ctx_attribs);
+    EGLContext shared_handle = other_egl ? other_egl->handle : EGL_NO_CONTEXT;
+    glcontext_egl->handle = eglCreateContext(glcontext_egl->display, config, shared_handle,
+                                             gles ? ctx_attribs : NULL);
     if ((error = eglGetError()) != EGL_SUCCESS){
+        glcontext_egl->handle = EGL_NO_CONTEXT;
         return -1;
     }
 
+    const char *extensions = eglQueryString(glcontext_egl->display, EGL_EXTENSIONS);
+    if ((!other_egl || other_egl->surface == EGL_NO_SURFACE) &&
+        ngli_glcontext_check_extension("EGL_KHR_surfaceless_context", extensions)) {
+        glcontext_egl->surface = EGL_NO_SURFACE;
+        return 0;
+    }
+
     glcontext_egl->surface = eglCreatePbufferSurface(glcontext_egl->display, config, surface_attribs);
     if ((error = eglGetError()) != EGL_SUCCESS){
+        glcontext_egl->surface = EGL_NO_SURFACE;
         return -1;
     }
 
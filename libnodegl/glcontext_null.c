@@ -0,0 +1,390 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bstr.h"
+#include "glcontext.h"
+#include "utils.h"
+
+#include "glnull_data.h"
+
+#define LOG_SIZE (1 << 16)
+
+struct glcontext_null {
+    GLuint last_id;
+    int64_t nb_calls[GLNULL_NB_FUNCTIONS];
+    uint16_t *log;
+    int nb_logged;
+    int64_t nb_dropped;
+    void *mapped_buffer;
+};
+
+/*
+ * The stubs do not receive any context, so, as with a real driver, the calls
+ * are recorded in the context current on the calling thread.
+ */
+static pthread_key_t current_key;
+static pthread_once_t current_key_once = PTHREAD_ONCE_INIT;
+
+static void create_current_key(void)
+{
+    pthread_key_create(&current_key, NULL);
+}
+
+static void record_call(int id)
+{
+    struct glcontext_null *s = pthread_getspecific(current_key);
+    if (!s)
+        return;
+
+    s->nb_calls[id]++;
+    if (s->nb_logged < LOG_SIZE)
+        s->log[s->nb_logged++] = id;
+    else
+        s->nb_dropped++;
+}
+
+static void gen_ids(GLsizei n, GLuint *ids)
+{
+    struct glcontext_null *s = pthread_getspecific(current_key);
+    for (int i = 0; i < n; i++)
+        ids[i] = s ? ++s->last_id : 1;
+}
+
+#define DECLARE_GEN_FUNC(name)                                          \
+static NGLI_GL_APIENTRY void override_##name(GLsizei n, GLuint *ids)   \
+{                                                                       \
+    record_call(GLNULL_##name);                                         \
+    gen_ids(n, ids);                                                    \
+}
+
+DECLARE_GEN_FUNC(GenBuffers)
+DECLARE_GEN_FUNC(GenFramebuffers)
+DECLARE_GEN_FUNC(GenQueries)
+DECLARE_GEN_FUNC(GenRenderbuffers)
+DECLARE_GEN_FUNC(GenTextures)
+DECLARE_GEN_FUNC(GenVertexArrays)
+
+static NGLI_GL_APIENTRY GLuint override_CreateProgram(void)
+{
+    GLuint id;
+    record_call(GLNULL_CreateProgram);
+    gen_ids(1, &id);
+    return id;
+}
+
+static NGLI_GL_APIENTRY GLuint override_CreateShader(GLenum type)
+{
+    GLuint id;
+    record_call(GLNULL_CreateShader);
+    gen_ids(1, &id);
+    return id;
+}
+
+static NGLI_GL_APIENTRY GLenum override_CheckFramebufferStatus(GLenum target)
+{
+    record_call(GLNULL_CheckFramebufferStatus);
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+static NGLI_GL_APIENTRY GLsync override_FenceSync(GLenum condition, GLbitfield flags)
+{
+    static int sync;
+    record_call(GLNULL_FenceSync);
+    return (GLsync)&sync;
+}
+
+static NGLI_GL_APIENTRY void *override_MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    struct glcontext_null *s = pthread_getspecific(current_key);
+    record_call(GLNULL_MapBufferRange);
+    if (!s)
+        return NULL;
+    free(s->mapped_buffer);
+    s->mapped_buffer = calloc(1, length);
+    return s->mapped_buffer;
+}
+
+static NGLI_GL_APIENTRY GLboolean override_UnmapBuffer(GLenum target)
+{
+    struct glcontext_null *s = pthread_getspecific(current_key);
+    record_call(GLNULL_UnmapBuffer);
+    if (s) {
+        free(s->mapped_buffer);
+        s->mapped_buffer = NULL;
+    }
+    return GL_TRUE;
+}
+
+static NGLI_GL_APIENTRY void override_GetBooleanv(GLenum pname, GLboolean *data)
+{
+    record_call(GLNULL_GetBooleanv);
+    memset(data, 0, (pname == GL_COLOR_WRITEMASK ? 4 : 1) * sizeof(*data));
+}
+
+static NGLI_GL_APIENTRY void override_GetIntegerv(GLenum pname, GLint *data)
+{
+    record_call(GLNULL_GetIntegerv);
+    switch (pname) {
+    case GL_MAJOR_VERSION:
+    case GL_MINOR_VERSION:
+        *data = 3;
+        break;
+    case GL_MAX_TEXTURE_IMAGE_UNITS:
+        *data = 16;
+        break;
+    case GL_VIEWPORT:
+        memset(data, 0, 4 * sizeof(*data));
+        break;
+    default:
+        *data = 0;
+    }
+}
+
+static NGLI_GL_APIENTRY void override_GetProgramiv(GLuint program, GLenum pname, GLint *params)
+{
+    record_call(GLNULL_GetProgramiv);
+    *params = pname == GL_LINK_STATUS ? GL_TRUE : 0;
+}
+
+static NGLI_GL_APIENTRY void override_GetShaderiv(GLuint shader, GLenum pname, GLint *params)
+{
+    record_call(GLNULL_GetShaderiv);
+    *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+static NGLI_GL_APIENTRY void override_GetQueryObjectuiv(GLuint id, GLenum pname, GLuint *params)
+{
+    record_call(GLNULL_GetQueryObjectuiv);
+    *params = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+}
+
+static NGLI_GL_APIENTRY void override_GetQueryObjectui64v(GLuint id, GLenum pname, GLuint64 *params)
+{
+    record_call(GLNULL_GetQueryObjectui64v);
+    *params = 0;
+}
+
+static NGLI_GL_APIENTRY void override_GetRenderbufferParameteriv(GLenum target, GLenum pname, GLint *params)
+{
+    record_call(GLNULL_GetRenderbufferParameteriv);
+    *params = 0;
+}
+
+static NGLI_GL_APIENTRY const GLubyte *override_GetString(GLenum name)
+{
+    record_call(GLNULL_GetString);
+    switch (name) {
+    case GL_VENDOR:   return (const GLubyte *)"node.gl";
+    case GL_RENDERER: return (const GLubyte *)"null";
+    case GL_VERSION:  return (const GLubyte *)"3.3 null";
+    default:          return (const GLubyte *)"";
+    }
+}
+
+/* Stubs with an actual behaviour, taking precedence over the generated ones */
+static const struct glnull_function overrides[] = {
+    {"glCheckFramebufferStatus",      override_CheckFramebufferStatus},
+    {"glCreateProgram",               override_CreateProgram},
+    {"glCreateShader",                override_CreateShader},
+    {"glFenceSync",                   override_FenceSync},
+    {"glGenBuffers",                  override_GenBuffers},
+    {"glGenFramebuffers",             override_GenFramebuffers},
+    {"glGenQueries",                  override_GenQueries},
+    {"glGenRenderbuffers",            override_GenRenderbuffers},
+    {"glGenTextures",                 override_GenTextures},
+    {"glGenVertexArrays",             override_GenVertexArrays},
+    {"glGetBooleanv",                 override_GetBooleanv},
+    {"glGetIntegerv",                 override_GetIntegerv},
+    {"glGetProgramiv",                override_GetProgramiv},
+    {"glGetQueryObjectui64v",         override_GetQueryObjectui64v},
+    {"glGetQueryObjectuiv",           override_GetQueryObjectuiv},
+    {"glGetRenderbufferParameteriv",  override_GetRenderbufferParameteriv},
+    {"glGetShaderiv",                 override_GetShaderiv},
+    {"glGetString",                   override_GetString},
+    {"glMapBufferRange",              override_MapBufferRange},
+    {"glUnmapBuffer",                 override_UnmapBuffer},
+};
+
+static int glcontext_null_make_current(struct glcontext *glcontext, int current)
+{
+    pthread_setspecific(current_key, current ? glcontext->priv_data : NULL);
+    return 0;
+}
+
+static int init_log(struct glcontext *glcontext)
+{
+    struct glcontext_null *glcontext_null = glcontext->priv_data;
+
+    pthread_once(&current_key_once, create_current_key);
+
+    /* A shared context goes through both the init and the create callbacks */
+    if (glcontext_null->log)
+        return 0;
+
+    glcontext_null->log = malloc(LOG_SIZE * sizeof(*glcontext_null->log));
+    if (!glcontext_null->log)
+        return -1;
+
+    return 0;
+}
+
+static int glcontext_null_init(struct glcontext *glcontext, void *display, void *window, void *handle)
+{
+    int ret = init_log(glcontext);
+    if (ret < 0)
+        return ret;
+
+    /* There is no context to wrap, so this one becomes the current one */
+    return glcontext_null_make_current(glcontext, 1);
+}
+
+static int glcontext_null_create(struct glcontext *glcontext, struct glcontext *other)
+{
+    return init_log(glcontext);
+}
+
+static void glcontext_null_uninit(struct glcontext *glcontext)
+{
+    struct glcontext_null *glcontext_null = glcontext->priv_data;
+
+    if (pthread_getspecific(current_key) == glcontext_null)
+        glcontext_null_make_current(glcontext, 0);
+    free(glcontext_null->mapped_buffer);
+    free(glcontext_null->log);
+}
+
+static void *glcontext_null_get_display(struct glcontext *glcontext)
+{
+    return NULL;
+}
+
+static void *glcontext_null_get_window(struct glcontext *glcontext)
+{
+    return NULL;
+}
+
+static void *glcontext_null_get_handle(struct glcontext *glcontext)
+{
+    return NULL;
+}
+
+static void *glcontext_null_get_proc_address(struct glcontext *glcontext, const char *name)
+{
+    for (int i = 0; i < NGLI_ARRAY_NB(overrides); i++)
+        if (!strcmp(overrides[i].name, name))
+            return overrides[i].func;
+
+    for (int i = 0; i < NGLI_ARRAY_NB(glnull_functions); i++)
+        if (!strcmp(glnull_functions[i].name, name))
+            return glnull_functions[i].func;
+
+    return NULL;
+}
+
+enum {
+    CATEGORY_DRAW,
+    CATEGORY_BIND,
+    CATEGORY_UPLOAD,
+    CATEGORY_GET,
+    NB_CATEGORIES
+};
+
+static const char * const category_names[NB_CATEGORIES] = {
+    [CATEGORY_DRAW]   = "draw_calls",
+    [CATEGORY_BIND]   = "binds",
+    [CATEGORY_UPLOAD] = "uploads",
+    [CATEGORY_GET]    = "gets",
+};
+
+static int get_category(const char *name)
+{
+    if (!strncmp(name, "glDraw", 6))
+        return CATEGORY_DRAW;
+    if (!strncmp(name, "glBind", 6) || !strcmp(name, "glUseProgram"))
+        return CATEGORY_BIND;
+    if (!strcmp(name, "glTexImage2D") || !strcmp(name, "glTexSubImage2D") ||
+        !strcmp(name, "glBufferData") || !strcmp(name, "glBufferSubData"))
+        return CATEGORY_UPLOAD;
+    if (!strncmp(name, "glGet", 5))
+        return CATEGORY_GET;
+    return -1;
+}
+
+char *ngli_glcontext_null_get_log(struct glcontext *glcontext)
+{
+    struct glcontext_null *glcontext_null = glcontext->priv_data;
+
+    struct bstr *b = ngli_bstr_create();
+    if (!b)
+        return NULL;
+
+    int64_t total = 0;
+    int64_t categories[NB_CATEGORIES] = {0};
+    for (int i = 0; i < GLNULL_NB_FUNCTIONS; i++) {
+        const int64_t nb_calls = glcontext_null->nb_calls[i];
+        const int category = get_category(glnull_functions[i].name);
+        if (category >= 0)
+            categories[category] += nb_calls;
+        total += nb_calls;
+    }
+
+    ngli_bstr_print(b, "counter,value\n");
+    for (int i = 0; i < NB_CATEGORIES; i++)
+        ngli_bstr_print(b, "%s,%" PRId64 "\n", category_names[i], categories[i]);
+    ngli_bstr_print(b, "total,%" PRId64 "\n", total);
+    ngli_bstr_print(b, "dropped,%" PRId64 "\n", glcontext_null->nb_dropped);
+
+    ngli_bstr_print(b, "\nfunction,calls\n");
+    for (int i = 0; i < GLNULL_NB_FUNCTIONS; i++)
+        if (glcontext_null->nb_calls[i])
+            ngli_bstr_print(b, "%s,%" PRId64 "\n",
+                            glnull_functions[i].name, glcontext_null->nb_calls[i]);
+
+    ngli_bstr_print(b, "\ncall\n");
+    for (int i = 0; i < glcontext_null->nb_logged; i++)
+        ngli_bstr_print(b, "%s\n", glnull_functions[glcontext_null->log[i]].name);
+
+    memset(glcontext_null->nb_calls, 0, sizeof(glcontext_null->nb_calls));
+    glcontext_null->nb_logged = 0;
+    glcontext_null->nb_dropped = 0;
+
+    char *str = ngli_bstr_strdup(b);
+    ngli_bstr_freep(&b);
+    return str;
+}
+
+const struct glcontext_class ngli_glcontext_null_class = {
+    .init = glcontext_null_init,
+    .uninit = glcontext_null_uninit,
+    .create = glcontext_null_create,
+    .make_current = glcontext_null_make_current,
+    .get_display = glcontext_null_get_display,
+    .get_window = glcontext_null_get_window,
+    .get_handle = glcontext_null_get_handle,
+    .get_proc_address = glcontext_null_get_proc_address,
+    .priv_size = sizeof(struct glcontext_null),
+};
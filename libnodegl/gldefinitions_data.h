@@ -26,6 +26,7 @@ static const struct gldefinition {
     {"glBlendFuncSeparate", offsetof(struct glfunctions, BlendFuncSeparate), M},
     {"glBlitFramebuffer", offsetof(struct glfunctions, BlitFramebuffer), 0},
     {"glBufferData", offsetof(struct glfunctions, BufferData), M},
+    {"glBufferSubData", offsetof(struct glfunctions, BufferSubData), M},
     {"glCheckFramebufferStatus", offsetof(struct glfunctions, CheckFramebufferStatus), M},
     {"glClear", offsetof(struct glfunctions, Clear), M},
     {"glClearColor", offsetof(struct glfunctions, ClearColor), M},
@@ -36,19 +37,26 @@ static const struct gldefinition {
     {"glDeleteBuffers", offsetof(struct glfunctions, DeleteBuffers), M},
     {"glDeleteFramebuffers", offsetof(struct glfunctions, DeleteFramebuffers), M},
     {"glDeleteProgram", offsetof(struct glfunctions, DeleteProgram), M},
+    {"glDeleteQueries", offsetof(struct glfunctions, DeleteQueries), 0},
     {"glDeleteRenderbuffers", offsetof(struct glfunctions, DeleteRenderbuffers), M},
     {"glDeleteShader", offsetof(struct glfunctions, DeleteShader), M},
+    {"glDeleteSync", offsetof(struct glfunctions, DeleteSync), 0},
     {"glDeleteTextures", offsetof(struct glfunctions, DeleteTextures), M},
     {"glDeleteVertexArrays", offsetof(struct glfunctions, DeleteVertexArrays), 0},
     {"glDetachShader", offsetof(struct glfunctions, DetachShader), M},
     {"glDisable", offsetof(struct glfunctions, Disable), M},
+    {"glDrawArrays", offsetof(struct glfunctions, DrawArrays), M},
     {"glDrawElements", offsetof(struct glfunctions, DrawElements), M},
     {"glEnable", offsetof(struct glfunctions, Enable), M},
     {"glEnableVertexAttribArray", offsetof(struct glfunctions, EnableVertexAttribArray), M},
+    {"glFenceSync", offsetof(struct glfunctions, FenceSync), 0},
+    {"glFinish", offsetof(struct glfunctions, Finish), M},
+    {"glFlush", offsetof(struct glfunctions, Flush), M},
     {"glFramebufferRenderbuffer", offsetof(struct glfunctions, FramebufferRenderbuffer), M},
     {"glFramebufferTexture2D", offsetof(struct glfunctions, FramebufferTexture2D), M},
     {"glGenBuffers", offsetof(struct glfunctions, GenBuffers), M},
     {"glGenFramebuffers", offsetof(struct glfunctions, GenFramebuffers), M},
+    {"glGenQueries", offsetof(struct glfunctions, GenQueries), 0},
     {"glGenRenderbuffers", offsetof(struct glfunctions, GenRenderbuffers), M},
     {"glGenTextures", offsetof(struct glfunctions, GenTextures), M},
     {"glGenVertexArrays", offsetof(struct glfunctions, GenVertexArrays), 0},
@@ -58,8 +66,11 @@ static const struct gldefinition {
     {"glGetBooleanv", offsetof(struct glfunctions, GetBooleanv), M},
     {"glGetError", offsetof(struct glfunctions, GetError), M},
     {"glGetIntegerv", offsetof(struct glfunctions, GetIntegerv), M},
+    {"glGetProgramBinary", offsetof(struct glfunctions, GetProgramBinary), 0},
     {"glGetProgramInfoLog", offsetof(struct glfunctions, GetProgramInfoLog), M},
     {"glGetProgramiv", offsetof(struct glfunctions, GetProgramiv), M},
+    {"glGetQueryObjectui64v", offsetof(struct glfunctions, GetQueryObjectui64v), 0},
+    {"glGetQueryObjectuiv", offsetof(struct glfunctions, GetQueryObjectuiv), 0},
     {"glGetRenderbufferParameteriv", offsetof(struct glfunctions, GetRenderbufferParameteriv), M},
     {"glGetShaderInfoLog", offsetof(struct glfunctions, GetShaderInfoLog), M},
     {"glGetShaderSource", offsetof(struct glfunctions, GetShaderSource), M},
@@ -68,6 +79,11 @@ static const struct gldefinition {
     {"glGetStringi", offsetof(struct glfunctions, GetStringi), M},
     {"glGetUniformLocation", offsetof(struct glfunctions, GetUniformLocation), M},
     {"glLinkProgram", offsetof(struct glfunctions, LinkProgram), M},
+    {"glMapBufferRange", offsetof(struct glfunctions, MapBufferRange), 0},
+    {"glMaxShaderCompilerThreadsKHR", offsetof(struct glfunctions, MaxShaderCompilerThreadsKHR), 0},
+    {"glProgramBinary", offsetof(struct glfunctions, ProgramBinary), 0},
+    {"glProgramParameteri", offsetof(struct glfunctions, ProgramParameteri), 0},
+    {"glQueryCounter", offsetof(struct glfunctions, QueryCounter), 0},
     {"glReadPixels", offsetof(struct glfunctions, ReadPixels), M},
     {"glReleaseShaderCompiler", offsetof(struct glfunctions, ReleaseShaderCompiler), M},
     {"glRenderbufferStorage", offsetof(struct glfunctions, RenderbufferStorage), M},
@@ -101,7 +117,9 @@ static const struct gldefinition {
     {"glUniformMatrix2fv", offsetof(struct glfunctions, UniformMatrix2fv), M},
     {"glUniformMatrix3fv", offsetof(struct glfunctions, UniformMatrix3fv), M},
     {"glUniformMatrix4fv", offsetof(struct glfunctions, UniformMatrix4fv), M},
+    {"glUnmapBuffer", offsetof(struct glfunctions, UnmapBuffer), 0},
     {"glUseProgram", offsetof(struct glfunctions, UseProgram), M},
     {"glVertexAttribPointer", offsetof(struct glfunctions, VertexAttribPointer), M},
     {"glViewport", offsetof(struct glfunctions, Viewport), M},
+    {"glWaitSync", offsetof(struct glfunctions, WaitSync), 0},
 };
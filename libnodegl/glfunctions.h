@@ -27,6 +27,7 @@ struct glfunctions {
     NGLI_GL_APIENTRY void (*BlendFuncSeparate)(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha);
     NGLI_GL_APIENTRY void (*BlitFramebuffer)(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter);
     NGLI_GL_APIENTRY void (*BufferData)(GLenum target, GLsizeiptr size, const void * data, GLenum usage);
+    NGLI_GL_APIENTRY void (*BufferSubData)(GLenum target, GLintptr offset, GLsizeiptr size, const void * data);
     NGLI_GL_APIENTRY GLenum (*CheckFramebufferStatus)(GLenum target);
     NGLI_GL_APIENTRY void (*Clear)(GLbitfield mask);
     NGLI_GL_APIENTRY void (*ClearColor)(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
@@ -37,19 +38,26 @@ struct glfunctions {
     NGLI_GL_APIENTRY void (*DeleteBuffers)(GLsizei n, const GLuint * buffers);
     NGLI_GL_APIENTRY void (*DeleteFramebuffers)(GLsizei n, const GLuint * framebuffers);
     NGLI_GL_APIENTRY void (*DeleteProgram)(GLuint program);
+    NGLI_GL_APIENTRY void (*DeleteQueries)(GLsizei n, const GLuint * ids);
     NGLI_GL_APIENTRY void (*DeleteRenderbuffers)(GLsizei n, const GLuint * renderbuffers);
     NGLI_GL_APIENTRY void (*DeleteShader)(GLuint shader);
+    NGLI_GL_APIENTRY void (*DeleteSync)(GLsync sync);
     NGLI_GL_APIENTRY void (*DeleteTextures)(GLsizei n, const GLuint * textures);
     NGLI_GL_APIENTRY void (*DeleteVertexArrays)(GLsizei n, const GLuint * arrays);
     NGLI_GL_APIENTRY void (*DetachShader)(GLuint program, GLuint shader);
     NGLI_GL_APIENTRY void (*Disable)(GLenum cap);
+    NGLI_GL_APIENTRY void (*DrawArrays)(GLenum mode, GLint first, GLsizei count);
     NGLI_GL_APIENTRY void (*DrawElements)(GLenum mode, GLsizei count, GLenum type, const void * indices);
     NGLI_GL_APIENTRY void (*Enable)(GLenum cap);
     NGLI_GL_APIENTRY void (*EnableVertexAttribArray)(GLuint index);
+    NGLI_GL_APIENTRY GLsync (*FenceSync)(GLenum condition, GLbitfield flags);
+    NGLI_GL_APIENTRY void (*Finish)(void);
+    NGLI_GL_APIENTRY void (*Flush)(void);
     NGLI_GL_APIENTRY void (*FramebufferRenderbuffer)(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
     NGLI_GL_APIENTRY void (*FramebufferTexture2D)(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
     NGLI_GL_APIENTRY void (*GenBuffers)(GLsizei n, GLuint * buffers);
     NGLI_GL_APIENTRY void (*GenFramebuffers)(GLsizei n, GLuint * framebuffers);
+    NGLI_GL_APIENTRY void (*GenQueries)(GLsizei n, GLuint * ids);
     NGLI_GL_APIENTRY void (*GenRenderbuffers)(GLsizei n, GLuint * renderbuffers);
     NGLI_GL_APIENTRY void (*GenTextures)(GLsizei n, GLuint * textures);
     NGLI_GL_APIENTRY void (*GenVertexArrays)(GLsizei n, GLuint * arrays);
@@ -59,8 +67,11 @@ struct glfunctions {
     NGLI_GL_APIENTRY void (*GetBooleanv)(GLenum pname, GLboolean * data);
     NGLI_GL_APIENTRY GLenum (*GetError)();
     NGLI_GL_APIENTRY void (*GetIntegerv)(GLenum pname, GLint * data);
+    NGLI_GL_APIENTRY void (*GetProgramBinary)(GLuint program, GLsizei bufSize, GLsizei * length, GLenum * binaryFormat, void * binary);
     NGLI_GL_APIENTRY void (*GetProgramInfoLog)(GLuint program, GLsizei bufSize, GLsizei * length, GLchar * infoLog);
     NGLI_GL_APIENTRY void (*GetProgramiv)(GLuint program, GLenum pname, GLint * params);
+    NGLI_GL_APIENTRY void (*GetQueryObjectui64v)(GLuint id, GLenum pname, GLuint64 * params);
+    NGLI_GL_APIENTRY void (*GetQueryObjectuiv)(GLuint id, GLenum pname, GLuint * params);
     NGLI_GL_APIENTRY void (*GetRenderbufferParameteriv)(GLenum target, GLenum pname, GLint * params);
     NGLI_GL_APIENTRY void (*GetShaderInfoLog)(GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * infoLog);
     NGLI_GL_APIENTRY void (*GetShaderSource)(GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * source);
@@ -69,6 +80,11 @@ struct glfunctions {
     NGLI_GL_APIENTRY const GLubyte * (*GetStringi)(GLenum name, GLuint index);
     NGLI_GL_APIENTRY GLint (*GetUniformLocation)(GLuint program, const GLchar * name);
     NGLI_GL_APIENTRY void (*LinkProgram)(GLuint program);
+    NGLI_GL_APIENTRY void * (*MapBufferRange)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+    NGLI_GL_APIENTRY void (*MaxShaderCompilerThreadsKHR)(GLuint count);
+    NGLI_GL_APIENTRY void (*ProgramBinary)(GLuint program, GLenum binaryFormat, const void * binary, GLsizei length);
+    NGLI_GL_APIENTRY void (*ProgramParameteri)(GLuint program, GLenum pname, GLint value);
+    NGLI_GL_APIENTRY void (*QueryCounter)(GLuint id, GLenum target);
     NGLI_GL_APIENTRY void (*ReadPixels)(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void * pixels);
     NGLI_GL_APIENTRY void (*ReleaseShaderCompiler)();
     NGLI_GL_APIENTRY void (*RenderbufferStorage)(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
@@ -102,9 +118,11 @@ struct glfunctions {
     NGLI_GL_APIENTRY void (*UniformMatrix2fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat * value);
     NGLI_GL_APIENTRY void (*UniformMatrix3fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat * value);
     NGLI_GL_APIENTRY void (*UniformMatrix4fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat * value);
+    NGLI_GL_APIENTRY GLboolean (*UnmapBuffer)(GLenum target);
     NGLI_GL_APIENTRY void (*UseProgram)(GLuint program);
     NGLI_GL_APIENTRY void (*VertexAttribPointer)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer);
     NGLI_GL_APIENTRY void (*Viewport)(GLint x, GLint y, GLsizei width, GLsizei height);
+    NGLI_GL_APIENTRY void (*WaitSync)(GLsync sync, GLbitfield flags, GLuint64 timeout);
 };
 
 #endif
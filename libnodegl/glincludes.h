@@ -32,6 +32,17 @@
 #  define GL_NUM_EXTENSIONS 0x821D
 #  define GL_RED            GL_LUMINANCE
 #  define GL_R32F           0x822E
+#  define GL_PROGRAM_BINARY_LENGTH      0x8741
+#  define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#  define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#  define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#  define GL_TIMEOUT_IGNORED            0xFFFFFFFFFFFFFFFFull
+#  define GL_QUERY_RESULT               0x8866
+#  define GL_QUERY_RESULT_AVAILABLE     0x8867
+#  define GL_TIMESTAMP                  0x8E28
+#  define GL_PIXEL_PACK_BUFFER          0x88EB
+#  define GL_STREAM_READ                0x88E1
+#  define GL_MAP_READ_BIT               0x0001
 # elif TARGET_OS_MAC
 #  include <OpenGL/gl3.h>
 #  include <OpenGL/glext.h>
@@ -47,6 +58,17 @@
 # define GL_NUM_EXTENSIONS 0x821D
 # define GL_RED            GL_LUMINANCE
 # define GL_R32F           0x822E
+# define GL_PROGRAM_BINARY_LENGTH      0x8741
+# define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+# define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+# define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+# define GL_TIMEOUT_IGNORED            0xFFFFFFFFFFFFFFFFull
+# define GL_QUERY_RESULT               0x8866
+# define GL_QUERY_RESULT_AVAILABLE     0x8867
+# define GL_TIMESTAMP                  0x8E28
+# define GL_PIXEL_PACK_BUFFER          0x88EB
+# define GL_STREAM_READ                0x88E1
+# define GL_MAP_READ_BIT               0x0001
 #endif
 
 #if __linux__ && !__ANDROID__
@@ -0,0 +1,807 @@
+/* DO NOT EDIT - This file is autogenerated */
+
+/*
+ * Stubs of the GL functions for the null GL context (glcontext_null.c). They
+ * only record the call through record_call(), and return 0 when a value is
+ * expected.
+ */
+
+enum {
+    GLNULL_ActiveTexture,
+    GLNULL_AttachShader,
+    GLNULL_BindAttribLocation,
+    GLNULL_BindBuffer,
+    GLNULL_BindFramebuffer,
+    GLNULL_BindRenderbuffer,
+    GLNULL_BindTexture,
+    GLNULL_BindVertexArray,
+    GLNULL_BlendColor,
+    GLNULL_BlendEquation,
+    GLNULL_BlendEquationSeparate,
+    GLNULL_BlendFunc,
+    GLNULL_BlendFuncSeparate,
+    GLNULL_BlitFramebuffer,
+    GLNULL_BufferData,
+    GLNULL_BufferSubData,
+    GLNULL_CheckFramebufferStatus,
+    GLNULL_Clear,
+    GLNULL_ClearColor,
+    GLNULL_ColorMask,
+    GLNULL_CompileShader,
+    GLNULL_CreateProgram,
+    GLNULL_CreateShader,
+    GLNULL_DeleteBuffers,
+    GLNULL_DeleteFramebuffers,
+    GLNULL_DeleteProgram,
+    GLNULL_DeleteQueries,
+    GLNULL_DeleteRenderbuffers,
+    GLNULL_DeleteShader,
+    GLNULL_DeleteSync,
+    GLNULL_DeleteTextures,
+    GLNULL_DeleteVertexArrays,
+    GLNULL_DetachShader,
+    GLNULL_Disable,
+    GLNULL_DrawArrays,
+    GLNULL_DrawElements,
+    GLNULL_Enable,
+    GLNULL_EnableVertexAttribArray,
+    GLNULL_FenceSync,
+    GLNULL_Finish,
+    GLNULL_Flush,
+    GLNULL_FramebufferRenderbuffer,
+    GLNULL_FramebufferTexture2D,
+    GLNULL_GenBuffers,
+    GLNULL_GenFramebuffers,
+    GLNULL_GenQueries,
+    GLNULL_GenRenderbuffers,
+    GLNULL_GenTextures,
+    GLNULL_GenVertexArrays,
+    GLNULL_GenerateMipmap,
+    GLNULL_GetAttachedShaders,
+    GLNULL_GetAttribLocation,
+    GLNULL_GetBooleanv,
+    GLNULL_GetError,
+    GLNULL_GetIntegerv,
+    GLNULL_GetProgramBinary,
+    GLNULL_GetProgramInfoLog,
+    GLNULL_GetProgramiv,
+    GLNULL_GetQueryObjectui64v,
+    GLNULL_GetQueryObjectuiv,
+    GLNULL_GetRenderbufferParameteriv,
+    GLNULL_GetShaderInfoLog,
+    GLNULL_GetShaderSource,
+    GLNULL_GetShaderiv,
+    GLNULL_GetString,
+    GLNULL_GetStringi,
+    GLNULL_GetUniformLocation,
+    GLNULL_LinkProgram,
+    GLNULL_MapBufferRange,
+    GLNULL_MaxShaderCompilerThreadsKHR,
+    GLNULL_ProgramBinary,
+    GLNULL_ProgramParameteri,
+    GLNULL_QueryCounter,
+    GLNULL_ReadPixels,
+    GLNULL_ReleaseShaderCompiler,
+    GLNULL_RenderbufferStorage,
+    GLNULL_ShaderBinary,
+    GLNULL_ShaderSource,
+    GLNULL_StencilFunc,
+    GLNULL_StencilFuncSeparate,
+    GLNULL_StencilMask,
+    GLNULL_StencilMaskSeparate,
+    GLNULL_StencilOp,
+    GLNULL_StencilOpSeparate,
+    GLNULL_TexImage2D,
+    GLNULL_TexParameteri,
+    GLNULL_TexSubImage2D,
+    GLNULL_Uniform1f,
+    GLNULL_Uniform1fv,
+    GLNULL_Uniform1i,
+    GLNULL_Uniform1iv,
+    GLNULL_Uniform2f,
+    GLNULL_Uniform2fv,
+    GLNULL_Uniform2i,
+    GLNULL_Uniform2iv,
+    GLNULL_Uniform3f,
+    GLNULL_Uniform3fv,
+    GLNULL_Uniform3i,
+    GLNULL_Uniform3iv,
+    GLNULL_Uniform4f,
+    GLNULL_Uniform4fv,
+    GLNULL_Uniform4i,
+    GLNULL_Uniform4iv,
+    GLNULL_UniformMatrix2fv,
+    GLNULL_UniformMatrix3fv,
+    GLNULL_UniformMatrix4fv,
+    GLNULL_UnmapBuffer,
+    GLNULL_UseProgram,
+    GLNULL_VertexAttribPointer,
+    GLNULL_Viewport,
+    GLNULL_WaitSync,
+    GLNULL_NB_FUNCTIONS
+};
+
+static void record_call(int id);
+
+static NGLI_GL_APIENTRY void null_ActiveTexture(GLenum texture)
+{
+    record_call(GLNULL_ActiveTexture);
+}
+
+static NGLI_GL_APIENTRY void null_AttachShader(GLuint program, GLuint shader)
+{
+    record_call(GLNULL_AttachShader);
+}
+
+static NGLI_GL_APIENTRY void null_BindAttribLocation(GLuint program, GLuint index, const GLchar * name)
+{
+    record_call(GLNULL_BindAttribLocation);
+}
+
+static NGLI_GL_APIENTRY void null_BindBuffer(GLenum target, GLuint buffer)
+{
+    record_call(GLNULL_BindBuffer);
+}
+
+static NGLI_GL_APIENTRY void null_BindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    record_call(GLNULL_BindFramebuffer);
+}
+
+static NGLI_GL_APIENTRY void null_BindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+    record_call(GLNULL_BindRenderbuffer);
+}
+
+static NGLI_GL_APIENTRY void null_BindTexture(GLenum target, GLuint texture)
+{
+    record_call(GLNULL_BindTexture);
+}
+
+static NGLI_GL_APIENTRY void null_BindVertexArray(GLuint array)
+{
+    record_call(GLNULL_BindVertexArray);
+}
+
+static NGLI_GL_APIENTRY void null_BlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    record_call(GLNULL_BlendColor);
+}
+
+static NGLI_GL_APIENTRY void null_BlendEquation(GLenum mode)
+{
+    record_call(GLNULL_BlendEquation);
+}
+
+static NGLI_GL_APIENTRY void null_BlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha)
+{
+    record_call(GLNULL_BlendEquationSeparate);
+}
+
+static NGLI_GL_APIENTRY void null_BlendFunc(GLenum sfactor, GLenum dfactor)
+{
+    record_call(GLNULL_BlendFunc);
+}
+
+static NGLI_GL_APIENTRY void null_BlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha)
+{
+    record_call(GLNULL_BlendFuncSeparate);
+}
+
+static NGLI_GL_APIENTRY void null_BlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)
+{
+    record_call(GLNULL_BlitFramebuffer);
+}
+
+static NGLI_GL_APIENTRY void null_BufferData(GLenum target, GLsizeiptr size, const void * data, GLenum usage)
+{
+    record_call(GLNULL_BufferData);
+}
+
+static NGLI_GL_APIENTRY void null_BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void * data)
+{
+    record_call(GLNULL_BufferSubData);
+}
+
+static NGLI_GL_APIENTRY GLenum null_CheckFramebufferStatus(GLenum target)
+{
+    record_call(GLNULL_CheckFramebufferStatus);
+    return 0;
+}
+
+static NGLI_GL_APIENTRY void null_Clear(GLbitfield mask)
+{
+    record_call(GLNULL_Clear);
+}
+
+static NGLI_GL_APIENTRY void null_ClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    record_call(GLNULL_ClearColor);
+}
+
+static NGLI_GL_APIENTRY void null_ColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+{
+    record_call(GLNULL_ColorMask);
+}
+
+static NGLI_GL_APIENTRY void null_CompileShader(GLuint shader)
+{
+    record_call(GLNULL_CompileShader);
+}
+
+static NGLI_GL_APIENTRY GLuint null_CreateProgram()
+{
+    record_call(GLNULL_CreateProgram);
+    return 0;
+}
+
+static NGLI_GL_APIENTRY GLuint null_CreateShader(GLenum type)
+{
+    record_call(GLNULL_CreateShader);
+    return 0;
+}
+
+static NGLI_GL_APIENTRY void null_DeleteBuffers(GLsizei n, const GLuint * buffers)
+{
+    record_call(GLNULL_DeleteBuffers);
+}
+
+static NGLI_GL_APIENTRY void null_DeleteFramebuffers(GLsizei n, const GLuint * framebuffers)
+{
+    record_call(GLNULL_DeleteFramebuffers);
+}
+
+static NGLI_GL_APIENTRY void null_DeleteProgram(GLuint program)
+{
+    record_call(GLNULL_DeleteProgram);
+}
+
+static NGLI_GL_APIENTRY void null_DeleteQueries(GLsizei n, const GLuint * ids)
+{
+    record_call(GLNULL_DeleteQueries);
+}
+
+static NGLI_GL_APIENTRY void null_DeleteRenderbuffers(GLsizei n, const GLuint * renderbuffers)
+{
+    record_call(GLNULL_DeleteRenderbuffers);
+}
+
+static NGLI_GL_APIENTRY void null_DeleteShader(GLuint shader)
+{
+    record_call(GLNULL_DeleteShader);
+}
+
+static NGLI_GL_APIENTRY void null_DeleteSync(GLsync sync)
+{
+    record_call(GLNULL_DeleteSync);
+}
+
+static NGLI_GL_APIENTRY void null_DeleteTextures(GLsizei n, const GLuint * textures)
+{
+    record_call(GLNULL_DeleteTextures);
+}
+
+static NGLI_GL_APIENTRY void null_DeleteVertexArrays(GLsizei n, const GLuint * arrays)
+{
+    record_call(GLNULL_DeleteVertexArrays);
+}
+
+static NGLI_GL_APIENTRY void null_DetachShader(GLuint program, GLuint shader)
+{
+    record_call(GLNULL_DetachShader);
+}
+
+static NGLI_GL_APIENTRY void null_Disable(GLenum cap)
+{
+    record_call(GLNULL_Disable);
+}
+
+static NGLI_GL_APIENTRY void null_DrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    record_call(GLNULL_DrawArrays);
+}
+
+static NGLI_GL_APIENTRY void null_DrawElements(GLenum mode, GLsizei count, GLenum type, const void * indices)
+{
+    record_call(GLNULL_DrawElements);
+}
+
+static NGLI_GL_APIENTRY void null_Enable(GLenum cap)
+{
+    record_call(GLNULL_Enable);
+}
+
+static NGLI_GL_APIENTRY void null_EnableVertexAttribArray(GLuint index)
+{
+    record_call(GLNULL_EnableVertexAttribArray);
+}
+
+static NGLI_GL_APIENTRY GLsync null_FenceSync(GLenum condition, GLbitfield flags)
+{
+    record_call(GLNULL_FenceSync);
+    return 0;
+}
+
+static NGLI_GL_APIENTRY void null_Finish(void)
+{
+    record_call(GLNULL_Finish);
+}
+
+static NGLI_GL_APIENTRY void null_Flush(void)
+{
+    record_call(GLNULL_Flush);
+}
+
+static NGLI_GL_APIENTRY void null_FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+    record_call(GLNULL_FramebufferRenderbuffer);
+}
+
+static NGLI_GL_APIENTRY void null_FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+    record_call(GLNULL_FramebufferTexture2D);
+}
+
+static NGLI_GL_APIENTRY void null_GenBuffers(GLsizei n, GLuint * buffers)
+{
+    record_call(GLNULL_GenBuffers);
+}
+
+static NGLI_GL_APIENTRY void null_GenFramebuffers(GLsizei n, GLuint * framebuffers)
+{
+    record_call(GLNULL_GenFramebuffers);
+}
+
+static NGLI_GL_APIENTRY void null_GenQueries(GLsizei n, GLuint * ids)
+{
+    record_call(GLNULL_GenQueries);
+}
+
+static NGLI_GL_APIENTRY void null_GenRenderbuffers(GLsizei n, GLuint * renderbuffers)
+{
+    record_call(GLNULL_GenRenderbuffers);
+}
+
+static NGLI_GL_APIENTRY void null_GenTextures(GLsizei n, GLuint * textures)
+{
+    record_call(GLNULL_GenTextures);
+}
+
+static NGLI_GL_APIENTRY void null_GenVertexArrays(GLsizei n, GLuint * arrays)
+{
+    record_call(GLNULL_GenVertexArrays);
+}
+
+static NGLI_GL_APIENTRY void null_GenerateMipmap(GLenum target)
+{
+    record_call(GLNULL_GenerateMipmap);
+}
+
+static NGLI_GL_APIENTRY void null_GetAttachedShaders(GLuint program, GLsizei maxCount, GLsizei * count, GLuint * shaders)
+{
+    record_call(GLNULL_GetAttachedShaders);
+}
+
+static NGLI_GL_APIENTRY GLint null_GetAttribLocation(GLuint program, const GLchar * name)
+{
+    record_call(GLNULL_GetAttribLocation);
+    return 0;
+}
+
+static NGLI_GL_APIENTRY void null_GetBooleanv(GLenum pname, GLboolean * data)
+{
+    record_call(GLNULL_GetBooleanv);
+}
+
+static NGLI_GL_APIENTRY GLenum null_GetError()
+{
+    record_call(GLNULL_GetError);
+    return 0;
+}
+
+static NGLI_GL_APIENTRY void null_GetIntegerv(GLenum pname, GLint * data)
+{
+    record_call(GLNULL_GetIntegerv);
+}
+
+static NGLI_GL_APIENTRY void null_GetProgramBinary(GLuint program, GLsizei bufSize, GLsizei * length, GLenum * binaryFormat, void * binary)
+{
+    record_call(GLNULL_GetProgramBinary);
+}
+
+static NGLI_GL_APIENTRY void null_GetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei * length, GLchar * infoLog)
+{
+    record_call(GLNULL_GetProgramInfoLog);
+}
+
+static NGLI_GL_APIENTRY void null_GetProgramiv(GLuint program, GLenum pname, GLint * params)
+{
+    record_call(GLNULL_GetProgramiv);
+}
+
+static NGLI_GL_APIENTRY void null_GetQueryObjectui64v(GLuint id, GLenum pname, GLuint64 * params)
+{
+    record_call(GLNULL_GetQueryObjectui64v);
+}
+
+static NGLI_GL_APIENTRY void null_GetQueryObjectuiv(GLuint id, GLenum pname, GLuint * params)
+{
+    record_call(GLNULL_GetQueryObjectuiv);
+}
+
+static NGLI_GL_APIENTRY void null_GetRenderbufferParameteriv(GLenum target, GLenum pname, GLint * params)
+{
+    record_call(GLNULL_GetRenderbufferParameteriv);
+}
+
+static NGLI_GL_APIENTRY void null_GetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * infoLog)
+{
+    record_call(GLNULL_GetShaderInfoLog);
+}
+
+static NGLI_GL_APIENTRY void null_GetShaderSource(GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * source)
+{
+    record_call(GLNULL_GetShaderSource);
+}
+
+static NGLI_GL_APIENTRY void null_GetShaderiv(GLuint shader, GLenum pname, GLint * params)
+{
+    record_call(GLNULL_GetShaderiv);
+}
+
+static NGLI_GL_APIENTRY const GLubyte * null_GetString(GLenum name)
+{
+    record_call(GLNULL_GetString);
+    return 0;
+}
+
+static NGLI_GL_APIENTRY const GLubyte * null_GetStringi(GLenum name, GLuint index)
+{
+    record_call(GLNULL_GetStringi);
+    return 0;
+}
+
+static NGLI_GL_APIENTRY GLint null_GetUniformLocation(GLuint program, const GLchar * name)
+{
+    record_call(GLNULL_GetUniformLocation);
+    return 0;
+}
+
+static NGLI_GL_APIENTRY void null_LinkProgram(GLuint program)
+{
+    record_call(GLNULL_LinkProgram);
+}
+
+static NGLI_GL_APIENTRY void * null_MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    record_call(GLNULL_MapBufferRange);
+    return 0;
+}
+
+static NGLI_GL_APIENTRY void null_MaxShaderCompilerThreadsKHR(GLuint count)
+{
+    record_call(GLNULL_MaxShaderCompilerThreadsKHR);
+}
+
+static NGLI_GL_APIENTRY void null_ProgramBinary(GLuint program, GLenum binaryFormat, const void * binary, GLsizei length)
+{
+    record_call(GLNULL_ProgramBinary);
+}
+
+static NGLI_GL_APIENTRY void null_ProgramParameteri(GLuint program, GLenum pname, GLint value)
+{
+    record_call(GLNULL_ProgramParameteri);
+}
+
+static NGLI_GL_APIENTRY void null_QueryCounter(GLuint id, GLenum target)
+{
+    record_call(GLNULL_QueryCounter);
+}
+
+static NGLI_GL_APIENTRY void null_ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void * pixels)
+{
+    record_call(GLNULL_ReadPixels);
+}
+
+static NGLI_GL_APIENTRY void null_ReleaseShaderCompiler()
+{
+    record_call(GLNULL_ReleaseShaderCompiler);
+}
+
+static NGLI_GL_APIENTRY void null_RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    record_call(GLNULL_RenderbufferStorage);
+}
+
+static NGLI_GL_APIENTRY void null_ShaderBinary(GLsizei count, const GLuint * shaders, GLenum binaryformat, const void * binary, GLsizei length)
+{
+    record_call(GLNULL_ShaderBinary);
+}
+
+static NGLI_GL_APIENTRY void null_ShaderSource(GLuint shader, GLsizei count, const GLchar *const* string, const GLint * length)
+{
+    record_call(GLNULL_ShaderSource);
+}
+
+static NGLI_GL_APIENTRY void null_StencilFunc(GLenum func, GLint ref, GLuint mask)
+{
+    record_call(GLNULL_StencilFunc);
+}
+
+static NGLI_GL_APIENTRY void null_StencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask)
+{
+    record_call(GLNULL_StencilFuncSeparate);
+}
+
+static NGLI_GL_APIENTRY void null_StencilMask(GLuint mask)
+{
+    record_call(GLNULL_StencilMask);
+}
+
+static NGLI_GL_APIENTRY void null_StencilMaskSeparate(GLenum face, GLuint mask)
+{
+    record_call(GLNULL_StencilMaskSeparate);
+}
+
+static NGLI_GL_APIENTRY void null_StencilOp(GLenum fail, GLenum zfail, GLenum zpass)
+{
+    record_call(GLNULL_StencilOp);
+}
+
+static NGLI_GL_APIENTRY void null_StencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass)
+{
+    record_call(GLNULL_StencilOpSeparate);
+}
+
+static NGLI_GL_APIENTRY void null_TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void * pixels)
+{
+    record_call(GLNULL_TexImage2D);
+}
+
+static NGLI_GL_APIENTRY void null_TexParameteri(GLenum target, GLenum pname, GLint param)
+{
+    record_call(GLNULL_TexParameteri);
+}
+
+static NGLI_GL_APIENTRY void null_TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void * pixels)
+{
+    record_call(GLNULL_TexSubImage2D);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform1f(GLint location, GLfloat v0)
+{
+    record_call(GLNULL_Uniform1f);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform1fv(GLint location, GLsizei count, const GLfloat * value)
+{
+    record_call(GLNULL_Uniform1fv);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform1i(GLint location, GLint v0)
+{
+    record_call(GLNULL_Uniform1i);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform1iv(GLint location, GLsizei count, const GLint * value)
+{
+    record_call(GLNULL_Uniform1iv);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform2f(GLint location, GLfloat v0, GLfloat v1)
+{
+    record_call(GLNULL_Uniform2f);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform2fv(GLint location, GLsizei count, const GLfloat * value)
+{
+    record_call(GLNULL_Uniform2fv);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform2i(GLint location, GLint v0, GLint v1)
+{
+    record_call(GLNULL_Uniform2i);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform2iv(GLint location, GLsizei count, const GLint * value)
+{
+    record_call(GLNULL_Uniform2iv);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+{
+    record_call(GLNULL_Uniform3f);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform3fv(GLint location, GLsizei count, const GLfloat * value)
+{
+    record_call(GLNULL_Uniform3fv);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform3i(GLint location, GLint v0, GLint v1, GLint v2)
+{
+    record_call(GLNULL_Uniform3i);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform3iv(GLint location, GLsizei count, const GLint * value)
+{
+    record_call(GLNULL_Uniform3iv);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{
+    record_call(GLNULL_Uniform4f);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform4fv(GLint location, GLsizei count, const GLfloat * value)
+{
+    record_call(GLNULL_Uniform4fv);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3)
+{
+    record_call(GLNULL_Uniform4i);
+}
+
+static NGLI_GL_APIENTRY void null_Uniform4iv(GLint location, GLsizei count, const GLint * value)
+{
+    record_call(GLNULL_Uniform4iv);
+}
+
+static NGLI_GL_APIENTRY void null_UniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat * value)
+{
+    record_call(GLNULL_UniformMatrix2fv);
+}
+
+static NGLI_GL_APIENTRY void null_UniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat * value)
+{
+    record_call(GLNULL_UniformMatrix3fv);
+}
+
+static NGLI_GL_APIENTRY void null_UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat * value)
+{
+    record_call(GLNULL_UniformMatrix4fv);
+}
+
+static NGLI_GL_APIENTRY GLboolean null_UnmapBuffer(GLenum target)
+{
+    record_call(GLNULL_UnmapBuffer);
+    return 0;
+}
+
+static NGLI_GL_APIENTRY void null_UseProgram(GLuint program)
+{
+    record_call(GLNULL_UseProgram);
+}
+
+static NGLI_GL_APIENTRY void null_VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer)
+{
+    record_call(GLNULL_VertexAttribPointer);
+}
+
+static NGLI_GL_APIENTRY void null_Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    record_call(GLNULL_Viewport);
+}
+
+static NGLI_GL_APIENTRY void null_WaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+    record_call(GLNULL_WaitSync);
+}
+
+static const struct glnull_function {
+    const char *name;
+    void *func;
+} glnull_functions[] = {
+    [GLNULL_ActiveTexture] = {"glActiveTexture", null_ActiveTexture},
+    [GLNULL_AttachShader] = {"glAttachShader", null_AttachShader},
+    [GLNULL_BindAttribLocation] = {"glBindAttribLocation", null_BindAttribLocation},
+    [GLNULL_BindBuffer] = {"glBindBuffer", null_BindBuffer},
+    [GLNULL_BindFramebuffer] = {"glBindFramebuffer", null_BindFramebuffer},
+    [GLNULL_BindRenderbuffer] = {"glBindRenderbuffer", null_BindRenderbuffer},
+    [GLNULL_BindTexture] = {"glBindTexture", null_BindTexture},
+    [GLNULL_BindVertexArray] = {"glBindVertexArray", null_BindVertexArray},
+    [GLNULL_BlendColor] = {"glBlendColor", null_BlendColor},
+    [GLNULL_BlendEquation] = {"glBlendEquation", null_BlendEquation},
+    [GLNULL_BlendEquationSeparate] = {"glBlendEquationSeparate", null_BlendEquationSeparate},
+    [GLNULL_BlendFunc] = {"glBlendFunc", null_BlendFunc},
+    [GLNULL_BlendFuncSeparate] = {"glBlendFuncSeparate", null_BlendFuncSeparate},
+    [GLNULL_BlitFramebuffer] = {"glBlitFramebuffer", null_BlitFramebuffer},
+    [GLNULL_BufferData] = {"glBufferData", null_BufferData},
+    [GLNULL_BufferSubData] = {"glBufferSubData", null_BufferSubData},
+    [GLNULL_CheckFramebufferStatus] = {"glCheckFramebufferStatus", null_CheckFramebufferStatus},
+    [GLNULL_Clear] = {"glClear", null_Clear},
+    [GLNULL_ClearColor] = {"glClearColor", null_ClearColor},
+    [GLNULL_ColorMask] = {"glColorMask", null_ColorMask},
+    [GLNULL_CompileShader] = {"glCompileShader", null_CompileShader},
+    [GLNULL_CreateProgram] = {"glCreateProgram", null_CreateProgram},
+    [GLNULL_CreateShader] = {"glCreateShader", null_CreateShader},
+    [GLNULL_DeleteBuffers] = {"glDeleteBuffers", null_DeleteBuffers},
+    [GLNULL_DeleteFramebuffers] = {"glDeleteFramebuffers", null_DeleteFramebuffers},
+    [GLNULL_DeleteProgram] = {"glDeleteProgram", null_DeleteProgram},
+    [GLNULL_DeleteQueries] = {"glDeleteQueries", null_DeleteQueries},
+    [GLNULL_DeleteRenderbuffers] = {"glDeleteRenderbuffers", null_DeleteRenderbuffers},
+    [GLNULL_DeleteShader] = {"glDeleteShader", null_DeleteShader},
+    [GLNULL_DeleteSync] = {"glDeleteSync", null_DeleteSync},
+    [GLNULL_DeleteTextures] = {"glDeleteTextures", null_DeleteTextures},
+    [GLNULL_DeleteVertexArrays] = {"glDeleteVertexArrays", null_DeleteVertexArrays},
+    [GLNULL_DetachShader] = {"glDetachShader", null_DetachShader},
+    [GLNULL_Disable] = {"glDisable", null_Disable},
+    [GLNULL_DrawArrays] = {"glDrawArrays", null_DrawArrays},
+    [GLNULL_DrawElements] = {"glDrawElements", null_DrawElements},
+    [GLNULL_Enable] = {"glEnable", null_Enable},
+    [GLNULL_EnableVertexAttribArray] = {"glEnableVertexAttribArray", null_EnableVertexAttribArray},
+    [GLNULL_FenceSync] = {"glFenceSync", null_FenceSync},
+    [GLNULL_Finish] = {"glFinish", null_Finish},
+    [GLNULL_Flush] = {"glFlush", null_Flush},
+    [GLNULL_FramebufferRenderbuffer] = {"glFramebufferRenderbuffer", null_FramebufferRenderbuffer},
+    [GLNULL_FramebufferTexture2D] = {"glFramebufferTexture2D", null_FramebufferTexture2D},
+    [GLNULL_GenBuffers] = {"glGenBuffers", null_GenBuffers},
+    [GLNULL_GenFramebuffers] = {"glGenFramebuffers", null_GenFramebuffers},
+    [GLNULL_GenQueries] = {"glGenQueries", null_GenQueries},
+    [GLNULL_GenRenderbuffers] = {"glGenRenderbuffers", null_GenRenderbuffers},
+    [GLNULL_GenTextures] = {"glGenTextures", null_GenTextures},
+    [GLNULL_GenVertexArrays] = {"glGenVertexArrays", null_GenVertexArrays},
+    [GLNULL_GenerateMipmap] = {"glGenerateMipmap", null_GenerateMipmap},
+    [GLNULL_GetAttachedShaders] = {"glGetAttachedShaders", null_GetAttachedShaders},
+    [GLNULL_GetAttribLocation] = {"glGetAttribLocation", null_GetAttribLocation},
+    [GLNULL_GetBooleanv] = {"glGetBooleanv", null_GetBooleanv},
+    [GLNULL_GetError] = {"glGetError", null_GetError},
+    [GLNULL_GetIntegerv] = {"glGetIntegerv", null_GetIntegerv},
+    [GLNULL_GetProgramBinary] = {"glGetProgramBinary", null_GetProgramBinary},
+    [GLNULL_GetProgramInfoLog] = {"glGetProgramInfoLog", null_GetProgramInfoLog},
+    [GLNULL_GetProgramiv] = {"glGetProgramiv", null_GetProgramiv},
+    [GLNULL_GetQueryObjectui64v] = {"glGetQueryObjectui64v", null_GetQueryObjectui64v},
+    [GLNULL_GetQueryObjectuiv] = {"glGetQueryObjectuiv", null_GetQueryObjectuiv},
+    [GLNULL_GetRenderbufferParameteriv] = {"glGetRenderbufferParameteriv", null_GetRenderbufferParameteriv},
+    [GLNULL_GetShaderInfoLog] = {"glGetShaderInfoLog", null_GetShaderInfoLog},
+    [GLNULL_GetShaderSource] = {"glGetShaderSource", null_GetShaderSource},
+    [GLNULL_GetShaderiv] = {"glGetShaderiv", null_GetShaderiv},
+    [GLNULL_GetString] = {"glGetString", null_GetString},
+    [GLNULL_GetStringi] = {"glGetStringi", null_GetStringi},
+    [GLNULL_GetUniformLocation] = {"glGetUniformLocation", null_GetUniformLocation},
+    [GLNULL_LinkProgram] = {"glLinkProgram", null_LinkProgram},
+    [GLNULL_MapBufferRange] = {"glMapBufferRange", null_MapBufferRange},
+    [GLNULL_MaxShaderCompilerThreadsKHR] = {"glMaxShaderCompilerThreadsKHR", null_MaxShaderCompilerThreadsKHR},
+    [GLNULL_ProgramBinary] = {"glProgramBinary", null_ProgramBinary},
+    [GLNULL_ProgramParameteri] = {"glProgramParameteri", null_ProgramParameteri},
+    [GLNULL_QueryCounter] = {"glQueryCounter", null_QueryCounter},
+    [GLNULL_ReadPixels] = {"glReadPixels", null_ReadPixels},
+    [GLNULL_ReleaseShaderCompiler] = {"glReleaseShaderCompiler", null_ReleaseShaderCompiler},
+    [GLNULL_RenderbufferStorage] = {"glRenderbufferStorage", null_RenderbufferStorage},
+    [GLNULL_ShaderBinary] = {"glShaderBinary", null_ShaderBinary},
+    [GLNULL_ShaderSource] = {"glShaderSource", null_ShaderSource},
+    [GLNULL_StencilFunc] = {"glStencilFunc", null_StencilFunc},
+    [GLNULL_StencilFuncSeparate] = {"glStencilFuncSeparate", null_StencilFuncSeparate},
+    [GLNULL_StencilMask] = {"glStencilMask", null_StencilMask},
+    [GLNULL_StencilMaskSeparate] = {"glStencilMaskSeparate", null_StencilMaskSeparate},
+    [GLNULL_StencilOp] = {"glStencilOp", null_StencilOp},
+    [GLNULL_StencilOpSeparate] = {"glStencilOpSeparate", null_StencilOpSeparate},
+    [GLNULL_TexImage2D] = {"glTexImage2D", null_TexImage2D},
+    [GLNULL_TexParameteri] = {"glTexParameteri", null_TexParameteri},
+    [GLNULL_TexSubImage2D] = {"glTexSubImage2D", null_TexSubImage2D},
+    [GLNULL_Uniform1f] = {"glUniform1f", null_Uniform1f},
+    [GLNULL_Uniform1fv] = {"glUniform1fv", null_Uniform1fv},
+    [GLNULL_Uniform1i] = {"glUniform1i", null_Uniform1i},
+    [GLNULL_Uniform1iv] = {"glUniform1iv", null_Uniform1iv},
+    [GLNULL_Uniform2f] = {"glUniform2f", null_Uniform2f},
+    [GLNULL_Uniform2fv] = {"glUniform2fv", null_Uniform2fv},
+    [GLNULL_Uniform2i] = {"glUniform2i", null_Uniform2i},
+    [GLNULL_Uniform2iv] = {"glUniform2iv", null_Uniform2iv},
+    [GLNULL_Uniform3f] = {"glUniform3f", null_Uniform3f},
+    [GLNULL_Uniform3fv] = {"glUniform3fv", null_Uniform3fv},
+    [GLNULL_Uniform3i] = {"glUniform3i", null_Uniform3i},
+    [GLNULL_Uniform3iv] = {"glUniform3iv", null_Uniform3iv},
+    [GLNULL_Uniform4f] = {"glUniform4f", null_Uniform4f},
+    [GLNULL_Uniform4fv] = {"glUniform4fv", null_Uniform4fv},
+    [GLNULL_Uniform4i] = {"glUniform4i", null_Uniform4i},
+    [GLNULL_Uniform4iv] = {"glUniform4iv", null_Uniform4iv},
+    [GLNULL_UniformMatrix2fv] = {"glUniformMatrix2fv", null_UniformMatrix2fv},
+    [GLNULL_UniformMatrix3fv] = {"glUniformMatrix3fv", null_UniformMatrix3fv},
+    [GLNULL_UniformMatrix4fv] = {"glUniformMatrix4fv", null_UniformMatrix4fv},
+    [GLNULL_UnmapBuffer] = {"glUnmapBuffer", null_UnmapBuffer},
+    [GLNULL_UseProgram] = {"glUseProgram", null_UseProgram},
+    [GLNULL_VertexAttribPointer] = {"glVertexAttribPointer", null_VertexAttribPointer},
+    [GLNULL_Viewport] = {"glViewport", null_Viewport},
+    [GLNULL_WaitSync] = {"glWaitSync", null_WaitSync},
+};
@@ -122,6 +122,12 @@ static inline void ngli_glBufferData(const struct glfunctions *gl, GLenum target
     check_error_code(gl, "glBufferData");
 }
 
+static inline void ngli_glBufferSubData(const struct glfunctions *gl, GLenum target, GLintptr offset, GLsizeiptr size, const void * data)
+{
+    gl->BufferSubData(target, offset, size, data);
+    check_error_code(gl, "glBufferSubData");
+}
+
 static inline GLenum ngli_glCheckFramebufferStatus(const struct glfunctions *gl, GLenum target)
 {
     GLenum ret = gl->CheckFramebufferStatus(target);
@@ -185,6 +191,12 @@ static inline void ngli_glDeleteProgram(const struct glfunctions *gl, GLuint pro
     check_error_code(gl, "glDeleteProgram");
 }
 
+static inline void ngli_glDeleteQueries(const struct glfunctions *gl, GLsizei n, const GLuint * ids)
+{
+    gl->DeleteQueries(n, ids);
+    check_error_code(gl, "glDeleteQueries");
+}
+
 static inline void ngli_glDeleteRenderbuffers(const struct glfunctions *gl, GLsizei n, const GLuint * renderbuffers)
 {
     gl->DeleteRenderbuffers(n, renderbuffers);
@@ -197,6 +209,12 @@ static inline void ngli_glDeleteShader(const struct glfunctions *gl, GLuint shad
     check_error_code(gl, "glDeleteShader");
 }
 
+static inline void ngli_glDeleteSync(const struct glfunctions *gl, GLsync sync)
+{
+    gl->DeleteSync(sync);
+    check_error_code(gl, "glDeleteSync");
+}
+
 static inline void ngli_glDeleteTextures(const struct glfunctions *gl, GLsizei n, const GLuint * textures)
 {
     gl->DeleteTextures(n, textures);
@@ -221,6 +239,12 @@ static inline void ngli_glDisable(const struct glfunctions *gl, GLenum cap)
     check_error_code(gl, "glDisable");
 }
 
+static inline void ngli_glDrawArrays(const struct glfunctions *gl, GLenum mode, GLint first, GLsizei count)
+{
+    gl->DrawArrays(mode, first, count);
+    check_error_code(gl, "glDrawArrays");
+}
+
 static inline void ngli_glDrawElements(const struct glfunctions *gl, GLenum mode, GLsizei count, GLenum type, const void * indices)
 {
     gl->DrawElements(mode, count, type, indices);
@@ -239,6 +263,25 @@ static inline void ngli_glEnableVertexAttribArray(const struct glfunctions *gl,
     check_error_code(gl, "glEnableVertexAttribArray");
 }
 
+static inline GLsync ngli_glFenceSync(const struct glfunctions *gl, GLenum condition, GLbitfield flags)
+{
+    GLsync ret = gl->FenceSync(condition, flags);
+    check_error_code(gl, "glFenceSync");
+    return ret;
+}
+
+static inline void ngli_glFinish(const struct glfunctions *gl)
+{
+    gl->Finish();
+    check_error_code(gl, "glFinish");
+}
+
+static inline void ngli_glFlush(const struct glfunctions *gl)
+{
+    gl->Flush();
+    check_error_code(gl, "glFlush");
+}
+
 static inline void ngli_glFramebufferRenderbuffer(const struct glfunctions *gl, GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
 {
     gl->FramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
@@ -263,6 +306,12 @@ static inline void ngli_glGenFramebuffers(const struct glfunctions *gl, GLsizei
     check_error_code(gl, "glGenFramebuffers");
 }
 
+static inline void ngli_glGenQueries(const struct glfunctions *gl, GLsizei n, GLuint * ids)
+{
+    gl->GenQueries(n, ids);
+    check_error_code(gl, "glGenQueries");
+}
+
 static inline void ngli_glGenRenderbuffers(const struct glfunctions *gl, GLsizei n, GLuint * renderbuffers)
 {
     gl->GenRenderbuffers(n, renderbuffers);
@@ -319,6 +368,12 @@ static inline void ngli_glGetIntegerv(const struct glfunctions *gl, GLenum pname
     check_error_code(gl, "glGetIntegerv");
 }
 
+static inline void ngli_glGetProgramBinary(const struct glfunctions *gl, GLuint program, GLsizei bufSize, GLsizei * length, GLenum * binaryFormat, void * binary)
+{
+    gl->GetProgramBinary(program, bufSize, length, binaryFormat, binary);
+    check_error_code(gl, "glGetProgramBinary");
+}
+
 static inline void ngli_glGetProgramInfoLog(const struct glfunctions *gl, GLuint program, GLsizei bufSize, GLsizei * length, GLchar * infoLog)
 {
     gl->GetProgramInfoLog(program, bufSize, length, infoLog);
@@ -331,6 +386,18 @@ static inline void ngli_glGetProgramiv(const struct glfunctions *gl, GLuint prog
     check_error_code(gl, "glGetProgramiv");
 }
 
+static inline void ngli_glGetQueryObjectui64v(const struct glfunctions *gl, GLuint id, GLenum pname, GLuint64 * params)
+{
+    gl->GetQueryObjectui64v(id, pname, params);
+    check_error_code(gl, "glGetQueryObjectui64v");
+}
+
+static inline void ngli_glGetQueryObjectuiv(const struct glfunctions *gl, GLuint id, GLenum pname, GLuint * params)
+{
+    gl->GetQueryObjectuiv(id, pname, params);
+    check_error_code(gl, "glGetQueryObjectuiv");
+}
+
 static inline void ngli_glGetRenderbufferParameteriv(const struct glfunctions *gl, GLenum target, GLenum pname, GLint * params)
 {
     gl->GetRenderbufferParameteriv(target, pname, params);
@@ -382,6 +449,37 @@ static inline void ngli_glLinkProgram(const struct glfunctions *gl, GLuint progr
     check_error_code(gl, "glLinkProgram");
 }
 
+static inline void * ngli_glMapBufferRange(const struct glfunctions *gl, GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    void * ret = gl->MapBufferRange(target, offset, length, access);
+    check_error_code(gl, "glMapBufferRange");
+    return ret;
+}
+
+static inline void ngli_glMaxShaderCompilerThreadsKHR(const struct glfunctions *gl, GLuint count)
+{
+    gl->MaxShaderCompilerThreadsKHR(count);
+    check_error_code(gl, "glMaxShaderCompilerThreadsKHR");
+}
+
+static inline void ngli_glProgramBinary(const struct glfunctions *gl, GLuint program, GLenum binaryFormat, const void * binary, GLsizei length)
+{
+    gl->ProgramBinary(program, binaryFormat, binary, length);
+    check_error_code(gl, "glProgramBinary");
+}
+
+static inline void ngli_glProgramParameteri(const struct glfunctions *gl, GLuint program, GLenum pname, GLint value)
+{
+    gl->ProgramParameteri(program, pname, value);
+    check_error_code(gl, "glProgramParameteri");
+}
+
+static inline void ngli_glQueryCounter(const struct glfunctions *gl, GLuint id, GLenum target)
+{
+    gl->QueryCounter(id, target);
+    check_error_code(gl, "glQueryCounter");
+}
+
 static inline void ngli_glReadPixels(const struct glfunctions *gl, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void * pixels)
 {
     gl->ReadPixels(x, y, width, height, format, type, pixels);
@@ -580,6 +678,13 @@ static inline void ngli_glUniformMatrix4fv(const struct glfunctions *gl, GLint l
     check_error_code(gl, "glUniformMatrix4fv");
 }
 
+static inline GLboolean ngli_glUnmapBuffer(const struct glfunctions *gl, GLenum target)
+{
+    GLboolean ret = gl->UnmapBuffer(target);
+    check_error_code(gl, "glUnmapBuffer");
+    return ret;
+}
+
 static inline void ngli_glUseProgram(const struct glfunctions *gl, GLuint program)
 {
     gl->UseProgram(program);
@@ -598,4 +703,10 @@ static inline void ngli_glViewport(const struct glfunctions *gl, GLint x, GLint
     check_error_code(gl, "glViewport");
 }
 
+static inline void ngli_glWaitSync(const struct glfunctions *gl, GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+    gl->WaitSync(sync, flags, timeout);
+    check_error_code(gl, "glWaitSync");
+}
+
 #endif
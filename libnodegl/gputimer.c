@@ -0,0 +1,113 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "glcontext.h"
+#include "gputimer.h"
+#include "log.h"
+
+static int init_queries(struct gputimer *s, struct glcontext *glcontext)
+{
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if (!glcontext->has_timer_query_compatibility) {
+        LOG(WARNING, "timer queries are not supported by the GL context");
+        s->unsupported = 1;
+        return -1;
+    }
+
+    ngli_glGenQueries(gl, 2 * NGLI_GPUTIMER_NB_QUERIES, &s->queries[0][0]);
+    memset(s->pending, 0, sizeof(s->pending));
+    s->cur = 0;
+    s->glcontext = glcontext;
+    return 0;
+}
+
+/*
+ * Collect the results of the query pairs in flight, from the oldest one.
+ * They complete in order, so the first one not available ends the lookup.
+ */
+static void collect_results(struct gputimer *s)
+{
+    const struct glfunctions *gl = &s->glcontext->funcs;
+
+    for (int i = 0; i < NGLI_GPUTIMER_NB_QUERIES; i++) {
+        const int idx = (s->cur + i) % NGLI_GPUTIMER_NB_QUERIES;
+        if (!s->pending[idx])
+            continue;
+
+        GLuint available = 0;
+        ngli_glGetQueryObjectuiv(gl, s->queries[idx][1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+
+        GLuint64 start, end;
+        ngli_glGetQueryObjectui64v(gl, s->queries[idx][0], GL_QUERY_RESULT, &start);
+        ngli_glGetQueryObjectui64v(gl, s->queries[idx][1], GL_QUERY_RESULT, &end);
+        s->time = end - start;
+        s->pending[idx] = 0;
+    }
+}
+
+int ngli_gputimer_start(struct gputimer *s, struct glcontext *glcontext)
+{
+    s->started = 0;
+
+    if (s->unsupported)
+        return -1;
+
+    if (!s->glcontext) {
+        int ret = init_queries(s, glcontext);
+        if (ret < 0)
+            return ret;
+    }
+
+    collect_results(s);
+
+    if (s->pending[s->cur])
+        return -1;
+
+    ngli_glQueryCounter(&s->glcontext->funcs, s->queries[s->cur][0], GL_TIMESTAMP);
+    s->started = 1;
+    return 0;
+}
+
+void ngli_gputimer_stop(struct gputimer *s)
+{
+    if (!s->started)
+        return;
+
+    ngli_glQueryCounter(&s->glcontext->funcs, s->queries[s->cur][1], GL_TIMESTAMP);
+    s->pending[s->cur] = 1;
+    s->cur = (s->cur + 1) % NGLI_GPUTIMER_NB_QUERIES;
+    s->started = 0;
+}
+
+void ngli_gputimer_reset(struct gputimer *s)
+{
+    if (!s->glcontext)
+        return;
+
+    ngli_glDeleteQueries(&s->glcontext->funcs, 2 * NGLI_GPUTIMER_NB_QUERIES, &s->queries[0][0]);
+    s->glcontext = NULL;
+    s->started = 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef GPUTIMER_H
+#define GPUTIMER_H
+
+#include <stdint.h>
+
+#include "glincludes.h"
+
+struct glcontext;
+
+#define NGLI_GPUTIMER_NB_QUERIES 4
+
+/*
+ * Measure the GPU execution time of the GL commands issued between a start
+ * and a stop, without stalling: the measures are pairs of timestamp queries
+ * whose results are collected once available, usually a few frames later.
+ * When all the query pairs are still in flight, the measure is skipped.
+ */
+struct gputimer {
+    struct glcontext *glcontext; /* set once the queries are created */
+    int unsupported;
+    GLuint queries[NGLI_GPUTIMER_NB_QUERIES][2];
+    int pending[NGLI_GPUTIMER_NB_QUERIES];
+    int cur;
+    int started;
+    int64_t time; /* last measured time in nanoseconds, negative if none */
+};
+
+/* Return 0 if the measure started, -1 if it is skipped or not supported */
+int ngli_gputimer_start(struct gputimer *s, struct glcontext *glcontext);
+void ngli_gputimer_stop(struct gputimer *s);
+
+/* Delete the queries, the measures in flight are lost */
+void ngli_gputimer_reset(struct gputimer *s);
+
+#endif
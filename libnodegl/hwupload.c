@@ -160,11 +160,13 @@ static int upload_common_frame(struct ngl_node *node, struct hwupload_config *co
     s->height                = config->height;
     s->coordinates_matrix[0] = config->xscale;
 
-    ngli_glBindTexture(gl, GL_TEXTURE_2D, s->id);
-    if (dimension_changed)
+    ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, s->id);
+    if (dimension_changed) {
         ngli_glTexImage2D(gl, GL_TEXTURE_2D, 0, s->internal_format, s->width, s->height, 0, s->format, s->type, frame->data);
-    else
+        ngli_texture_set_gpu_memory(node, s->width, s->height);
+    } else
         ngli_glTexSubImage2D(gl, GL_TEXTURE_2D, 0, 0, 0, s->width, s->height, s->format, s->type, frame->data);
+    ngli_texture_count_upload(node, s->width, s->height);
 
     switch(s->min_filter) {
     case GL_NEAREST_MIPMAP_NEAREST:
@@ -174,7 +176,7 @@ static int upload_common_frame(struct ngl_node *node, struct hwupload_config *co
         ngli_glGenerateMipmap(gl, GL_TEXTURE_2D);
         break;
     }
-    ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+    ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, 0);
 
     return 0;
 }
@@ -192,9 +194,10 @@ static int update_texture_dimensions(struct ngl_node *node, struct hwupload_conf
         s->width = config->width;
         s->height = config->height;
 
-        ngli_glBindTexture(gl, GL_TEXTURE_2D, s->id);
+        ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, s->id);
         ngli_glTexImage2D(gl, GL_TEXTURE_2D, 0, s->internal_format, s->width, s->height, 0, s->format, s->type, NULL);
-        ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+        ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, 0);
+        ngli_texture_set_gpu_memory(node, s->width, s->height);
     }
 
     return 0;
@@ -366,11 +369,13 @@ static int upload_vt_frame(struct ngl_node *node, struct hwupload_config *config
     s->height                = config->height;
     s->coordinates_matrix[0] = config->xscale;
 
-    ngli_glBindTexture(gl, GL_TEXTURE_2D, s->id);
-    if (dimension_changed)
+    ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, s->id);
+    if (dimension_changed) {
         ngli_glTexImage2D(gl, GL_TEXTURE_2D, 0, s->internal_format, s->width, s->height, 0, s->format, s->type, data);
-    else
+        ngli_texture_set_gpu_memory(node, s->width, s->height);
+    } else
         ngli_glTexSubImage2D(gl, GL_TEXTURE_2D, 0, 0, 0, s->width, s->height, s->format, s->type, data);
+    ngli_texture_count_upload(node, s->width, s->height);
 
     CVPixelBufferUnlockBaseAddress(cvpixbuf, kCVPixelBufferLock_ReadOnly);
 
@@ -382,7 +387,7 @@ static int upload_vt_frame(struct ngl_node *node, struct hwupload_config *config
         ngli_glGenerateMipmap(gl, GL_TEXTURE_2D);
         break;
     }
-    ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+    ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, 0);
 
     return 0;
 }
@@ -541,13 +546,16 @@ static int upload_vt_frame(struct ngl_node *node, struct hwupload_config *config
             return -1;
         }
 
-        if (s->texture)
+        if (s->texture) {
+            const GLuint id = CVOpenGLESTextureGetName(s->texture);
             CFRelease(s->texture);
+            ngli_glcache_forget_textures(glcontext, 1, &id);
+        }
 
         s->texture = textures[0];
         s->id = CVOpenGLESTextureGetName(s->texture);
 
-        ngli_glBindTexture(gl, GL_TEXTURE_2D, s->id);
+        ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, s->id);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, s->min_filter);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, s->mag_filter);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, s->wrap_s);
@@ -560,7 +568,7 @@ static int upload_vt_frame(struct ngl_node *node, struct hwupload_config *config
             ngli_glGenerateMipmap(gl, GL_TEXTURE_2D);
             break;
         }
-        ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+        ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, 0);
         break;
     }
     case HWUPLOAD_FMT_VIDEOTOOLBOX_NV12: {
@@ -621,24 +629,28 @@ static int upload_vt_frame(struct ngl_node *node, struct hwupload_config *config
             struct texture *t = s->textures[i]->priv_data;
 
             t->id = t->external_id = CVOpenGLESTextureGetName(textures[i]);
-            ngli_glBindTexture(gl, GL_TEXTURE_2D, t->id);
+            ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, t->id);
             ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, t->min_filter);
             ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, t->mag_filter);
             ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, t->wrap_s);
             ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, t->wrap_t);
-            ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+            ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, 0);
         }
 
         ngli_node_update(s->rtt, 0.0);
         ngli_node_draw(s->rtt);
 
-        CFRelease(textures[0]);
-        CFRelease(textures[1]);
+        GLuint texture_ids[2];
+        for (int i = 0; i < 2; i++) {
+            texture_ids[i] = CVOpenGLESTextureGetName(textures[i]);
+            CFRelease(textures[i]);
+        }
+        ngli_glcache_forget_textures(glcontext, 2, texture_ids);
 
         struct texture *t = s->target_texture->priv_data;
         memcpy(s->coordinates_matrix, t->coordinates_matrix, sizeof(s->coordinates_matrix));
 
-        ngli_glBindTexture(gl, GL_TEXTURE_2D, s->id);
+        ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, s->id);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, s->min_filter);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, s->mag_filter);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, s->wrap_s);
@@ -651,7 +663,7 @@ static int upload_vt_frame(struct ngl_node *node, struct hwupload_config *config
             ngli_glGenerateMipmap(gl, GL_TEXTURE_2D);
             break;
         }
-        ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+        ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, 0);
         break;
     }
     }
@@ -740,7 +752,11 @@ void ngli_hwupload_uninit(struct ngl_node *node)
     ngl_node_unrefp(&s->rtt);
 
 #if defined(TARGET_IPHONE)
-    if (s->texture)
+    if (s->texture) {
+        struct ngl_ctx *ctx = node->ctx;
+        const GLuint id = CVOpenGLESTextureGetName(s->texture);
         CFRelease(s->texture);
+        ngli_glcache_forget_textures(ctx->glcontext, 1, &id);
+    }
 #endif
 }
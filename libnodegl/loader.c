@@ -0,0 +1,231 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "glcontext.h"
+#include "loader.h"
+#include "log.h"
+
+struct loader_job {
+    ngli_loader_func func;
+    void *arg;
+    int done;
+    GLsync sync;
+    struct loader_job *next;
+};
+
+struct loader {
+    struct glcontext *glcontext; /* rendering context */
+
+    pthread_t tid;
+    int started;
+
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
+    struct loader_job *head;
+    struct loader_job *tail;
+    int status; /* 0 while starting, 1 once running, -1 on failure */
+    int stop;
+};
+
+static struct loader_job *pop_job(struct loader *loader)
+{
+    pthread_mutex_lock(&loader->lock);
+    while (!loader->stop && !loader->head)
+        pthread_cond_wait(&loader->work_cond, &loader->lock);
+    struct loader_job *job = loader->head;
+    if (job) {
+        loader->head = job->next;
+        if (!loader->head)
+            loader->tail = NULL;
+    }
+    pthread_mutex_unlock(&loader->lock);
+    return job;
+}
+
+static void set_status(struct loader *loader, int status)
+{
+    pthread_mutex_lock(&loader->lock);
+    loader->status = status;
+    pthread_cond_broadcast(&loader->done_cond);
+    pthread_mutex_unlock(&loader->lock);
+}
+
+static void *loader_thread(void *arg)
+{
+    struct loader *loader = arg;
+
+    struct glcontext *glcontext = ngli_glcontext_new_shared(loader->glcontext);
+    if (!glcontext ||
+        ngli_glcontext_make_current(glcontext, 1) < 0 ||
+        ngli_glcontext_load_extensions(glcontext) < 0) {
+        LOG(ERROR, "could not create the loader GL context");
+        ngli_glcontext_freep(&glcontext);
+        set_status(loader, -1);
+        return NULL;
+    }
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    /* The rendering context waits on the fences, it must support them too */
+    const int use_sync = glcontext->has_sync_compatibility &&
+                         loader->glcontext->has_sync_compatibility;
+
+    set_status(loader, 1);
+
+    /* Pending jobs are still executed when stopping since someone waits for them */
+    struct loader_job *job;
+    while ((job = pop_job(loader))) {
+        job->func(glcontext, job->arg);
+
+        /*
+         * The commands of the job must be complete before the rendering
+         * context uses the objects it created. Without sync objects, the
+         * loader has to wait for them itself.
+         */
+        GLsync sync = NULL;
+        if (use_sync) {
+            sync = ngli_glFenceSync(gl, GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            ngli_glFlush(gl);
+        } else {
+            ngli_glFinish(gl);
+        }
+
+        pthread_mutex_lock(&loader->lock);
+        job->sync = sync;
+        job->done = 1;
+        pthread_cond_broadcast(&loader->done_cond);
+        pthread_mutex_unlock(&loader->lock);
+    }
+
+    ngli_glcontext_make_current(glcontext, 0);
+    ngli_glcontext_freep(&glcontext);
+    return NULL;
+}
+
+struct loader *ngli_loader_create(struct glcontext *glcontext)
+{
+    struct loader *loader = calloc(1, sizeof(*loader));
+    if (!loader)
+        return NULL;
+
+    loader->glcontext = glcontext;
+    pthread_mutex_init(&loader->lock, NULL);
+    pthread_cond_init(&loader->work_cond, NULL);
+    pthread_cond_init(&loader->done_cond, NULL);
+
+    if (pthread_create(&loader->tid, NULL, loader_thread, loader)) {
+        LOG(ERROR, "unable to create loader thread");
+        goto fail;
+    }
+    loader->started = 1;
+
+    pthread_mutex_lock(&loader->lock);
+    while (!loader->status)
+        pthread_cond_wait(&loader->done_cond, &loader->lock);
+    const int status = loader->status;
+    pthread_mutex_unlock(&loader->lock);
+
+    if (status < 0)
+        goto fail;
+
+    LOG(DEBUG, "loader thread created");
+    return loader;
+
+fail:
+    ngli_loader_freep(&loader);
+    return NULL;
+}
+
+struct loader_job *ngli_loader_submit(struct loader *loader, ngli_loader_func func, void *arg)
+{
+    struct loader_job *job = calloc(1, sizeof(*job));
+    if (!job)
+        return NULL;
+
+    job->func = func;
+    job->arg = arg;
+
+    pthread_mutex_lock(&loader->lock);
+    if (loader->tail)
+        loader->tail->next = job;
+    else
+        loader->head = job;
+    loader->tail = job;
+    pthread_cond_signal(&loader->work_cond);
+    pthread_mutex_unlock(&loader->lock);
+
+    return job;
+}
+
+int ngli_loader_is_done(struct loader *loader, const struct loader_job *job)
+{
+    pthread_mutex_lock(&loader->lock);
+    const int done = job->done;
+    pthread_mutex_unlock(&loader->lock);
+    return done;
+}
+
+void ngli_loader_wait(struct loader *loader, struct loader_job **jobp)
+{
+    struct loader_job *job = *jobp;
+
+    if (!job)
+        return;
+    *jobp = NULL;
+
+    pthread_mutex_lock(&loader->lock);
+    while (!job->done)
+        pthread_cond_wait(&loader->done_cond, &loader->lock);
+    pthread_mutex_unlock(&loader->lock);
+
+    if (job->sync) {
+        const struct glfunctions *gl = &loader->glcontext->funcs;
+        ngli_glWaitSync(gl, job->sync, 0, GL_TIMEOUT_IGNORED);
+        ngli_glDeleteSync(gl, job->sync);
+    }
+
+    free(job);
+}
+
+void ngli_loader_freep(struct loader **loaderp)
+{
+    struct loader *loader = *loaderp;
+
+    if (!loader)
+        return;
+
+    if (loader->started) {
+        pthread_mutex_lock(&loader->lock);
+        loader->stop = 1;
+        pthread_cond_signal(&loader->work_cond);
+        pthread_mutex_unlock(&loader->lock);
+        pthread_join(loader->tid, NULL);
+    }
+
+    pthread_cond_destroy(&loader->done_cond);
+    pthread_cond_destroy(&loader->work_cond);
+    pthread_mutex_destroy(&loader->lock);
+    free(loader);
+    *loaderp = NULL;
+}
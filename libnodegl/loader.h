@@ -0,0 +1,52 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef LOADER_H
+#define LOADER_H
+
+struct glcontext;
+struct loader;
+struct loader_job;
+
+typedef void (*ngli_loader_func)(struct glcontext *glcontext, void *arg);
+
+/*
+ * Create a thread owning a GL context shared with the specified one. The
+ * jobs are executed in their submission order with the loader context
+ * current.
+ */
+struct loader *ngli_loader_create(struct glcontext *glcontext);
+
+struct loader_job *ngli_loader_submit(struct loader *loader, ngli_loader_func func, void *arg);
+
+/* Check if a job is done without blocking */
+int ngli_loader_is_done(struct loader *loader, const struct loader_job *job);
+
+/*
+ * Wait for a job to complete and free it. When this function returns, the
+ * GL objects created by the job can be used in the rendering context (which
+ * must be current).
+ */
+void ngli_loader_wait(struct loader *loader, struct loader_job **jobp);
+
+void ngli_loader_freep(struct loader **loaderp);
+
+#endif
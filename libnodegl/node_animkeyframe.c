@@ -441,22 +441,10 @@ static int animkeyframe_init(struct ngl_node *node)
     return 0;
 }
 
-static int get_kf_id(struct ngl_node **animkf, int nb_animkf, int start, double t)
-{
-    int ret = -1;
-
-    for (int i = start; i < nb_animkf; i++) {
-        const struct animkeyframe *kf = animkf[i]->priv_data;
-        if (kf->time >= t)
-            break;
-        ret = i;
-    }
-    return ret;
-}
-
 #define MIX(x, y, a) ((x)*(1.-(a)) + (y)*(a))
 
-void ngli_animkf_interpolate(float *dst, struct ngl_node **animkf, int nb_animkf,
+void ngli_animkf_interpolate(float *dst, const struct timeline *tl,
+                             struct ngl_node **animkf, int nb_animkf,
                              int *current_kf, double t)
 {
     const int vec_lens[] = {
@@ -465,9 +453,8 @@ void ngli_animkf_interpolate(float *dst, struct ngl_node **animkf, int nb_animkf
         [NGL_NODE_ANIMKEYFRAMEVEC2] = 2,
     };
     const int class_id = animkf[0]->class->id;
-    int kf_id = get_kf_id(animkf, nb_animkf, *current_kf, t);
-    if (kf_id < 0)
-        kf_id = get_kf_id(animkf, nb_animkf, 0, t);
+    ngli_assert(tl->nb_times == nb_animkf);
+    const int kf_id = ngli_timeline_find(tl, *current_kf, t, 0);
     if (kf_id >= 0 && kf_id < nb_animkf-1) {
         const struct animkeyframe *kf0 = animkf[kf_id  ]->priv_data;
         const struct animkeyframe *kf1 = animkf[kf_id+1]->priv_data;
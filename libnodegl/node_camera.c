@@ -23,7 +23,6 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
-#include <unistd.h>
 
 #include "log.h"
 #include "nodegl.h"
@@ -33,11 +32,11 @@
 
 #define OFFSET(x) offsetof(struct camera, x)
 static const struct node_param camera_params[] = {
-    {"child", PARAM_TYPE_NODE, OFFSET(child), .flags=PARAM_FLAG_CONSTRUCTOR},
-    {"eye", PARAM_TYPE_VEC3,  OFFSET(eye), {.vec={0.0f, 0.0f, 1.0f}}},
-    {"center", PARAM_TYPE_VEC3,  OFFSET(center)},
-    {"up", PARAM_TYPE_VEC3,  OFFSET(up), {.vec={0.0f, 1.0f, 0.0f}}},
-    {"perspective", PARAM_TYPE_VEC4,  OFFSET(perspective)},
+    {"child", PARAM_TYPE_NODE, OFFSET(child), .flags=PARAM_FLAG_CONSTRUCTOR|PARAM_FLAG_DRAW_CHILD},
+    {"eye", PARAM_TYPE_VEC3,  OFFSET(eye), {.vec={0.0f, 0.0f, 1.0f}}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"center", PARAM_TYPE_VEC3,  OFFSET(center), .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"up", PARAM_TYPE_VEC3,  OFFSET(up), {.vec={0.0f, 1.0f, 0.0f}}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"perspective", PARAM_TYPE_VEC4,  OFFSET(perspective), .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
     {"eye_transform", PARAM_TYPE_NODE, OFFSET(eye_transform), .flags=PARAM_FLAG_DOT_DISPLAY_FIELDNAME, .node_types=TRANSFORM_TYPES_LIST},
     {"center_transform", PARAM_TYPE_NODE, OFFSET(center_transform), .flags=PARAM_FLAG_DOT_DISPLAY_FIELDNAME, .node_types=TRANSFORM_TYPES_LIST},
     {"up_transform", PARAM_TYPE_NODE, OFFSET(up_transform), .flags=PARAM_FLAG_DOT_DISPLAY_FIELDNAME, .node_types=TRANSFORM_TYPES_LIST},
@@ -45,69 +44,339 @@ static const struct node_param camera_params[] = {
     {"pipe_fd", PARAM_TYPE_INT, OFFSET(pipe_fd)},
     {"pipe_width", PARAM_TYPE_INT, OFFSET(pipe_width)},
     {"pipe_height", PARAM_TYPE_INT, OFFSET(pipe_height)},
+    {"pipe_format", PARAM_TYPE_STR, OFFSET(pipe_format_str), {.str="rgba"}},
+    {"pipe_colorspace", PARAM_TYPE_STR, OFFSET(pipe_colorspace_str), {.str="bt601"}},
+    {"shm_fd", PARAM_TYPE_INT, OFFSET(shm_fd)},
     {NULL}
 };
 
+static const char * const pipe_formats[] = {
+    [NGL_PIXFMT_RGBA] = "rgba",
+    [NGL_PIXFMT_NV12] = "nv12",
+    [NGL_PIXFMT_I420] = "i420",
+};
+
+/* Luma coefficients (Kr, Kg, Kb) of the supported YUV colorspaces */
+static const struct {
+    const char *str;
+    float luma[3];
+} pipe_colorspaces[] = {
+    {"bt601", {0.299f,  0.587f,  0.114f}},
+    {"bt709", {0.2126f, 0.7152f, 0.0722f}},
+};
+
+static const char * const yuv_vertex_data =
+    "#version 100"                                                          "\n"
+    "attribute vec2 position;"                                              "\n"
+    "void main()"                                                           "\n"
+    "{"                                                                     "\n"
+    "    gl_Position = vec4(position, 0.0, 1.0);"                           "\n"
+    "}";
+
+/*
+ * Every output texel packs 4 consecutive bytes of the limited range YUV
+ * 4:2:0 frame, so the surface read back is (width/4)x(height*3/2) RGBA. The
+ * chroma is sampled in the middle of each 2x2 block of the source texture,
+ * where the linear filtering averages the 4 pixels.
+ */
+static const char * const yuv_fragment_data =
+    "#version 100"                                                          "\n"
+    "#ifdef GL_FRAGMENT_PRECISION_HIGH"                                     "\n"
+    "precision highp float;"                                                "\n"
+    "#else"                                                                 "\n"
+    "precision mediump float;"                                              "\n"
+    "#endif"                                                                "\n"
+    "uniform sampler2D source;"                                             "\n"
+    "uniform vec2 size;"                                                    "\n"
+    "uniform vec3 luma;"                                                    "\n"
+    "uniform int planar;"                                                   "\n"
+    ""                                                                      "\n"
+    "vec3 rgb(float x, float y)"                                            "\n"
+    "{"                                                                     "\n"
+    "    return texture2D(source, vec2(x, y) / size).rgb;"                  "\n"
+    "}"                                                                     "\n"
+    ""                                                                      "\n"
+    "float y(vec3 c)"                                                       "\n"
+    "{"                                                                     "\n"
+    "    return (16.0 + 219.0 * dot(c, luma)) / 255.0;"                     "\n"
+    "}"                                                                     "\n"
+    ""                                                                      "\n"
+    "float u(vec3 c)"                                                       "\n"
+    "{"                                                                     "\n"
+    "    return (128.0 + 112.0 * (c.b - dot(c, luma)) / (1.0 - luma.b)) / 255.0;" "\n"
+    "}"                                                                     "\n"
+    ""                                                                      "\n"
+    "float v(vec3 c)"                                                       "\n"
+    "{"                                                                     "\n"
+    "    return (128.0 + 112.0 * (c.r - dot(c, luma)) / (1.0 - luma.r)) / 255.0;" "\n"
+    "}"                                                                     "\n"
+    ""                                                                      "\n"
+    "void main()"                                                           "\n"
+    "{"                                                                     "\n"
+    "    vec2 pos = floor(gl_FragCoord.xy);"                                "\n"
+    "    float x = pos.x * 4.0;"                                            "\n"
+    "    if (pos.y < size.y) {"                                             "\n"
+    "        float row = pos.y + 0.5;"                                      "\n"
+    "        gl_FragColor = vec4(y(rgb(x + 0.5, row)), y(rgb(x + 1.5, row)),"  "\n"
+    "                            y(rgb(x + 2.5, row)), y(rgb(x + 3.5, row)));" "\n"
+    "        return;"                                                       "\n"
+    "    }"                                                                 "\n"
+    "    float row = pos.y - size.y;"                                       "\n"
+    "    if (planar == 0) {"                                                "\n"
+    "        /* interleaved U and V of 2 chroma samples */"                 "\n"
+    "        vec3 c0 = rgb(x + 1.0, row * 2.0 + 1.0);"                      "\n"
+    "        vec3 c1 = rgb(x + 3.0, row * 2.0 + 1.0);"                      "\n"
+    "        gl_FragColor = vec4(u(c0), v(c0), u(c1), v(c1));"              "\n"
+    "        return;"                                                       "\n"
+    "    }"                                                                 "\n"
+    "    /* each row of the U and V planes holds 2 rows of chroma samples */" "\n"
+    "    float plane_height = size.y / 4.0;"                                "\n"
+    "    float is_v = step(plane_height, row);"                             "\n"
+    "    row -= is_v * plane_height;"                                       "\n"
+    "    float second = step(size.x / 2.0, x);"                             "\n"
+    "    float cx = (x - second * size.x / 2.0) * 2.0 + 1.0;"               "\n"
+    "    float cy = (row * 2.0 + second) * 2.0 + 1.0;"                      "\n"
+    "    vec3 c0 = rgb(cx,       cy);"                                      "\n"
+    "    vec3 c1 = rgb(cx + 2.0, cy);"                                      "\n"
+    "    vec3 c2 = rgb(cx + 4.0, cy);"                                      "\n"
+    "    vec3 c3 = rgb(cx + 6.0, cy);"                                      "\n"
+    "    if (is_v > 0.0)"                                                   "\n"
+    "        gl_FragColor = vec4(v(c0), v(c1), v(c2), v(c3));"              "\n"
+    "    else"                                                              "\n"
+    "        gl_FragColor = vec4(u(c0), u(c1), u(c2), u(c3));"              "\n"
+    "}";
+
+static int parse_pipe_format(struct camera *s)
+{
+    int i;
+    for (i = 0; i < NGLI_ARRAY_NB(pipe_formats); i++)
+        if (!strcmp(pipe_formats[i], s->pipe_format_str))
+            break;
+    if (i == NGLI_ARRAY_NB(pipe_formats)) {
+        LOG(ERROR, "unrecognized pipe format '%s'", s->pipe_format_str);
+        return -1;
+    }
+    s->pipe_format = i;
+
+    for (i = 0; i < NGLI_ARRAY_NB(pipe_colorspaces); i++)
+        if (!strcmp(pipe_colorspaces[i].str, s->pipe_colorspace_str))
+            break;
+    if (i == NGLI_ARRAY_NB(pipe_colorspaces)) {
+        LOG(ERROR, "unrecognized pipe colorspace '%s'", s->pipe_colorspace_str);
+        return -1;
+    }
+    s->pipe_colorspace = i;
+
+    s->pipe_frame_width  = s->pipe_width;
+    s->pipe_frame_height = s->pipe_height;
+    if (s->pipe_format == NGL_PIXFMT_RGBA)
+        return 0;
+
+#if defined(TARGET_DARWIN) || defined(TARGET_LINUX)
+    const int height_align = s->pipe_format == NGL_PIXFMT_I420 ? 4 : 2;
+    const int width_align  = s->pipe_format == NGL_PIXFMT_I420 ? 8 : 4;
+    if (s->pipe_width % width_align || s->pipe_height % height_align) {
+        LOG(ERROR, "pipe dimensions %dx%d must be multiples of %dx%d with the %s format",
+            s->pipe_width, s->pipe_height, width_align, height_align, s->pipe_format_str);
+        return -1;
+    }
+    s->pipe_frame_width  = s->pipe_width / 4;
+    s->pipe_frame_height = s->pipe_height * 3 / 2;
+    return 0;
+#else
+    LOG(ERROR, "pipe format '%s' is not supported on this platform", s->pipe_format_str);
+    return -1;
+#endif
+}
+
+#if defined(TARGET_DARWIN) || defined(TARGET_LINUX)
+static int init_yuv_conversion(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct glcontext *glcontext = ctx->glcontext;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    struct camera *s = node->priv_data;
+
+    s->yuv_program = ngli_programcache_get(ctx, yuv_vertex_data, yuv_fragment_data);
+    if (!s->yuv_program)
+        return -1;
+
+    int ret = ngli_program_finalize(ctx, s->yuv_program);
+    if (ret < 0)
+        return ret;
+
+    s->yuv_position_location_id = ngli_program_get_attrib_location(ctx, s->yuv_program, "position");
+    s->yuv_source_location_id   = ngli_program_get_uniform_location(ctx, s->yuv_program, "source");
+    s->yuv_size_location_id     = ngli_program_get_uniform_location(ctx, s->yuv_program, "size");
+    s->yuv_luma_location_id     = ngli_program_get_uniform_location(ctx, s->yuv_program, "luma");
+    s->yuv_planar_location_id   = ngli_program_get_uniform_location(ctx, s->yuv_program, "planar");
+
+    static const GLfloat vertices[] = {
+        -1.0f, -1.0f,
+         1.0f, -1.0f,
+        -1.0f,  1.0f,
+         1.0f,  1.0f,
+    };
+    ngli_glGenBuffers(gl, 1, &s->yuv_vertices_id);
+    ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s->yuv_vertices_id);
+    ngli_glBufferData(gl, GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+    if (glcontext->has_vao_compatibility) {
+        ngli_glGenVertexArrays(gl, 1, &s->yuv_vao_id);
+        ngli_glcache_bind_vertex_array(glcontext, s->yuv_vao_id);
+        ngli_glEnableVertexAttribArray(gl, s->yuv_position_location_id);
+        ngli_glVertexAttribPointer(gl, s->yuv_position_location_id, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+    }
+
+    ngli_glGenTextures(gl, 1, &s->yuv_texture_id);
+    ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, s->yuv_texture_id);
+    ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    ngli_glTexImage2D(gl, GL_TEXTURE_2D, 0, GL_RGBA, s->pipe_frame_width, s->pipe_frame_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, 0);
+
+    const GLuint framebuffer_id = ngli_glcache_get_framebuffer(glcontext, GL_FRAMEBUFFER);
+
+    ngli_glGenFramebuffers(gl, 1, &s->yuv_framebuffer_id);
+    ngli_glcache_bind_framebuffer(glcontext, GL_FRAMEBUFFER, s->yuv_framebuffer_id);
+    ngli_glFramebufferTexture2D(gl, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, s->yuv_texture_id, 0);
+    ngli_assert(ngli_glCheckFramebufferStatus(gl, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+
+    ngli_glcache_bind_framebuffer(glcontext, GL_FRAMEBUFFER, framebuffer_id);
+
+    return 0;
+}
+
+static void uninit_yuv_conversion(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct glcontext *glcontext = ctx->glcontext;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    struct camera *s = node->priv_data;
+
+    ngli_glcache_delete_framebuffers(glcontext, 1, &s->yuv_framebuffer_id);
+    ngli_glcache_delete_textures(glcontext, 1, &s->yuv_texture_id);
+    if (glcontext->has_vao_compatibility)
+        ngli_glcache_delete_vertex_arrays(glcontext, 1, &s->yuv_vao_id);
+    ngli_glDeleteBuffers(gl, 1, &s->yuv_vertices_id);
+    ngli_programcache_release(ctx, &s->yuv_program);
+
+    s->yuv_framebuffer_id = 0;
+    s->yuv_texture_id = 0;
+    s->yuv_vao_id = 0;
+    s->yuv_vertices_id = 0;
+}
+#endif
+
+static void camera_uninit(struct ngl_node *node);
+
 static int camera_init(struct ngl_node *node)
 {
     struct camera *s = node->priv_data;
+    int ret;
 
-    if (s->pipe_fd) {
-        s->pipe_buf = calloc(4 /* RGBA */, s->pipe_width * s->pipe_height);
-        if (!s->pipe_buf)
-            return -1;
+    if (s->pipe_fd && s->shm_fd) {
+        LOG(ERROR, "pipe_fd and shm_fd can not be set simultaneously");
+        return -1;
+    }
 
-#if defined(TARGET_DARWIN) || defined(TARGET_LINUX)
+    if (s->pipe_fd || s->shm_fd) {
         struct ngl_ctx *ctx = node->ctx;
         struct glcontext *glcontext = ctx->glcontext;
         const struct glfunctions *gl = &glcontext->funcs;
 
+        ret = parse_pipe_format(s);
+        if (ret < 0)
+            return ret;
+
+        const size_t frame_size = 4 /* RGBA */ * s->pipe_frame_width * s->pipe_frame_height;
+
+        if (s->shm_fd) {
+            s->pipe_ring = ngli_framering_open(s->shm_fd, s->pipe_width, s->pipe_height, s->pipe_format);
+            if (!s->pipe_ring)
+                return -1;
+        } else {
+            s->pipe_writer = ngli_framewriter_create(s->pipe_fd, frame_size, NB_PIPE_QUEUED_FRAMES);
+            if (!s->pipe_writer)
+                return -1;
+        }
+
+        if (glcontext->has_pbo_compatibility) {
+            s->nb_pipe_pbos = NB_PIPE_PBOS;
+            ngli_glGenBuffers(gl, s->nb_pipe_pbos, s->pipe_pbo_ids);
+            for (int i = 0; i < s->nb_pipe_pbos; i++) {
+                ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, s->pipe_pbo_ids[i]);
+                ngli_glBufferData(gl, GL_PIXEL_PACK_BUFFER, frame_size, NULL, GL_STREAM_READ);
+            }
+            ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, 0);
+        }
+
+#if defined(TARGET_DARWIN) || defined(TARGET_LINUX)
+        /* The YUV conversion relies on the linear filtering to average the chroma */
+        const GLint filter = s->pipe_format == NGL_PIXFMT_RGBA ? GL_NEAREST : GL_LINEAR;
+
         ngli_glGenTextures(gl, 1, &s->texture_id);
-        ngli_glBindTexture(gl, GL_TEXTURE_2D, s->texture_id);
-        ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, s->texture_id);
+        ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         ngli_glTexImage2D(gl, GL_TEXTURE_2D, 0, GL_RGBA, s->pipe_width, s->pipe_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
-        ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+        ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, 0);
+        size_t textures_size = (size_t)s->pipe_width * s->pipe_height * 4;
+        if (s->pipe_format != NGL_PIXFMT_RGBA)
+            textures_size += frame_size;
+        ngli_node_set_gpu_memory(node, NGLI_GPU_MEMORY_TEXTURES, textures_size);
 
-        GLuint framebuffer_id;
-        ngli_glGetIntegerv(gl, GL_FRAMEBUFFER_BINDING, (GLint *)&framebuffer_id);
+        const GLuint framebuffer_id = ngli_glcache_get_framebuffer(glcontext, GL_FRAMEBUFFER);
 
         ngli_glGenFramebuffers(gl, 1, &s->framebuffer_id);
-        ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, s->framebuffer_id);
+        ngli_glcache_bind_framebuffer(glcontext, GL_FRAMEBUFFER, s->framebuffer_id);
         ngli_glFramebufferTexture2D(gl, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, s->texture_id, 0);
         ngli_assert(ngli_glCheckFramebufferStatus(gl, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
 
-        ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, framebuffer_id);
+        ngli_glcache_bind_framebuffer(glcontext, GL_FRAMEBUFFER, framebuffer_id);
+
+        if (s->pipe_format != NGL_PIXFMT_RGBA) {
+            ret = init_yuv_conversion(node);
+            if (ret < 0)
+                goto fail;
+        }
 #endif
     }
 
     return 0;
+
+#if defined(TARGET_DARWIN) || defined(TARGET_LINUX)
+fail:
+    /*
+     * The init of a node is not undone by the caller and is retried on the
+     * next frames, so everything allocated so far must be released here.
+     */
+    camera_uninit(node);
+    return ret;
+#endif
 }
 
 static void camera_update(struct ngl_node *node, double t)
 {
     struct camera *s = node->priv_data;
-    struct ngl_node *child = s->child;
 
     NGLI_ALIGNED_VEC(eye)    = { 0.0f, 0.0f, 0.0f, 1.0f };
     NGLI_ALIGNED_VEC(center) = { 0.0f, 0.0f, 0.0f, 1.0f };
     NGLI_ALIGNED_VEC(up)     = { 0.0f, 0.0f, 0.0f, 1.0f };
 
-    float perspective[4*4];
-    float view[4*4];
+    NGLI_ALIGNED_MAT(matrix);
 
-    const float *matrix;
-
-#define APPLY_TRANSFORM(what) do {                                          \
-    memcpy(what, s->what, sizeof(s->what));                                 \
-    if (s->what##_transform) {                                              \
-        ngli_node_update(s->what##_transform, t);                           \
-        matrix = ngli_get_last_transformation_matrix(s->what##_transform);  \
-        if (matrix)                                                         \
-            ngli_mat4_mul_vec4(what, matrix, what);                         \
-    }                                                                       \
+#define APPLY_TRANSFORM(what) do {                                              \
+    memcpy(what, s->what, sizeof(s->what));                                     \
+    if (s->what##_transform &&                                                  \
+        ngli_get_last_transformation_matrix(s->what##_transform, matrix) == 0)  \
+        ngli_mat4_mul_vec4(what, matrix, what);                                 \
 } while (0)
 
     APPLY_TRANSFORM(eye);
@@ -115,69 +384,187 @@ static void camera_update(struct ngl_node *node, double t)
     APPLY_TRANSFORM(up);
 
     ngli_mat4_look_at(
-        view,
+        s->view_matrix,
         eye,
         center,
         up
     );
 
-    if (s->pipe_fd)
-        view[5] = -view[5];
+    if (s->pipe_fd || s->shm_fd)
+        s->view_matrix[5] = -s->view_matrix[5];
 
     if (s->nb_fov_animkf)
-        ngli_animkf_interpolate(&s->perspective[0], s->fov_animkf, s->nb_fov_animkf, &s->current_fov_kf, t);
+        ngli_animkf_interpolate(&s->perspective[0], &node->animkf_timeline, s->fov_animkf, s->nb_fov_animkf, &s->current_fov_kf, t);
 
     ngli_mat4_perspective(
-        perspective,
+        s->projection_matrix,
         s->perspective[0],
         s->perspective[1],
         s->perspective[2],
         s->perspective[3]
     );
+}
+
+static uint8_t *get_frame_buffer(struct camera *s)
+{
+    if (s->pipe_ring)
+        return ngli_framering_get_buffer(s->pipe_ring);
+    return ngli_framewriter_get_buffer(s->pipe_writer);
+}
+
+static void queue_frame_buffer(struct camera *s, double t)
+{
+    if (s->pipe_ring)
+        ngli_framering_queue(s->pipe_ring, t);
+    else
+        ngli_framewriter_queue(s->pipe_writer);
+}
+
+static void queue_oldest_pbo(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct glcontext *glcontext = ctx->glcontext;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    struct camera *s = node->priv_data;
+    const size_t frame_size = 4 * s->pipe_frame_width * s->pipe_frame_height;
+    const int index = (s->pipe_pbo_index - s->nb_pipe_pending + s->nb_pipe_pbos) % s->nb_pipe_pbos;
+
+    ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, s->pipe_pbo_ids[index]);
+    const uint8_t *data = ngli_glMapBufferRange(gl, GL_PIXEL_PACK_BUFFER, 0, frame_size, GL_MAP_READ_BIT);
+    if (data) {
+        memcpy(get_frame_buffer(s), data, frame_size);
+        queue_frame_buffer(s, s->pipe_pbo_times[index]);
+        ngli_glUnmapBuffer(gl, GL_PIXEL_PACK_BUFFER);
+    } else {
+        LOG(ERROR, "unable to map the pixel buffer, frame dropped");
+    }
+    ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, 0);
+
+    s->nb_pipe_pending--;
+}
+
+#if defined(TARGET_DARWIN) || defined(TARGET_LINUX)
+static void convert_to_yuv(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct glcontext *glcontext = ctx->glcontext;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    struct camera *s = node->priv_data;
+
+    static const GLenum caps[] = {GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_SCISSOR_TEST, GL_STENCIL_TEST};
+    static const GLboolean color_mask[4] = {GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE};
+    const GLint viewport[4] = {0, 0, s->pipe_frame_width, s->pipe_frame_height};
 
-    memcpy(child->modelview_matrix, view, sizeof(view));
-    memcpy(child->projection_matrix, perspective, sizeof(perspective));
+    int caps_enabled[NGLI_ARRAY_NB(caps)];
+    GLboolean prev_color_mask[4];
+    GLint prev_viewport[4];
 
-    ngli_node_update(child, t);
+    for (int i = 0; i < NGLI_ARRAY_NB(caps); i++) {
+        caps_enabled[i] = ngli_glcache_is_enabled(glcontext, caps[i]);
+        ngli_glcache_set_enabled(glcontext, caps[i], 0);
+    }
+    memcpy(prev_color_mask, ngli_glcache_get_color_mask(glcontext), sizeof(prev_color_mask));
+    memcpy(prev_viewport, ngli_glcache_get_viewport(glcontext), sizeof(prev_viewport));
+
+    ngli_glcache_bind_framebuffer(glcontext, GL_DRAW_FRAMEBUFFER, s->yuv_framebuffer_id);
+    ngli_glcache_set_color_mask(glcontext, color_mask);
+    ngli_glcache_set_viewport(glcontext, viewport);
+
+    ngli_glcache_use_program(glcontext, s->yuv_program->id);
+    ngli_glcache_active_texture(glcontext, GL_TEXTURE0);
+    ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, s->texture_id);
+    ngli_glUniform1i(gl, s->yuv_source_location_id, 0);
+    ngli_glUniform2f(gl, s->yuv_size_location_id, s->pipe_width, s->pipe_height);
+    ngli_glUniform3fv(gl, s->yuv_luma_location_id, 1, pipe_colorspaces[s->pipe_colorspace].luma);
+    ngli_glUniform1i(gl, s->yuv_planar_location_id, s->pipe_format == NGL_PIXFMT_I420);
+
+    if (glcontext->has_vao_compatibility) {
+        ngli_glcache_bind_vertex_array(glcontext, s->yuv_vao_id);
+    } else {
+        ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s->yuv_vertices_id);
+        ngli_glEnableVertexAttribArray(gl, s->yuv_position_location_id);
+        ngli_glVertexAttribPointer(gl, s->yuv_position_location_id, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+    }
+
+    ngli_glDrawArrays(gl, GL_TRIANGLE_STRIP, 0, 4);
+    ctx->counters.draw_calls++;
+
+    ngli_glcache_set_viewport(glcontext, prev_viewport);
+    ngli_glcache_set_color_mask(glcontext, prev_color_mask);
+    for (int i = 0; i < NGLI_ARRAY_NB(caps); i++)
+        ngli_glcache_set_enabled(glcontext, caps[i], caps_enabled[i]);
 }
+#endif
 
 static void camera_draw(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct camera *s = node->priv_data;
+
+    ngli_matrix_stack_push(&ctx->modelview, s->view_matrix);
+    ngli_matrix_stack_push(&ctx->projection, s->projection_matrix);
+}
+
+static void camera_post_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct glcontext *glcontext = ctx->glcontext;
     const struct glfunctions *gl = &glcontext->funcs;
 
     struct camera *s = node->priv_data;
-    ngli_node_draw(s->child);
 
-    if (s->pipe_fd) {
+    ngli_matrix_stack_pop(&ctx->projection);
+    ngli_matrix_stack_pop(&ctx->modelview);
+
+    if (s->pipe_fd || s->shm_fd) {
 #if defined(TARGET_DARWIN) || defined(TARGET_LINUX)
-        GLint multisampling = 0;
         GLuint framebuffer_read_id;
         GLuint framebuffer_draw_id;
 
-        ngli_glGetIntegerv(gl, GL_MULTISAMPLE, &multisampling);
+        const int multisampling = ngli_glcache_is_enabled(glcontext, GL_MULTISAMPLE);
+        const int convert = s->pipe_format != NGL_PIXFMT_RGBA;
+        const int blit = multisampling || convert;
 
-        if (multisampling) {
-            ngli_glGetIntegerv(gl, GL_READ_FRAMEBUFFER_BINDING, (GLint *)&framebuffer_read_id);
-            ngli_glGetIntegerv(gl, GL_DRAW_FRAMEBUFFER_BINDING, (GLint *)&framebuffer_draw_id);
+        if (blit) {
+            framebuffer_read_id = ngli_glcache_get_framebuffer(glcontext, GL_READ_FRAMEBUFFER);
+            framebuffer_draw_id = ngli_glcache_get_framebuffer(glcontext, GL_DRAW_FRAMEBUFFER);
 
-            ngli_glBindFramebuffer(gl, GL_READ_FRAMEBUFFER, framebuffer_draw_id);
-            ngli_glBindFramebuffer(gl, GL_DRAW_FRAMEBUFFER, s->framebuffer_id);
+            ngli_glcache_bind_framebuffer(glcontext, GL_READ_FRAMEBUFFER, framebuffer_draw_id);
+            ngli_glcache_bind_framebuffer(glcontext, GL_DRAW_FRAMEBUFFER, s->framebuffer_id);
             ngli_glBlitFramebuffer(gl, 0, 0, s->pipe_width, s->pipe_height, 0, 0, s->pipe_width, s->pipe_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 
-            ngli_glBindFramebuffer(gl, GL_READ_FRAMEBUFFER, s->framebuffer_id);
+            if (convert) {
+                convert_to_yuv(node);
+                ngli_glcache_bind_framebuffer(glcontext, GL_READ_FRAMEBUFFER, s->yuv_framebuffer_id);
+            } else {
+                ngli_glcache_bind_framebuffer(glcontext, GL_READ_FRAMEBUFFER, s->framebuffer_id);
+            }
         }
 #endif
 
-        LOG(DEBUG, "write %dx%d buffer to FD=%d", s->pipe_width, s->pipe_height, s->pipe_fd);
-        ngli_glReadPixels(gl, 0, 0, s->pipe_width, s->pipe_height, GL_RGBA, GL_UNSIGNED_BYTE, s->pipe_buf);
-        write(s->pipe_fd, s->pipe_buf, s->pipe_width * s->pipe_height * 4);
+        LOG(DEBUG, "write %dx%d %s buffer to FD=%d", s->pipe_width, s->pipe_height, s->pipe_format_str,
+            s->shm_fd ? s->shm_fd : s->pipe_fd);
+        if (s->nb_pipe_pbos) {
+            s->pipe_pbo_times[s->pipe_pbo_index] = node->last_update_time;
+            ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, s->pipe_pbo_ids[s->pipe_pbo_index]);
+            ngli_glReadPixels(gl, 0, 0, s->pipe_frame_width, s->pipe_frame_height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+            ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, 0);
+            s->pipe_pbo_index = (s->pipe_pbo_index + 1) % s->nb_pipe_pbos;
+            s->nb_pipe_pending++;
+            if (s->nb_pipe_pending == s->nb_pipe_pbos)
+                queue_oldest_pbo(node);
+        } else {
+            uint8_t *buf = get_frame_buffer(s);
+            ngli_glReadPixels(gl, 0, 0, s->pipe_frame_width, s->pipe_frame_height, GL_RGBA, GL_UNSIGNED_BYTE, buf);
+            queue_frame_buffer(s, node->last_update_time);
+        }
 
 #if defined(TARGET_DARWIN) || defined(TARGET_LINUX)
-        if (multisampling) {
-            ngli_glBindFramebuffer(gl, GL_READ_FRAMEBUFFER, framebuffer_read_id);
-            ngli_glBindFramebuffer(gl, GL_DRAW_FRAMEBUFFER, framebuffer_draw_id);
+        if (blit) {
+            ngli_glcache_bind_framebuffer(glcontext, GL_READ_FRAMEBUFFER, framebuffer_read_id);
+            ngli_glcache_bind_framebuffer(glcontext, GL_DRAW_FRAMEBUFFER, framebuffer_draw_id);
         }
 #endif
     }
@@ -187,19 +574,42 @@ static void camera_draw(struct ngl_node *node)
 static void camera_uninit(struct ngl_node *node)
 {
     struct camera *s = node->priv_data;
-    if (s->pipe_fd) {
-        free(s->pipe_buf);
-
-#if defined(TARGET_DARWIN) || defined(TARGET_LINUX)
+    if (s->pipe_fd || s->shm_fd) {
         struct ngl_ctx *ctx = node->ctx;
         struct glcontext *glcontext = ctx->glcontext;
         const struct glfunctions *gl = &glcontext->funcs;
 
-        ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, s->framebuffer_id);
-        ngli_glFramebufferTexture2D(gl, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+        if (s->pipe_writer || s->pipe_ring) {
+            while (s->nb_pipe_pending)
+                queue_oldest_pbo(node);
+            ngli_glDeleteBuffers(gl, s->nb_pipe_pbos, s->pipe_pbo_ids);
+            s->nb_pipe_pbos = 0;
+            s->pipe_pbo_index = 0;
+        }
+
+        /*
+         * Releasing the ring signals the end of the stream to the consumer,
+         * which would otherwise wait forever, including after a failed init.
+         */
+        ngli_framewriter_freep(&s->pipe_writer);
+        ngli_framering_freep(&s->pipe_ring);
+
+#if defined(TARGET_DARWIN) || defined(TARGET_LINUX)
+        if (s->yuv_program)
+            uninit_yuv_conversion(node);
+
+        if (s->framebuffer_id) {
+            const GLuint framebuffer_id = ngli_glcache_get_framebuffer(glcontext, GL_FRAMEBUFFER);
+            ngli_glcache_bind_framebuffer(glcontext, GL_FRAMEBUFFER, s->framebuffer_id);
+            ngli_glFramebufferTexture2D(gl, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+            ngli_glcache_bind_framebuffer(glcontext, GL_FRAMEBUFFER, framebuffer_id);
+        }
 
-        ngli_glDeleteRenderbuffers(gl, 1, &s->framebuffer_id);
-        ngli_glDeleteTextures(gl, 1, &s->texture_id);
+        ngli_glcache_delete_framebuffers(glcontext, 1, &s->framebuffer_id);
+        ngli_glcache_delete_textures(glcontext, 1, &s->texture_id);
+        s->framebuffer_id = 0;
+        s->texture_id = 0;
+        ngli_node_set_gpu_memory(node, NGLI_GPU_MEMORY_TEXTURES, 0);
 #endif
     }
 }
@@ -210,6 +620,7 @@ const struct node_class ngli_camera_class = {
     .init      = camera_init,
     .update    = camera_update,
     .draw      = camera_draw,
+    .post_draw = camera_post_draw,
     .uninit    = camera_uninit,
     .priv_size = sizeof(struct camera),
     .params    = camera_params,
@@ -30,7 +30,7 @@
 
 #define OFFSET(x) offsetof(struct fps, x)
 static const struct node_param fps_params[] = {
-    {"child", PARAM_TYPE_NODE, OFFSET(child), .flags=PARAM_FLAG_CONSTRUCTOR},
+    {"child", PARAM_TYPE_NODE, OFFSET(child), .flags=PARAM_FLAG_CONSTRUCTOR|PARAM_FLAG_DRAW_CHILD},
     {"measure_update", PARAM_TYPE_INT, OFFSET(measure_update)},
     {"measure_draw",   PARAM_TYPE_INT, OFFSET(measure_draw)},
     {"create_databuf", PARAM_TYPE_INT, OFFSET(create_databuf)},
@@ -40,7 +40,7 @@ static const struct node_param fps_params[] = {
 #define FONT_H 8
 #define FONT_W 8
 #define DATA_NBCHAR_W 64
-#define DATA_NBCHAR_H 3
+#define DATA_NBCHAR_H 4
 #define DATA_W (DATA_NBCHAR_W * FONT_W)
 #define DATA_H (DATA_NBCHAR_H * FONT_H)
 
@@ -189,7 +189,7 @@ static int fps_init(struct ngl_node *node)
     return 0;
 }
 
-static const char * const ops[] = {"update", "draw", "total"};
+static const char * const ops[] = {"update", "draw", "total", "gpu"};
 
 static void print_report(struct ngl_node *node, int op, const int64_t t)
 {
@@ -220,21 +220,21 @@ static void print_report(struct ngl_node *node, int op, const int64_t t)
     }
 }
 
-static void fps_update(struct ngl_node *node, double t)
+static void fps_pre_update(struct ngl_node *node, double t)
 {
     struct fps *s = node->priv_data;
-    struct ngl_node *child = s->child;
 
-    memcpy(child->modelview_matrix, node->modelview_matrix, sizeof(node->modelview_matrix));
-    memcpy(child->projection_matrix, node->projection_matrix, sizeof(node->projection_matrix));
+    if (s->measure_update)
+        s->update_start = ngli_gettime();
+}
+
+static void fps_update(struct ngl_node *node, double t)
+{
+    struct fps *s = node->priv_data;
 
     if (s->measure_update) {
-        s->update_start = ngli_gettime();
-        ngli_node_update(child, t);
         s->update_end = ngli_gettime();
         print_report(node, 0, s->update_end - s->update_start);
-    } else {
-        ngli_node_update(child, t);
     }
 }
 
@@ -242,20 +242,31 @@ static void fps_draw(struct ngl_node *node)
 {
     struct fps *s = node->priv_data;
 
+    if (s->measure_draw)
+        s->draw_start = ngli_gettime();
+}
+
+static void fps_post_draw(struct ngl_node *node)
+{
+    struct fps *s = node->priv_data;
+
     if (s->measure_draw) {
-        const int64_t draw_start = ngli_gettime();
-        ngli_node_draw(s->child);
         const int64_t draw_end = ngli_gettime();
-        const int64_t tdraw = draw_end - draw_start;
+        const int64_t tdraw = draw_end - s->draw_start;
         print_report(node, 1, tdraw);
 
         if (s->measure_update) {
             const int64_t tupdate = s->update_end - s->update_start;
             print_report(node, 2, tdraw + tupdate);
         }
-    } else {
-        ngli_node_draw(s->child);
     }
+
+    /*
+     * With the measure_gpu parameter set, the draw of this node is timed on
+     * the GPU; the measure of a previous frame is reported once available.
+     */
+    if (node->measure_gpu && node->gputimer.time >= 0)
+        print_report(node, 3, node->gputimer.time / 1000);
 }
 
 static void fps_uninit(struct ngl_node *node)
@@ -268,8 +279,10 @@ const struct node_class ngli_fps_class = {
     .id        = NGL_NODE_FPS,
     .name      = "FPS",
     .init      = fps_init,
+    .pre_update = fps_pre_update,
     .update    = fps_update,
     .draw      = fps_draw,
+    .post_draw = fps_post_draw,
     .uninit    = fps_uninit,
     .priv_size = sizeof(struct fps),
     .params    = fps_params,
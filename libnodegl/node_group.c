@@ -20,8 +20,6 @@
  */
 
 #include <stddef.h>
-#include <stdio.h>
-#include <string.h>
 #include "nodegl.h"
 #include "nodes.h"
 
@@ -32,34 +30,17 @@ struct group {
 
 #define OFFSET(x) offsetof(struct group, x)
 static const struct node_param group_params[] = {
-    {"children", PARAM_TYPE_NODELIST, OFFSET(children)},
+    {"children", PARAM_TYPE_NODELIST, OFFSET(children), .flags=PARAM_FLAG_DRAW_CHILD},
     {NULL}
 };
 
-static void group_update(struct ngl_node *node, double t)
-{
-    struct group *s = node->priv_data;
-
-    for (int i = 0; i < s->nb_children; i++) {
-        struct ngl_node *child = s->children[i];
-        memcpy(child->modelview_matrix, node->modelview_matrix, sizeof(node->modelview_matrix));
-        memcpy(child->projection_matrix, node->projection_matrix, sizeof(node->projection_matrix));
-        ngli_node_update(child, t);
-    }
-}
-
-static void group_draw(struct ngl_node *node)
-{
-    struct group *s = node->priv_data;
-    for (int i = 0; i < s->nb_children; i++)
-        ngli_node_draw(s->children[i]);
-}
-
+/*
+ * The children are updated and drawn from the compiled graph, where their
+ * update can be dispatched to the thread pool.
+ */
 const struct node_class ngli_group_class = {
     .id        = NGL_NODE_GROUP,
     .name      = "Group",
-    .update    = group_update,
-    .draw      = group_draw,
     .priv_size = sizeof(struct group),
     .params    = group_params,
 };
@@ -161,7 +161,7 @@ static void media_update(struct ngl_node *node, double t)
 
     if (s->nb_animkf) {
         float new_t; // FIXME we currently loose double precision
-        ngli_animkf_interpolate(&new_t, s->animkf, s->nb_animkf, &s->current_kf, t);
+        ngli_animkf_interpolate(&new_t, &node->animkf_timeline, s->animkf, s->nb_animkf, &s->current_kf, t);
         t = new_t;
     }
 
@@ -224,6 +224,7 @@ const struct node_class ngli_media_class = {
     .update    = media_update,
     .release   = media_release,
     .uninit    = media_uninit,
+    .async_prefetch = 1,
     .priv_size = sizeof(struct media),
     .params    = media_params,
 };
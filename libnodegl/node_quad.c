@@ -31,12 +31,12 @@
 
 #define OFFSET(x) offsetof(struct shape, x)
 static const struct node_param quad_params[] = {
-    {"corner",    PARAM_TYPE_VEC3, OFFSET(quad_corner),    {.vec={-0.5f, -0.5f}}},
-    {"width",     PARAM_TYPE_VEC3, OFFSET(quad_width),     {.vec={ 1.0f,  0.0f}}},
-    {"height",    PARAM_TYPE_VEC3, OFFSET(quad_height),    {.vec={ 0.0f,  1.0f}}},
-    {"uv_corner", PARAM_TYPE_VEC2, OFFSET(quad_uv_corner), {.vec={0.0f, 0.0f}}},
-    {"uv_width",  PARAM_TYPE_VEC2, OFFSET(quad_uv_width),  {.vec={1.0f, 0.0f}}},
-    {"uv_height", PARAM_TYPE_VEC2, OFFSET(quad_uv_height), {.vec={0.0f, 1.0f}}},
+    {"corner",    PARAM_TYPE_VEC3, OFFSET(quad_corner),    {.vec={-0.5f, -0.5f}}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"width",     PARAM_TYPE_VEC3, OFFSET(quad_width),     {.vec={ 1.0f,  0.0f}}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"height",    PARAM_TYPE_VEC3, OFFSET(quad_height),    {.vec={ 0.0f,  1.0f}}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"uv_corner", PARAM_TYPE_VEC2, OFFSET(quad_uv_corner), {.vec={0.0f, 0.0f}},   .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"uv_width",  PARAM_TYPE_VEC2, OFFSET(quad_uv_width),  {.vec={1.0f, 0.0f}},   .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"uv_height", PARAM_TYPE_VEC2, OFFSET(quad_uv_height), {.vec={0.0f, 1.0f}},   .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
     {NULL}
 };
 
@@ -50,10 +50,8 @@ static const struct node_param quad_params[] = {
 #define UV_W(index) s->quad_uv_width[(index)]
 #define UV_H(index) s->quad_uv_height[(index)]
 
-static int quad_init(struct ngl_node *node)
+static void fill_vertices(struct shape *s)
 {
-    struct shape *s = node->priv_data;
-
     const GLfloat vertices[NB_VERTICES*NGLI_SHAPE_COORDS_NB] = {
         C(0),               C(1),               C(2),
         C(0) + W(0),        C(1) + W(1),        C(2) + W(2),
@@ -72,11 +70,6 @@ static int quad_init(struct ngl_node *node)
     ngli_vec3_cross(normal, s->quad_width, s->quad_height);
     ngli_vec3_norm(normal, normal);
 
-    s->nb_vertices = NB_VERTICES;
-    s->vertices = calloc(1, NGLI_SHAPE_VERTICES_SIZE(s));
-    if (!s->vertices)
-        return -1;
-
     float *dst = s->vertices;
     const float *y = vertices;
     const float *uv = uvs;
@@ -93,6 +86,17 @@ static int quad_init(struct ngl_node *node)
         memcpy(dst, normal, sizeof(normal));
         dst += NGLI_SHAPE_NORMALS_NB;
     }
+}
+
+static int quad_init(struct ngl_node *node)
+{
+    struct shape *s = node->priv_data;
+
+    s->nb_vertices = NB_VERTICES;
+    s->vertices = calloc(1, NGLI_SHAPE_VERTICES_SIZE(s));
+    if (!s->vertices)
+        return -1;
+    fill_vertices(s);
 
     static const GLushort indices[] = { 0, 1, 2, 0, 2, 3 };
     s->nb_indices = NGLI_ARRAY_NB(indices);
@@ -109,21 +113,18 @@ static int quad_init(struct ngl_node *node)
     return 0;
 }
 
-static void quad_uninit(struct ngl_node *node)
+static int quad_live_change(struct ngl_node *node, const struct node_param *par)
 {
-    struct ngl_ctx *ctx = node->ctx;
-    struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
-
     struct shape *s = node->priv_data;
 
-    ngli_glDeleteBuffers(gl, 1, &s->vertices_buffer_id);
-    ngli_glDeleteBuffers(gl, 1, &s->texcoords_buffer_id);
-    ngli_glDeleteBuffers(gl, 1, &s->normals_buffer_id);
-    ngli_glDeleteBuffers(gl, 1, &s->indices_buffer_id);
+    fill_vertices(s);
+    s->vertices_changed = 1;
+    return 0;
+}
 
-    free(s->vertices);
-    free(s->indices);
+static void quad_uninit(struct ngl_node *node)
+{
+    ngli_shape_release_buffers(node);
 }
 
 const struct node_class ngli_quad_class = {
@@ -131,6 +132,7 @@ const struct node_class ngli_quad_class = {
     .name      = "Quad",
     .init      = quad_init,
     .uninit    = quad_uninit,
+    .live_change = quad_live_change,
     .priv_size = sizeof(struct shape),
     .params    = quad_params,
 };
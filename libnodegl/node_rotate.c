@@ -27,47 +27,35 @@
 #include "nodegl.h"
 #include "nodes.h"
 #include "math_utils.h"
+#include "transforms.h"
 
 #define OFFSET(x) offsetof(struct rotate, x)
 static const struct node_param rotate_params[] = {
-    {"child", PARAM_TYPE_NODE, OFFSET(child), .flags=PARAM_FLAG_CONSTRUCTOR},
-    {"angle", PARAM_TYPE_DBL,  OFFSET(angle)},
-    {"axis",  PARAM_TYPE_VEC3, OFFSET(axis), {.vec={0.0, 0.0, 1.0}}},
-    {"anchor", PARAM_TYPE_VEC3, OFFSET(anchor), {.vec={0.0, 0.0, 0.0}}},
+    {"child", PARAM_TYPE_NODE, OFFSET(child), .flags=PARAM_FLAG_CONSTRUCTOR|PARAM_FLAG_DRAW_CHILD},
+    {"angle", PARAM_TYPE_DBL,  OFFSET(angle), .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"axis",  PARAM_TYPE_VEC3, OFFSET(axis), {.vec={0.0, 0.0, 1.0}}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"anchor", PARAM_TYPE_VEC3, OFFSET(anchor), {.vec={0.0, 0.0, 0.0}}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
     {"animkf", PARAM_TYPE_NODELIST, OFFSET(animkf), .flags=PARAM_FLAG_DOT_DISPLAY_PACKED,
                .node_types=(const int[]){NGL_NODE_ANIMKEYFRAMESCALAR, -1}},
     {NULL}
 };
 
-static const float get_angle(struct rotate *s, double t)
+static const float get_angle(struct ngl_node *node, double t)
 {
+    struct rotate *s = node->priv_data;
     float angle = s->angle;
     if (s->nb_animkf)
-        ngli_animkf_interpolate(&angle, s->animkf, s->nb_animkf, &s->current_kf, t);
+        ngli_animkf_interpolate(&angle, &node->animkf_timeline, s->animkf, s->nb_animkf, &s->current_kf, t);
     return angle;
 }
 
 static void rotate_update(struct ngl_node *node, double t)
 {
     struct rotate *s = node->priv_data;
-    struct ngl_node *child = s->child;
-    NGLI_ALIGNED_MAT(trans);
-    const float x = get_angle(s, t) * 2.0f * M_PI / 360.0f;
+    const float x = get_angle(node, t) * 2.0f * M_PI / 360.0f;
     static const float zero_anchor[3] = { 0.0, 0.0, 0.0 };
     int translate = memcmp(s->anchor, zero_anchor, sizeof(s->anchor));
 
-    if (translate) {
-        const NGLI_ALIGNED_MAT(transm) = {
-            1.0f,   0.0f,   0.0f,   0.0f,
-            0.0f,   1.0f,   0.0f,   0.0f,
-            0.0f,   0.0f,   1.0f,   0.0f,
-            s->anchor[0], s->anchor[1], s->anchor[2], 1.0f,
-        };
-        ngli_mat4_mul(trans, node->modelview_matrix, transm);
-    } else {
-        memcpy(trans, node->modelview_matrix, sizeof(node->modelview_matrix));
-    }
-
     if (s->axis[0] == 1) {
         const NGLI_ALIGNED_MAT(rotm) = {
             1.0f,    0.0f,    0.0f, 0.0f,
@@ -75,7 +63,7 @@ static void rotate_update(struct ngl_node *node, double t)
             0.0f, -sin(x),  cos(x), 0.0f,
             0.0f,    0.0f,    0.0f, 1.0f,
         };
-        ngli_mat4_mul(child->modelview_matrix, trans, rotm);
+        memcpy(s->matrix, rotm, sizeof(rotm));
     } else if (s->axis[1] == 1) {
         const NGLI_ALIGNED_MAT(rotm) = {
             cos(x), 0.0f, -sin(x), 0.0f,
@@ -83,7 +71,7 @@ static void rotate_update(struct ngl_node *node, double t)
             sin(x), 0.0f,  cos(x), 0.0f,
               0.0f, 0.0f,    0.0f, 1.0f,
         };
-        ngli_mat4_mul(child->modelview_matrix, trans, rotm);
+        memcpy(s->matrix, rotm, sizeof(rotm));
     } else if (s->axis[2] == 1) {
         const NGLI_ALIGNED_MAT(rotm) = {
             cos(x),  sin(x), 0.0f, 0.0f,
@@ -91,27 +79,41 @@ static void rotate_update(struct ngl_node *node, double t)
               0.0f,    0.0f, 1.0f, 0.0f,
               0.0f,    0.0f, 0.0f, 1.0f,
         };
-        ngli_mat4_mul(child->modelview_matrix, trans, rotm);
+        memcpy(s->matrix, rotm, sizeof(rotm));
+    } else {
+        memset(s->matrix, 0, sizeof(s->matrix));
+        s->matrix[0] = s->matrix[5] = s->matrix[10] = s->matrix[15] = 1.0f;
     }
 
     if (translate) {
         const NGLI_ALIGNED_MAT(transm) = {
+            1.0f,   0.0f,   0.0f,   0.0f,
+            0.0f,   1.0f,   0.0f,   0.0f,
+            0.0f,   0.0f,   1.0f,   0.0f,
+            s->anchor[0], s->anchor[1], s->anchor[2], 1.0f,
+        };
+        const NGLI_ALIGNED_MAT(itransm) = {
             1.0f,   0.0f,   0.0f,   0.0f,
             0.0f,   1.0f,   0.0f,   0.0f,
             0.0f,   0.0f,   1.0f,   0.0f,
             -s->anchor[0], -s->anchor[1], -s->anchor[2], 1.0f,
         };
-        ngli_mat4_mul(child->modelview_matrix, child->modelview_matrix, transm);
+        ngli_mat4_mul(s->matrix, transm, s->matrix);
+        ngli_mat4_mul(s->matrix, s->matrix, itransm);
     }
-
-    memcpy(child->projection_matrix, node->projection_matrix, sizeof(node->projection_matrix));
-    ngli_node_update(child, t);
 }
 
 static void rotate_draw(struct ngl_node *node)
 {
+    struct ngl_ctx *ctx = node->ctx;
     struct rotate *s = node->priv_data;
-    ngli_node_draw(s->child);
+    ngli_matrix_stack_push_mul(&ctx->modelview, s->matrix);
+}
+
+static void rotate_post_draw(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    ngli_matrix_stack_pop(&ctx->modelview);
 }
 
 const struct node_class ngli_rotate_class = {
@@ -119,6 +121,7 @@ const struct node_class ngli_rotate_class = {
     .name      = "Rotate",
     .update    = rotate_update,
     .draw      = rotate_draw,
+    .post_draw = rotate_post_draw,
     .priv_size = sizeof(struct rotate),
     .params    = rotate_params,
 };
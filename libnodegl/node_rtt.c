@@ -21,15 +21,17 @@
 
 #include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "log.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "transforms.h"
 #include "utils.h"
 
 #define OFFSET(x) offsetof(struct rtt, x)
 static const struct node_param rtt_params[] = {
-    {"child",   PARAM_TYPE_NODE, OFFSET(child),   .flags=PARAM_FLAG_CONSTRUCTOR},
+    {"child",   PARAM_TYPE_NODE, OFFSET(child),   .flags=PARAM_FLAG_CONSTRUCTOR|PARAM_FLAG_DRAW_CHILD},
     {"color_texture", PARAM_TYPE_NODE, OFFSET(color_texture), .flags=PARAM_FLAG_CONSTRUCTOR,
                       .node_types=(const int[]){NGL_NODE_TEXTURE, -1}},
     {"depth_texture", PARAM_TYPE_NODE, OFFSET(depth_texture), .flags=PARAM_FLAG_DOT_DISPLAY_FIELDNAME,
@@ -61,11 +63,10 @@ static int rtt_init(struct ngl_node *node)
         ngli_assert(s->width == depth_texture->width && s->height == depth_texture->height);
     }
 
-    GLuint framebuffer_id = 0;
-    ngli_glGetIntegerv(gl, GL_FRAMEBUFFER_BINDING, (GLint *)&framebuffer_id);
+    const GLuint framebuffer_id = ngli_glcache_get_framebuffer(glcontext, GL_FRAMEBUFFER);
 
     ngli_glGenFramebuffers(gl, 1, &s->framebuffer_id);
-    ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, s->framebuffer_id);
+    ngli_glcache_bind_framebuffer(glcontext, GL_FRAMEBUFFER, s->framebuffer_id);
 
     LOG(VERBOSE, "init rtt with texture %d", texture->id);
     ngli_glFramebufferTexture2D(gl, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture->id, 0);
@@ -77,11 +78,12 @@ static int rtt_init(struct ngl_node *node)
         ngli_glBindRenderbuffer(gl, GL_RENDERBUFFER, s->renderbuffer_id);
         ngli_glRenderbufferStorage(gl, GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, s->width, s->height);
         ngli_glBindRenderbuffer(gl, GL_RENDERBUFFER, 0);
+        ngli_node_set_gpu_memory(node, NGLI_GPU_MEMORY_RENDERBUFFERS, (size_t)s->width * s->height * 2);
         ngli_glFramebufferRenderbuffer(gl, GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, s->renderbuffer_id);
     }
 
     ngli_assert(ngli_glCheckFramebufferStatus(gl, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
-    ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, framebuffer_id);
+    ngli_glcache_bind_framebuffer(glcontext, GL_FRAMEBUFFER, framebuffer_id);
 
     /* flip vertically the color and depth textures so the coordinates match
      * how the uv coordinates system works */
@@ -101,36 +103,48 @@ static int rtt_init(struct ngl_node *node)
     return 0;
 }
 
-static void rtt_update(struct ngl_node *node, double t)
-{
-    struct rtt *s = node->priv_data;
-    ngli_node_update(s->child, t);
-    ngli_node_update(s->color_texture, t);
-}
-
 static void rtt_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct glcontext *glcontext = ctx->glcontext;
     const struct glfunctions *gl = &glcontext->funcs;
 
-    GLint viewport[4];
     struct rtt *s = node->priv_data;
 
-    GLuint framebuffer_id = 0;
-    ngli_glGetIntegerv(gl, GL_FRAMEBUFFER_BINDING, (GLint *)&framebuffer_id);
-    ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, s->framebuffer_id);
+    s->prev_framebuffer_id = ngli_glcache_get_framebuffer(glcontext, GL_FRAMEBUFFER);
+    ngli_glcache_bind_framebuffer(glcontext, GL_FRAMEBUFFER, s->framebuffer_id);
 
-    ngli_glGetIntegerv(gl, GL_VIEWPORT, viewport);
-    ngli_glViewport(gl, 0, 0, s->width, s->height);
+    memcpy(s->prev_viewport, ngli_glcache_get_viewport(glcontext), sizeof(s->prev_viewport));
+    const GLint rtt_viewport[4] = {0, 0, s->width, s->height};
+    ngli_glcache_set_viewport(glcontext, rtt_viewport);
     ngli_glClear(gl, GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    ngli_node_draw(s->child);
+    /* The child is rendered independently of the transformations of the RTT */
+    static const NGLI_ALIGNED_MAT(id_matrix) = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f,
+    };
+    ngli_matrix_stack_push(&ctx->modelview, id_matrix);
+    ngli_matrix_stack_push(&ctx->projection, id_matrix);
+}
+
+static void rtt_post_draw(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct glcontext *glcontext = ctx->glcontext;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    struct rtt *s = node->priv_data;
+
+    ngli_matrix_stack_pop(&ctx->projection);
+    ngli_matrix_stack_pop(&ctx->modelview);
 
     ngli_assert(ngli_glCheckFramebufferStatus(gl, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
 
-    ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, framebuffer_id);
-    ngli_glViewport(gl, viewport[0], viewport[1], viewport[2], viewport[3]);
+    ngli_glcache_bind_framebuffer(glcontext, GL_FRAMEBUFFER, s->prev_framebuffer_id);
+    ngli_glcache_set_viewport(glcontext, s->prev_viewport);
 
     struct texture *texture = s->color_texture->priv_data;
     switch(texture->min_filter) {
@@ -138,7 +152,7 @@ static void rtt_draw(struct ngl_node *node)
     case GL_NEAREST_MIPMAP_LINEAR:
     case GL_LINEAR_MIPMAP_NEAREST:
     case GL_LINEAR_MIPMAP_LINEAR:
-        ngli_glBindTexture(gl, GL_TEXTURE_2D, texture->id);
+        ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, texture->id);
         ngli_glGenerateMipmap(gl, GL_TEXTURE_2D);
         break;
     }
@@ -162,23 +176,23 @@ static void rtt_uninit(struct ngl_node *node)
 
     struct rtt *s = node->priv_data;
 
-    GLuint framebuffer_id = 0;
-    ngli_glGetIntegerv(gl, GL_FRAMEBUFFER_BINDING, (GLint *)&framebuffer_id);
-    ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, s->framebuffer_id);
+    const GLuint framebuffer_id = ngli_glcache_get_framebuffer(glcontext, GL_FRAMEBUFFER);
+    ngli_glcache_bind_framebuffer(glcontext, GL_FRAMEBUFFER, s->framebuffer_id);
     ngli_glFramebufferTexture2D(gl, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
     ngli_glFramebufferRenderbuffer(gl, GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, 0);
+    ngli_glcache_bind_framebuffer(glcontext, GL_FRAMEBUFFER, framebuffer_id);
 
     ngli_glDeleteRenderbuffers(gl, 1, &s->renderbuffer_id);
-    ngli_glDeleteFramebuffers(gl, 1, &s->framebuffer_id);
-    ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, framebuffer_id);
+    ngli_node_set_gpu_memory(node, NGLI_GPU_MEMORY_RENDERBUFFERS, 0);
+    ngli_glcache_delete_framebuffers(glcontext, 1, &s->framebuffer_id);
 }
 
 const struct node_class ngli_rtt_class = {
     .id        = NGL_NODE_RTT,
     .name      = "RTT",
     .init      = rtt_init,
-    .update    = rtt_update,
     .draw      = rtt_draw,
+    .post_draw = rtt_post_draw,
     .uninit    = rtt_uninit,
     .priv_size = sizeof(struct rtt),
     .params    = rtt_params,
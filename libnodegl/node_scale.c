@@ -26,44 +26,50 @@
 #include "nodegl.h"
 #include "nodes.h"
 #include "math_utils.h"
+#include "transforms.h"
 
 #define OFFSET(x) offsetof(struct scale, x)
 static const struct node_param scale_params[] = {
-    {"child",   PARAM_TYPE_NODE, OFFSET(child), .flags=PARAM_FLAG_CONSTRUCTOR},
-    {"factors", PARAM_TYPE_VEC3, OFFSET(factors)},
-    {"anchor",  PARAM_TYPE_VEC3, OFFSET(anchor)},
+    {"child",   PARAM_TYPE_NODE, OFFSET(child), .flags=PARAM_FLAG_CONSTRUCTOR|PARAM_FLAG_DRAW_CHILD},
+    {"factors", PARAM_TYPE_VEC3, OFFSET(factors), .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"anchor",  PARAM_TYPE_VEC3, OFFSET(anchor),  .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
     {"animkf",  PARAM_TYPE_NODELIST, OFFSET(animkf), .flags=PARAM_FLAG_DOT_DISPLAY_PACKED,
                 .node_types=(const int[]){NGL_NODE_ANIMKEYFRAMEVEC3, -1}},
     {NULL}
 };
 
-static const float *get_factors(struct scale *s, double t)
+static const float *get_factors(struct ngl_node *node, double t)
 {
+    struct scale *s = node->priv_data;
     if (s->nb_animkf)
-        ngli_animkf_interpolate(s->factors, s->animkf, s->nb_animkf, &s->current_kf, t);
+        ngli_animkf_interpolate(s->factors, &node->animkf_timeline, s->animkf, s->nb_animkf, &s->current_kf, t);
     return s->factors;
 }
 
 static void scale_update(struct ngl_node *node, double t)
 {
     struct scale *s = node->priv_data;
-    struct ngl_node *child = s->child;
-    const float *f = get_factors(s, t);
+    const float *f = get_factors(node, t);
     const NGLI_ALIGNED_MAT(sm) = { // TODO: anchor
         f[0], 0.0f, 0.0f, 0.0f,
         0.0f, f[1], 0.0f, 0.0f,
         0.0f, 0.0f, f[2], 0.0f,
         0.0f, 0.0f, 0.0f, 1.0f,
     };
-    ngli_mat4_mul(child->modelview_matrix, node->modelview_matrix, sm);
-    memcpy(child->projection_matrix, node->projection_matrix, sizeof(node->projection_matrix));
-    ngli_node_update(child, t);
+    memcpy(s->matrix, sm, sizeof(sm));
 }
 
 static void scale_draw(struct ngl_node *node)
 {
+    struct ngl_ctx *ctx = node->ctx;
     struct scale *s = node->priv_data;
-    ngli_node_draw(s->child);
+    ngli_matrix_stack_push_mul(&ctx->modelview, s->matrix);
+}
+
+static void scale_post_draw(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    ngli_matrix_stack_pop(&ctx->modelview);
 }
 
 const struct node_class ngli_scale_class = {
@@ -71,6 +77,7 @@ const struct node_class ngli_scale_class = {
     .name      = "Scale",
     .update    = scale_update,
     .draw      = scale_draw,
+    .post_draw = scale_post_draw,
     .priv_size = sizeof(struct scale),
     .params    = scale_params,
 };
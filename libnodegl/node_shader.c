@@ -22,11 +22,11 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
-#include "bstr.h"
 #include "glincludes.h"
 #include "log.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "programcache.h"
 
 static const char default_fragment_shader_data[] =
     "#version 100"                                                                      "\n"
@@ -69,129 +69,45 @@ static const struct node_param shader_params[] = {
     {NULL}
 };
 
-#define DEFINE_GET_INFO_LOG_FUNCTION(func, name)                                      \
-static void get_##func##_info_log(const struct glfunctions *gl, GLuint id,            \
-                                  char **info_logp, int *info_log_lengthp)            \
-{                                                                                     \
-    ngli_glGet##name##iv(gl, id, GL_INFO_LOG_LENGTH, info_log_lengthp);               \
-    if (!*info_log_lengthp) {                                                         \
-        *info_logp = NULL;                                                            \
-        return;                                                                       \
-    }                                                                                 \
-                                                                                      \
-    *info_logp = malloc(*info_log_lengthp);                                           \
-    if (!*info_logp) {                                                                \
-        *info_log_lengthp = 0;                                                        \
-        return;                                                                       \
-    }                                                                                 \
-                                                                                      \
-    ngli_glGet##name##InfoLog(gl, id, *info_log_lengthp, NULL, *info_logp);           \
-    while (*info_log_lengthp && strchr(" \r\n", (*info_logp)[*info_log_lengthp - 1])) \
-        (*info_logp)[--*info_log_lengthp] = 0;                                        \
-}                                                                                     \
-
-DEFINE_GET_INFO_LOG_FUNCTION(shader, Shader)
-DEFINE_GET_INFO_LOG_FUNCTION(program, Program)
-
-static GLuint load_shader(struct ngl_node *node, const char *vertex_shader_data, const char *fragment_shader_data)
+static int shader_init(struct ngl_node *node)
 {
-    struct ngl_ctx *ctx = node->ctx;
-    struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
-
-    char *info_log = NULL;
-    int info_log_length = 0;
-
-    GLint result = GL_FALSE;
-
-    GLuint program = ngli_glCreateProgram(gl);
-    GLuint vertex_shader = ngli_glCreateShader(gl, GL_VERTEX_SHADER);
-    GLuint fragment_shader = ngli_glCreateShader(gl, GL_FRAGMENT_SHADER);
-
-    ngli_glShaderSource(gl, vertex_shader, 1, &vertex_shader_data, NULL);
-    ngli_glCompileShader(gl, vertex_shader);
-
-    ngli_glGetShaderiv(gl, vertex_shader, GL_COMPILE_STATUS, &result);
-    if (!result) {
-        get_shader_info_log(gl, vertex_shader, &info_log, &info_log_length);
-        goto fail;
-    }
-
-    ngli_glShaderSource(gl, fragment_shader, 1, &fragment_shader_data, NULL);
-    ngli_glCompileShader(gl, fragment_shader);
-
-    ngli_glGetShaderiv(gl, fragment_shader, GL_COMPILE_STATUS, &result);
-    if (!result) {
-        get_shader_info_log(gl, fragment_shader, &info_log, &info_log_length);
-        goto fail;
-    }
-
-    ngli_glAttachShader(gl, program, vertex_shader);
-    ngli_glAttachShader(gl, program, fragment_shader);
-    ngli_glLinkProgram(gl, program);
-
-    ngli_glGetProgramiv(gl, program, GL_LINK_STATUS, &result);
-    if (!result) {
-        get_program_info_log(gl, program, &info_log, &info_log_length);
-        goto fail;
-    }
-
-    ngli_glDeleteShader(gl, vertex_shader);
-    ngli_glDeleteShader(gl, fragment_shader);
-
-    return program;
-
-fail:
-    if (info_log) {
-        LOG(ERROR, "could not compile or link shader: %s", info_log);
-        free(info_log);
-    }
-
-    if (vertex_shader) {
-        ngli_glDeleteShader(gl, vertex_shader);
-    }
-
-    if (fragment_shader) {
-        ngli_glDeleteShader(gl, fragment_shader);
-    }
+    struct shader *s = node->priv_data;
 
-    if (program) {
-        ngli_glDeleteProgram(gl, program);
-    }
+    s->program = ngli_programcache_get(node->ctx, s->vertex_data, s->fragment_data);
+    if (!s->program)
+        return -1;
 
     return 0;
 }
 
-static int shader_init(struct ngl_node *node)
+int ngli_shader_finalize(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
-    struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
-
     struct shader *s = node->priv_data;
 
-    s->program_id = load_shader(node, s->vertex_data, s->fragment_data);
-    if (!s->program_id)
-        return -1;
+    if (s->program_id)
+        return 0;
 
-    s->position_location_id          = ngli_glGetAttribLocation(gl, s->program_id,  "ngl_position");
-    s->normal_location_id            = ngli_glGetAttribLocation(gl, s->program_id,  "ngl_normal");
-    s->modelview_matrix_location_id  = ngli_glGetUniformLocation(gl, s->program_id, "ngl_modelview_matrix");
-    s->projection_matrix_location_id = ngli_glGetUniformLocation(gl, s->program_id, "ngl_projection_matrix");
-    s->normal_matrix_location_id     = ngli_glGetUniformLocation(gl, s->program_id, "ngl_normal_matrix");
+    int ret = ngli_program_finalize(ctx, s->program);
+    if (ret < 0)
+        return ret;
+    s->program_id = s->program->id;
+
+    s->position_location_id          = ngli_program_get_attrib_location(ctx, s->program,  "ngl_position");
+    s->normal_location_id            = ngli_program_get_attrib_location(ctx, s->program,  "ngl_normal");
+    s->modelview_matrix_location_id  = ngli_program_get_uniform_location(ctx, s->program, "ngl_modelview_matrix");
+    s->projection_matrix_location_id = ngli_program_get_uniform_location(ctx, s->program, "ngl_projection_matrix");
+    s->normal_matrix_location_id     = ngli_program_get_uniform_location(ctx, s->program, "ngl_normal_matrix");
 
     return 0;
 }
 
 static void shader_uninit(struct ngl_node *node)
 {
-    struct ngl_ctx *ctx = node->ctx;
-    struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
-
     struct shader *s = node->priv_data;
 
-    ngli_glDeleteProgram(gl, s->program_id);
+    ngli_programcache_release(node->ctx, &s->program);
+    s->program_id = 0;
 }
 
 const struct node_class ngli_shader_class = {
@@ -28,12 +28,6 @@
 #include "nodes.h"
 #include "utils.h"
 
-#define GENERATE_BUFFER(name) do {                                             \
-    ngli_glGenBuffers(gl, 1, &s->name##_buffer_id);                            \
-    ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s->name##_buffer_id);               \
-    ngli_glBufferData(gl, GL_ARRAY_BUFFER, name##_size, name, GL_STATIC_DRAW); \
-} while (0)
-
 void ngli_shape_generate_buffers(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -42,22 +36,65 @@ void ngli_shape_generate_buffers(struct ngl_node *node)
 
     struct shape *s = node->priv_data;
 
-    const GLfloat *vertices  = s->vertices;
-    const GLfloat *texcoords = s->vertices + NGLI_SHAPE_TEXCOORDS_OFFSET;
-    const GLfloat *normals   = s->vertices + NGLI_SHAPE_NORMALS_OFFSET;
-    const GLushort *indices  = s->indices;
+    const size_t vertices_size = NGLI_SHAPE_VERTICES_SIZE(s);
+    const size_t indices_size  = s->nb_indices * sizeof(*s->indices);
 
-    size_t vertices_size  = NGLI_SHAPE_VERTICES_SIZE(s);
-    size_t texcoords_size = vertices_size - NGLI_SHAPE_TEXCOORDS_OFFSET * sizeof(*s->vertices);
-    size_t normals_size   = vertices_size - NGLI_SHAPE_NORMALS_OFFSET * sizeof(*s->vertices);
-    size_t indices_size   = s->nb_indices * sizeof(*s->indices);
+    ngli_glGenBuffers(gl, 1, &s->vertices_buffer_id);
+    ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s->vertices_buffer_id);
+    ngli_glBufferData(gl, GL_ARRAY_BUFFER, vertices_size, s->vertices, GL_STATIC_DRAW);
 
-    GENERATE_BUFFER(vertices);
-    GENERATE_BUFFER(texcoords);
-    GENERATE_BUFFER(normals);
-    GENERATE_BUFFER(indices);
+    ngli_glGenBuffers(gl, 1, &s->indices_buffer_id);
+    ngli_glBindBuffer(gl, GL_ELEMENT_ARRAY_BUFFER, s->indices_buffer_id);
+    ngli_glBufferData(gl, GL_ELEMENT_ARRAY_BUFFER, indices_size, s->indices, GL_STATIC_DRAW);
 
+    ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, 0);
     ngli_glBindBuffer(gl, GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    ngli_node_set_gpu_memory(node, NGLI_GPU_MEMORY_BUFFERS, vertices_size + indices_size);
+    ctx->counters.upload_bytes += vertices_size + indices_size;
+    LOG(DEBUG, "%s buffers: %zu vertices bytes, %zu indices bytes (total: %zu bytes)",
+        node->name, vertices_size, indices_size, ctx->gpu_memory[NGLI_GPU_MEMORY_BUFFERS]);
+}
+
+void ngli_shape_release_buffers(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct glcontext *glcontext = ctx->glcontext;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    struct shape *s = node->priv_data;
+
+    if (s->vertices_buffer_id) {
+        ngli_glDeleteBuffers(gl, 1, &s->vertices_buffer_id);
+        ngli_glDeleteBuffers(gl, 1, &s->indices_buffer_id);
+        s->vertices_buffer_id = s->indices_buffer_id = 0;
+
+        ngli_node_set_gpu_memory(node, NGLI_GPU_MEMORY_BUFFERS, 0);
+    }
+
+    free(s->vertices);
+    free(s->indices);
+    s->vertices = NULL;
+    s->indices = NULL;
+}
+
+/* Upload the vertices changed live (see PARAM_FLAG_ALLOW_LIVE_CHANGE) */
+void ngli_shape_sync_buffers(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct glcontext *glcontext = ctx->glcontext;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    struct shape *s = node->priv_data;
+
+    if (!s->vertices_changed)
+        return;
+
+    ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s->vertices_buffer_id);
+    ngli_glBufferSubData(gl, GL_ARRAY_BUFFER, 0, NGLI_SHAPE_VERTICES_SIZE(s), s->vertices);
+    ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, 0);
+    ctx->counters.upload_bytes += NGLI_SHAPE_VERTICES_SIZE(s);
+    s->vertices_changed = 0;
 }
 
 #define OFFSET(x) offsetof(struct shape, x)
@@ -105,19 +142,7 @@ static int shape_init(struct ngl_node *node)
 
 static void shape_uninit(struct ngl_node *node)
 {
-    struct ngl_ctx *ctx = node->ctx;
-    struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
-
-    struct shape *s = node->priv_data;
-
-    ngli_glDeleteBuffers(gl, 1, &s->vertices_buffer_id);
-    ngli_glDeleteBuffers(gl, 1, &s->texcoords_buffer_id);
-    ngli_glDeleteBuffers(gl, 1, &s->normals_buffer_id);
-    ngli_glDeleteBuffers(gl, 1, &s->indices_buffer_id);
-
-    free(s->vertices);
-    free(s->indices);
+    ngli_shape_release_buffers(node);
 }
 
 const struct node_class ngli_shape_class = {
@@ -39,10 +39,10 @@ static const struct node_param texture_params[] = {
     {"type", PARAM_TYPE_INT, OFFSET(type), {.i64=GL_UNSIGNED_BYTE}},
     {"width", PARAM_TYPE_INT, OFFSET(width), {.i64=0}},
     {"height", PARAM_TYPE_INT, OFFSET(height), {.i64=0}},
-    {"min_filter", PARAM_TYPE_INT, OFFSET(min_filter), {.i64=GL_NEAREST}},
-    {"mag_filter", PARAM_TYPE_INT, OFFSET(mag_filter), {.i64=GL_NEAREST}},
-    {"wrap_s", PARAM_TYPE_INT, OFFSET(wrap_s), {.i64=GL_CLAMP_TO_EDGE}},
-    {"wrap_t", PARAM_TYPE_INT, OFFSET(wrap_t), {.i64=GL_CLAMP_TO_EDGE}},
+    {"min_filter", PARAM_TYPE_INT, OFFSET(min_filter), {.i64=GL_NEAREST}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"mag_filter", PARAM_TYPE_INT, OFFSET(mag_filter), {.i64=GL_NEAREST}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"wrap_s", PARAM_TYPE_INT, OFFSET(wrap_s), {.i64=GL_CLAMP_TO_EDGE}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"wrap_t", PARAM_TYPE_INT, OFFSET(wrap_t), {.i64=GL_CLAMP_TO_EDGE}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
     {"data_src", PARAM_TYPE_NODE, OFFSET(data_src), .node_types=(const int[]){NGL_NODE_MEDIA, NGL_NODE_FPS, -1}},
     {"external_id", PARAM_TYPE_INT, OFFSET(external_id), {.i64=0}},
     {NULL}
@@ -60,15 +60,16 @@ static int texture_init_2D(struct ngl_node *node)
         return 0;
 
     ngli_glGenTextures(gl, 1, &s->id);
-    ngli_glBindTexture(gl, GL_TEXTURE_2D, s->id);
+    ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, s->id);
     ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, s->min_filter);
     ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, s->mag_filter);
     ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, s->wrap_s);
     ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, s->wrap_t);
     if (s->width && s->height) {
         ngli_glTexImage2D(gl, GL_TEXTURE_2D, 0, s->internal_format, s->width, s->height, 0, s->format, s->type, NULL);
+        ngli_texture_set_gpu_memory(node, s->width, s->height);
     }
-    ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+    ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, 0);
 
     s->local_id = s->id;
     s->local_target = GL_TEXTURE_2D;
@@ -76,6 +77,46 @@ static int texture_init_2D(struct ngl_node *node)
     return 0;
 }
 
+static int get_bytes_per_pixel(GLint format, GLint type)
+{
+    int nb_comp = 4;
+    if (format == GL_RED)
+        nb_comp = 1;
+    else if (format == GL_RGB)
+        nb_comp = 3;
+
+    if (type == GL_FLOAT)
+        return nb_comp * 4;
+    if (type == GL_UNSIGNED_SHORT)
+        return nb_comp * 2;
+    return nb_comp;
+}
+
+void ngli_texture_set_gpu_memory(struct ngl_node *node, int width, int height)
+{
+    struct texture *s = node->priv_data;
+
+    size_t size = (size_t)width * height * get_bytes_per_pixel(s->format, s->type);
+
+    switch (s->min_filter) {
+    case GL_NEAREST_MIPMAP_NEAREST:
+    case GL_NEAREST_MIPMAP_LINEAR:
+    case GL_LINEAR_MIPMAP_NEAREST:
+    case GL_LINEAR_MIPMAP_LINEAR:
+        size += size / 3;
+        break;
+    }
+
+    ngli_node_set_gpu_memory(node, NGLI_GPU_MEMORY_TEXTURES, size);
+}
+
+void ngli_texture_count_upload(struct ngl_node *node, int width, int height)
+{
+    struct texture *s = node->priv_data;
+
+    node->ctx->counters.upload_bytes += (int64_t)width * height * get_bytes_per_pixel(s->format, s->type);
+}
+
 static int texture_init(struct ngl_node *node)
 {
     struct texture *s = node->priv_data;
@@ -150,12 +191,14 @@ static void handle_fps_frame(struct ngl_node *node)
     const int height = fps->data_h;
     const uint8_t *data = fps->data_buf;
 
-    ngli_glBindTexture(gl, GL_TEXTURE_2D, s->id);
+    ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, s->id);
     if (s->width == width && s->height == height)
         ngli_glTexSubImage2D(gl, GL_TEXTURE_2D, 0, 0, 0, width, height, s->format, s->type, data);
     else
         ngli_glTexImage2D(gl, GL_TEXTURE_2D, 0, s->internal_format, width, height, 0, s->format, s->type, data);
-    ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+    ngli_glcache_bind_texture(glcontext, GL_TEXTURE_2D, 0);
+    ngli_texture_set_gpu_memory(node, width, height);
+    ngli_texture_count_upload(node, width, height);
 }
 
 static void handle_media_frame(struct ngl_node *node)
@@ -171,15 +214,36 @@ static void handle_media_frame(struct ngl_node *node)
     }
 }
 
+static void update_sampling_params(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct glcontext *glcontext = ctx->glcontext;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    struct texture *s = node->priv_data;
+
+    s->params_changed = 0;
+    if (!s->local_id)
+        return;
+
+    ngli_glcache_bind_texture(glcontext, s->local_target, s->local_id);
+    ngli_glTexParameteri(gl, s->local_target, GL_TEXTURE_MIN_FILTER, s->min_filter);
+    ngli_glTexParameteri(gl, s->local_target, GL_TEXTURE_MAG_FILTER, s->mag_filter);
+    ngli_glTexParameteri(gl, s->local_target, GL_TEXTURE_WRAP_S, s->wrap_s);
+    ngli_glTexParameteri(gl, s->local_target, GL_TEXTURE_WRAP_T, s->wrap_t);
+    ngli_glcache_bind_texture(glcontext, s->local_target, 0);
+}
+
 static void texture_update(struct ngl_node *node, double t)
 {
     struct texture *s = node->priv_data;
 
+    if (s->params_changed)
+        update_sampling_params(node);
+
     if (!s->data_src)
         return;
 
-    ngli_node_update(s->data_src, t);
-
     if (s->data_src->class->id == NGL_NODE_FPS) {
         handle_fps_frame(node);
     } else if (s->data_src->class->id == NGL_NODE_MEDIA) {
@@ -191,14 +255,23 @@ static void texture_uninit(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
 
     struct texture *s = node->priv_data;
 
     ngli_hwupload_uninit(node);
 
-    ngli_glDeleteTextures(gl, 1, &s->local_id);
+    ngli_glcache_delete_textures(glcontext, 1, &s->local_id);
     s->id = s->local_id = 0;
+    ngli_node_set_gpu_memory(node, NGLI_GPU_MEMORY_TEXTURES, 0);
+}
+
+static int texture_live_change(struct ngl_node *node, const struct node_param *par)
+{
+    struct texture *s = node->priv_data;
+
+    /* The parameters may be changed while the GL context is not current */
+    s->params_changed = 1;
+    return 0;
 }
 
 static void texture_release(struct ngl_node *node)
@@ -219,6 +292,7 @@ const struct node_class ngli_texture_class = {
     .update    = texture_update,
     .release   = texture_release,
     .uninit    = texture_uninit,
+    .live_change = texture_live_change,
     .priv_size = sizeof(struct texture),
     .params    = texture_params,
 };
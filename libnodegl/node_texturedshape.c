@@ -29,6 +29,7 @@
 #include "ndict.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "transforms.h"
 #include "utils.h"
 
 #define UNIFORMS_TYPES_LIST (const int[]){NGL_NODE_UNIFORMSCALAR,  \
@@ -56,10 +57,12 @@ static const struct node_param texturedshape_params[] = {
     {NULL}
 };
 
-static inline void bind_texture(const struct glfunctions *gl, GLenum target, GLint uniform_location, GLuint texture_id, int idx)
+static inline void bind_texture(struct glcontext *glcontext, GLenum target, GLint uniform_location, GLuint texture_id, int idx)
 {
-    ngli_glActiveTexture(gl, GL_TEXTURE0 + idx);
-    ngli_glBindTexture(gl, target, texture_id);
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    ngli_glcache_active_texture(glcontext, GL_TEXTURE0 + idx);
+    ngli_glcache_bind_texture(glcontext, target, texture_id);
     ngli_glUniform1i(gl, uniform_location, idx);
 }
 
@@ -101,7 +104,7 @@ static int update_uniforms(struct ngl_node *node)
 
         if (textureshaderinfo->sampler_id >= 0) {
             const int sampler_id = textureshaderinfo->sampler_id;
-            bind_texture(gl, texture->target, sampler_id, texture->id, i);
+            bind_texture(glcontext, texture->target, sampler_id, texture->id, i);
         }
 
         if (textureshaderinfo->coordinates_mvp_id >= 0) {
@@ -116,17 +119,20 @@ static int update_uniforms(struct ngl_node *node)
         i++;
     }
 
+    const float *modelview_matrix  = ngli_matrix_stack_top(&ctx->modelview);
+    const float *projection_matrix = ngli_matrix_stack_top(&ctx->projection);
+
     if (shader->modelview_matrix_location_id >= 0) {
-        ngli_glUniformMatrix4fv(gl, shader->modelview_matrix_location_id, 1, GL_FALSE, node->modelview_matrix);
+        ngli_glUniformMatrix4fv(gl, shader->modelview_matrix_location_id, 1, GL_FALSE, modelview_matrix);
     }
 
     if (shader->projection_matrix_location_id >= 0) {
-        ngli_glUniformMatrix4fv(gl, shader->projection_matrix_location_id, 1, GL_FALSE, node->projection_matrix);
+        ngli_glUniformMatrix4fv(gl, shader->projection_matrix_location_id, 1, GL_FALSE, projection_matrix);
     }
 
     if (shader->normal_matrix_location_id >= 0) {
         float normal_matrix[3*3];
-        ngli_mat3_from_mat4(normal_matrix, node->modelview_matrix);
+        ngli_mat3_from_mat4(normal_matrix, modelview_matrix);
         ngli_mat3_inverse(normal_matrix, normal_matrix);
         ngli_mat3_transpose(normal_matrix, normal_matrix);
         ngli_glUniformMatrix3fv(gl, shader->normal_matrix_location_id, 1, GL_FALSE, normal_matrix);
@@ -145,26 +151,29 @@ static int update_vertex_attribs(struct ngl_node *node)
     struct shape *shape = s->shape->priv_data;
     struct shader *shader = s->shader->priv_data;
 
+    const GLsizei stride = NGLI_SHAPE_VERTICES_STRIDE(shape);
+    const void *texcoords_offset = (void *)(NGLI_SHAPE_TEXCOORDS_OFFSET * sizeof(*shape->vertices));
+    const void *normals_offset   = (void *)(NGLI_SHAPE_NORMALS_OFFSET   * sizeof(*shape->vertices));
+
+    ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, shape->vertices_buffer_id);
+
     int nb_textures = ngli_ndict_count(s->textures);
     for (int i = 0; i < nb_textures; i++)  {
         struct textureshaderinfo *textureshaderinfo = &s->textureshaderinfos[i];
         if (textureshaderinfo->coordinates_id >= 0) {
             ngli_glEnableVertexAttribArray(gl, textureshaderinfo->coordinates_id);
-            ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, shape->texcoords_buffer_id);
-            ngli_glVertexAttribPointer(gl, textureshaderinfo->coordinates_id, 2, GL_FLOAT, GL_FALSE, NGLI_SHAPE_VERTICES_STRIDE(shape), NULL);
+            ngli_glVertexAttribPointer(gl, textureshaderinfo->coordinates_id, 2, GL_FLOAT, GL_FALSE, stride, texcoords_offset);
         }
     }
 
     if (shader->position_location_id >= 0) {
         ngli_glEnableVertexAttribArray(gl, shader->position_location_id);
-        ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, shape->vertices_buffer_id);
-        ngli_glVertexAttribPointer(gl, shader->position_location_id, 3, GL_FLOAT, GL_FALSE, NGLI_SHAPE_VERTICES_STRIDE(shape), NULL);
+        ngli_glVertexAttribPointer(gl, shader->position_location_id, 3, GL_FLOAT, GL_FALSE, stride, NULL);
     }
 
     if (shader->normal_location_id >= 0) {
         ngli_glEnableVertexAttribArray(gl, shader->normal_location_id);
-        ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, shape->normals_buffer_id);
-        ngli_glVertexAttribPointer(gl, shader->normal_location_id, 3, GL_FLOAT, GL_FALSE, NGLI_SHAPE_VERTICES_STRIDE(shape), NULL);
+        ngli_glVertexAttribPointer(gl, shader->normal_location_id, 3, GL_FLOAT, GL_FALSE, stride, normals_offset);
     }
 
     return 0;
@@ -189,6 +198,10 @@ static int texturedshape_init(struct ngl_node *node)
     if (ret < 0)
         return ret;
 
+    ret = ngli_shader_finalize(s->shader);
+    if (ret < 0)
+        return ret;
+
     int nb_uniforms = ngli_ndict_count(s->uniforms);
     s->uniform_ids = calloc(nb_uniforms, sizeof(*s->uniform_ids));
     if (!s->uniform_ids)
@@ -201,7 +214,7 @@ static int texturedshape_init(struct ngl_node *node)
         ret = ngli_node_init(unode);
         if (ret < 0)
             return ret;
-        s->uniform_ids[i] = ngli_glGetUniformLocation(gl, shader->program_id, entry->name);
+        s->uniform_ids[i] = ngli_program_get_uniform_location(ctx, shader->program, entry->name);
         i++;
     }
 
@@ -217,7 +230,7 @@ static int texturedshape_init(struct ngl_node *node)
         ret = ngli_node_init(anode);
         if (ret < 0)
             return ret;
-        s->attribute_ids[i] = ngli_glGetAttribLocation(gl, shader->program_id, entry->name);
+        s->attribute_ids[i] = ngli_program_get_attrib_location(ctx, shader->program, entry->name);
         i++;
     }
 
@@ -245,22 +258,22 @@ static int texturedshape_init(struct ngl_node *node)
             return ret;
 
         snprintf(name, sizeof(name), "%s_sampler", entry->name);
-        s->textureshaderinfos[i].sampler_id = ngli_glGetUniformLocation(gl, shader->program_id, name);
+        s->textureshaderinfos[i].sampler_id = ngli_program_get_uniform_location(ctx, shader->program, name);
 
         snprintf(name, sizeof(name), "%s_coords", entry->name);
-        s->textureshaderinfos[i].coordinates_id = ngli_glGetAttribLocation(gl, shader->program_id, name);
+        s->textureshaderinfos[i].coordinates_id = ngli_program_get_attrib_location(ctx, shader->program, name);
 
         snprintf(name, sizeof(name), "%s_coords_matrix", entry->name);
-        s->textureshaderinfos[i].coordinates_mvp_id = ngli_glGetUniformLocation(gl, shader->program_id, name);
+        s->textureshaderinfos[i].coordinates_mvp_id = ngli_program_get_uniform_location(ctx, shader->program, name);
 
         snprintf(name, sizeof(name), "%s_dimensions", entry->name);
-        s->textureshaderinfos[i].dimensions_id = ngli_glGetUniformLocation(gl, shader->program_id, name);
+        s->textureshaderinfos[i].dimensions_id = ngli_program_get_uniform_location(ctx, shader->program, name);
         i++;
     }
 
     if (glcontext->has_vao_compatibility) {
         ngli_glGenVertexArrays(gl, 1, &s->vao_id);
-        ngli_glBindVertexArray(gl, s->vao_id);
+        ngli_glcache_bind_vertex_array(glcontext, s->vao_id);
         update_vertex_attribs(node);
     }
 
@@ -271,12 +284,11 @@ static void texturedshape_uninit(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
 
     struct texturedshape *s = node->priv_data;
 
     if (glcontext->has_vao_compatibility) {
-        ngli_glDeleteVertexArrays(gl, 1, &s->vao_id);
+        ngli_glcache_delete_vertex_arrays(glcontext, 1, &s->vao_id);
     }
 
     free(s->textureshaderinfos);
@@ -284,26 +296,6 @@ static void texturedshape_uninit(struct ngl_node *node)
     free(s->attribute_ids);
 }
 
-static void texturedshape_update(struct ngl_node *node, double t)
-{
-    struct ndict_entry *entry;
-    struct texturedshape *s = node->priv_data;
-
-    ngli_node_update(s->shape, t);
-
-    entry = NULL;
-    while ((entry = ngli_ndict_get(s->textures, NULL, entry))) {
-        ngli_node_update(entry->node, t);
-    }
-
-    entry = NULL;
-    while ((entry = ngli_ndict_get(s->uniforms, NULL, entry))) {
-        ngli_node_update(entry->node, t);
-    }
-
-    ngli_node_update(s->shader, t);
-}
-
 static void texturedshape_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -314,10 +306,12 @@ static void texturedshape_draw(struct ngl_node *node)
     const struct shader *shader = s->shader->priv_data;
     const struct shape *shape = s->shape->priv_data;
 
-    ngli_glUseProgram(gl, shader->program_id);
+    ngli_shape_sync_buffers(s->shape);
+
+    ngli_glcache_use_program(glcontext, shader->program_id);
 
     if (glcontext->has_vao_compatibility) {
-        ngli_glBindVertexArray(gl, s->vao_id);
+        ngli_glcache_bind_vertex_array(glcontext, s->vao_id);
     }
 
     update_uniforms(node);
@@ -328,6 +322,7 @@ static void texturedshape_draw(struct ngl_node *node)
 
     ngli_glBindBuffer(gl, GL_ELEMENT_ARRAY_BUFFER, shape->indices_buffer_id);
     ngli_glDrawElements(gl, shape->draw_mode, shape->nb_indices, shape->draw_type, 0);
+    ctx->counters.draw_calls++;
 }
 
 const struct node_class ngli_texturedshape_class = {
@@ -335,7 +330,6 @@ const struct node_class ngli_texturedshape_class = {
     .name      = "TexturedShape",
     .init      = texturedshape_init,
     .uninit    = texturedshape_uninit,
-    .update    = texturedshape_update,
     .draw      = texturedshape_draw,
     .priv_size = sizeof(struct texturedshape),
     .params    = texturedshape_params,
@@ -26,43 +26,49 @@
 #include "nodegl.h"
 #include "nodes.h"
 #include "math_utils.h"
+#include "transforms.h"
 
 #define OFFSET(x) offsetof(struct translate, x)
 static const struct node_param translate_params[] = {
-    {"child",  PARAM_TYPE_NODE, OFFSET(child), .flags=PARAM_FLAG_CONSTRUCTOR},
-    {"vector", PARAM_TYPE_VEC3, OFFSET(vector)},
+    {"child",  PARAM_TYPE_NODE, OFFSET(child), .flags=PARAM_FLAG_CONSTRUCTOR|PARAM_FLAG_DRAW_CHILD},
+    {"vector", PARAM_TYPE_VEC3, OFFSET(vector), .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
     {"animkf", PARAM_TYPE_NODELIST, OFFSET(animkf), .flags=PARAM_FLAG_DOT_DISPLAY_PACKED,
                .node_types=(const int[]){NGL_NODE_ANIMKEYFRAMEVEC3, -1}},
     {NULL}
 };
 
-static const float *get_vector(struct translate *s, double t)
+static const float *get_vector(struct ngl_node *node, double t)
 {
+    struct translate *s = node->priv_data;
     if (s->nb_animkf)
-        ngli_animkf_interpolate(s->vector, s->animkf, s->nb_animkf, &s->current_kf, t);
+        ngli_animkf_interpolate(s->vector, &node->animkf_timeline, s->animkf, s->nb_animkf, &s->current_kf, t);
     return s->vector;
 }
 
 static void translate_update(struct ngl_node *node, double t)
 {
     struct translate *s = node->priv_data;
-    struct ngl_node *child = s->child;
-    const float *vec = get_vector(s, t);
+    const float *vec = get_vector(node, t);
     const NGLI_ALIGNED_MAT(tm) = {
         1.0f,   0.0f,   0.0f,   0.0f,
         0.0f,   1.0f,   0.0f,   0.0f,
         0.0f,   0.0f,   1.0f,   0.0f,
         vec[0], vec[1], vec[2], 1.0f,
     };
-    ngli_mat4_mul(child->modelview_matrix, node->modelview_matrix, tm);
-    memcpy(child->projection_matrix, node->projection_matrix, sizeof(node->projection_matrix));
-    ngli_node_update(child, t);
+    memcpy(s->matrix, tm, sizeof(tm));
 }
 
 static void translate_draw(struct ngl_node *node)
 {
+    struct ngl_ctx *ctx = node->ctx;
     struct translate *s = node->priv_data;
-    ngli_node_draw(s->child);
+    ngli_matrix_stack_push_mul(&ctx->modelview, s->matrix);
+}
+
+static void translate_post_draw(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    ngli_matrix_stack_pop(&ctx->modelview);
 }
 
 const struct node_class ngli_translate_class = {
@@ -70,6 +76,7 @@ const struct node_class ngli_translate_class = {
     .name      = "Translate",
     .update    = translate_update,
     .draw      = translate_draw,
+    .post_draw = translate_post_draw,
     .priv_size = sizeof(struct translate),
     .params    = translate_params,
 };
@@ -31,26 +31,19 @@
 
 #define OFFSET(x) offsetof(struct shape, x)
 static const struct node_param triangle_params[] = {
-    {"edge0", PARAM_TYPE_VEC3, OFFSET(triangle_edges[0]), .flags=PARAM_FLAG_CONSTRUCTOR},
-    {"edge1", PARAM_TYPE_VEC3, OFFSET(triangle_edges[3]), .flags=PARAM_FLAG_CONSTRUCTOR},
-    {"edge2", PARAM_TYPE_VEC3, OFFSET(triangle_edges[6]), .flags=PARAM_FLAG_CONSTRUCTOR},
-    {"uv_edge0", PARAM_TYPE_VEC2, OFFSET(triangle_uvs[0]), {.vec={0.0f, 0.0f}}},
-    {"uv_edge1", PARAM_TYPE_VEC2, OFFSET(triangle_uvs[2]), {.vec={0.0f, 1.0f}}},
-    {"uv_edge2", PARAM_TYPE_VEC2, OFFSET(triangle_uvs[4]), {.vec={1.0f, 1.0f}}},
+    {"edge0", PARAM_TYPE_VEC3, OFFSET(triangle_edges[0]), .flags=PARAM_FLAG_CONSTRUCTOR|PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"edge1", PARAM_TYPE_VEC3, OFFSET(triangle_edges[3]), .flags=PARAM_FLAG_CONSTRUCTOR|PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"edge2", PARAM_TYPE_VEC3, OFFSET(triangle_edges[6]), .flags=PARAM_FLAG_CONSTRUCTOR|PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"uv_edge0", PARAM_TYPE_VEC2, OFFSET(triangle_uvs[0]), {.vec={0.0f, 0.0f}}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"uv_edge1", PARAM_TYPE_VEC2, OFFSET(triangle_uvs[2]), {.vec={0.0f, 1.0f}}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"uv_edge2", PARAM_TYPE_VEC2, OFFSET(triangle_uvs[4]), {.vec={1.0f, 1.0f}}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
     {NULL}
 };
 
 #define NB_VERTICES 3
 
-static int triangle_init(struct ngl_node *node)
+static void fill_vertices(struct shape *s)
 {
-    struct shape *s = node->priv_data;
-
-    s->nb_vertices = NB_VERTICES;
-    s->vertices = calloc(1, NGLI_SHAPE_VERTICES_SIZE(s));
-    if (!s->vertices)
-        return -1;
-
     float a[3];
     float b[3];
     float normal[3];
@@ -75,6 +68,17 @@ static int triangle_init(struct ngl_node *node)
         memcpy(dst, normal, sizeof(normal));
         dst += NGLI_SHAPE_NORMALS_NB;
     }
+}
+
+static int triangle_init(struct ngl_node *node)
+{
+    struct shape *s = node->priv_data;
+
+    s->nb_vertices = NB_VERTICES;
+    s->vertices = calloc(1, NGLI_SHAPE_VERTICES_SIZE(s));
+    if (!s->vertices)
+        return -1;
+    fill_vertices(s);
 
     static const GLushort indices[] = { 0, 1, 2 };
     s->nb_indices = NGLI_ARRAY_NB(indices);
@@ -91,21 +95,18 @@ static int triangle_init(struct ngl_node *node)
     return 0;
 }
 
-static void triangle_uninit(struct ngl_node *node)
+static int triangle_live_change(struct ngl_node *node, const struct node_param *par)
 {
-    struct ngl_ctx *ctx = node->ctx;
-    struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
-
     struct shape *s = node->priv_data;
 
-    ngli_glDeleteBuffers(gl, 1, &s->vertices_buffer_id);
-    ngli_glDeleteBuffers(gl, 1, &s->texcoords_buffer_id);
-    ngli_glDeleteBuffers(gl, 1, &s->normals_buffer_id);
-    ngli_glDeleteBuffers(gl, 1, &s->indices_buffer_id);
+    fill_vertices(s);
+    s->vertices_changed = 1;
+    return 0;
+}
 
-    free(s->vertices);
-    free(s->indices);
+static void triangle_uninit(struct ngl_node *node)
+{
+    ngli_shape_release_buffers(node);
 }
 
 const struct node_class ngli_triangle_class = {
@@ -113,6 +114,7 @@ const struct node_class ngli_triangle_class = {
     .name      = "Triangle",
     .init      = triangle_init,
     .uninit    = triangle_uninit,
+    .live_change = triangle_live_change,
     .priv_size = sizeof(struct shape),
     .params    = triangle_params,
 };
@@ -32,35 +32,35 @@
 
 #define OFFSET(x) offsetof(struct uniform, x)
 static const struct node_param uniformscalar_params[] = {
-    {"value",  PARAM_TYPE_DBL,  OFFSET(scalar)},
+    {"value",  PARAM_TYPE_DBL,  OFFSET(scalar), .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
     {"animkf", PARAM_TYPE_NODELIST, OFFSET(animkf), .flags=PARAM_FLAG_DOT_DISPLAY_PACKED,
                .node_types=(const int[]){NGL_NODE_ANIMKEYFRAMESCALAR, -1}},
     {NULL}
 };
 
 static const struct node_param uniformvec2_params[] = {
-    {"value",  PARAM_TYPE_VEC2, OFFSET(vector)},
+    {"value",  PARAM_TYPE_VEC2, OFFSET(vector), .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
     {"animkf", PARAM_TYPE_NODELIST, OFFSET(animkf), .flags=PARAM_FLAG_DOT_DISPLAY_PACKED,
                .node_types=(const int[]){NGL_NODE_ANIMKEYFRAMEVEC2, -1}},
     {NULL}
 };
 
 static const struct node_param uniformvec3_params[] = {
-    {"value",  PARAM_TYPE_VEC3, OFFSET(vector)},
+    {"value",  PARAM_TYPE_VEC3, OFFSET(vector), .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
     {"animkf", PARAM_TYPE_NODELIST, OFFSET(animkf), .flags=PARAM_FLAG_DOT_DISPLAY_PACKED,
                .node_types=(const int[]){NGL_NODE_ANIMKEYFRAMEVEC3, -1}},
     {NULL}
 };
 
 static const struct node_param uniformvec4_params[] = {
-    {"value",  PARAM_TYPE_VEC4, OFFSET(vector)},
+    {"value",  PARAM_TYPE_VEC4, OFFSET(vector), .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
     {"animkf", PARAM_TYPE_NODELIST, OFFSET(animkf), .flags=PARAM_FLAG_DOT_DISPLAY_PACKED,
                .node_types=(const int[]){NGL_NODE_ANIMKEYFRAMEVEC4, -1}},
     {NULL}
 };
 
 static const struct node_param uniformint_params[] = {
-    {"value",  PARAM_TYPE_INT, OFFSET(ival)},
+    {"value",  PARAM_TYPE_INT, OFFSET(ival), .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
     {NULL}
 };
 
@@ -74,7 +74,7 @@ static void uniform_scalar_update(struct ngl_node *node, double t)
     struct uniform *s = node->priv_data;
     if (s->nb_animkf) {
         float scalar;
-        ngli_animkf_interpolate(&scalar, s->animkf, s->nb_animkf, &s->current_kf, t);
+        ngli_animkf_interpolate(&scalar, &node->animkf_timeline, s->animkf, s->nb_animkf, &s->current_kf, t);
         s->scalar = scalar;
     }
 }
@@ -83,16 +83,16 @@ static void uniform_vec_update(struct ngl_node *node, double t)
 {
     struct uniform *s = node->priv_data;
     if (s->nb_animkf)
-        ngli_animkf_interpolate(s->vector, s->animkf, s->nb_animkf, &s->current_kf, t);
+        ngli_animkf_interpolate(s->vector, &node->animkf_timeline, s->animkf, s->nb_animkf, &s->current_kf, t);
 }
 
 static void uniform_mat_update(struct ngl_node *node, double t)
 {
     struct uniform *s = node->priv_data;
     if (s->transform) {
-        ngli_node_update(s->transform, t);
-        const float *matrix = ngli_get_last_transformation_matrix(s->transform);
-        memcpy(s->matrix, matrix, sizeof(s->matrix));
+        NGLI_ALIGNED_MAT(matrix);
+        if (ngli_get_last_transformation_matrix(s->transform, matrix) == 0)
+            memcpy(s->matrix, matrix, sizeof(s->matrix));
     }
 }
 
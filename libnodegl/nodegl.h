@@ -102,6 +102,15 @@ char *ngl_node_dot(const struct ngl_node *node);
 char *ngl_node_serialize(const struct ngl_node *node);
 struct ngl_node *ngl_node_deserialize(const char *s);
 
+/*
+ * Return the GPU execution time (in nanoseconds) of the last measured draw of
+ * a node with the measure_gpu parameter set, or a negative value if none is
+ * available yet. The measures are collected a few frames after the draw to
+ * avoid stalling, and are not available if the GL context does not support
+ * timer queries (OpenGL < 3.3 without GL_ARB_timer_query, OpenGL ES 2).
+ */
+int64_t ngl_node_get_gpu_time(const struct ngl_node *node);
+
 /* GL context */
 enum {
     NGL_GLPLATFORM_AUTO,
@@ -110,6 +119,7 @@ enum {
     NGL_GLPLATFORM_CGL,
     NGL_GLPLATFORM_EAGL,
     NGL_GLPLATFORM_WGL,
+    NGL_GLPLATFORM_NULL, /* no GPU: the GL calls are only recorded, see ngl_get_gl_log() */
 };
 
 /* GL API version */
@@ -124,11 +134,218 @@ struct ngl_ctx;
 
 struct ngl_ctx *ngl_create(void);
 int ngl_set_glcontext(struct ngl_ctx *s, void *display, void *window, void *handle, int platform, int api);
+
+/*
+ * Create a GL context owned by node.gl instead of wrapping the current one.
+ * It does not need any window (nor X server): the scene is rendered into an
+ * internal framebuffer of the specified size, which can be read back with
+ * the Camera pipe parameters. NGL_GLPLATFORM_AUTO selects EGL, which uses the
+ * Mesa surfaceless platform when available (working with its software
+ * rasterizer) or a pbuffer otherwise. The context is current on the calling
+ * thread on success.
+ */
+int ngl_set_glcontext_offscreen(struct ngl_ctx *s, int width, int height, int platform, int api);
 int ngl_set_glstates(struct ngl_ctx *s, int nb_glstates, struct ngl_node **glstates);
 int ngl_set_scene(struct ngl_ctx *s, struct ngl_node *scene);
+
+/*
+ * Set the number of worker threads used to update the independent children of
+ * the Group nodes. The draw always happens in the calling thread. A value of 0
+ * (the default) disables the threaded update.
+ */
+int ngl_set_nb_threads(struct ngl_ctx *s, int nb_threads);
+
+/*
+ * Enable or disable the loader thread. It owns a GL context shared with the
+ * rendering one, compiles the shader programs and starts the medias ahead of
+ * their use so the rendering thread does not stall on them. The GL context
+ * must be set, and the scene must not be set yet.
+ */
+int ngl_set_async_prefetch(struct ngl_ctx *s, int enabled);
+
+/*
+ * Set a directory where the linked shader programs are stored in a binary
+ * form, to be reloaded instead of compiled on the next runs. The directory
+ * must exist. Binaries rejected by the driver (after an update for instance)
+ * are silently compiled again. NULL (the default) disables the cache. With
+ * async prefetch enabled, the directory can not be changed while a scene is
+ * set.
+ */
+int ngl_set_program_cache_dir(struct ngl_ctx *s, const char *dir);
+
+/*
+ * Set the amount of GPU memory (in bytes) the textures, render buffers and
+ * vertex buffers of the scene should fit in. When it is exceeded at the end
+ * of a draw, the least recently used nodes which are not needed for the
+ * current frame (kept ready because they will be needed soon) are released
+ * until it fits again. 0 (the default) means no limit.
+ */
+int ngl_set_gpu_memory_budget(struct ngl_ctx *s, int64_t budget);
+
+enum {
+    NGL_GPU_MEMORY_BUFFERS,         /* vertex and index buffers of the shapes */
+    NGL_GPU_MEMORY_TEXTURES,
+    NGL_GPU_MEMORY_RENDERBUFFERS,
+    NGL_GPU_MEMORY_TOTAL,
+};
+
+/*
+ * Get the amount of GPU memory (in bytes) currently allocated by the nodes of
+ * the scene for one of the NGL_GPU_MEMORY_* categories, or -1 for an invalid
+ * category.
+ */
+int64_t ngl_get_gpu_memory(struct ngl_ctx *s, int type);
+
+/*
+ * Set the safety margin (in seconds, 0.25 by default) of the prefetch
+ * scheduling. The nodes with render ranges are started ahead of their use by
+ * the time measured to start their subtree plus this margin. Until it has
+ * been measured, they are started 1 second ahead. The prefetch_time parameter
+ * of a node overrides this lead time.
+ */
+int ngl_set_prefetch_margin(struct ngl_ctx *s, double margin);
+
+/*
+ * Compile and link all the shader programs of the current scene so the first
+ * frames do not have to wait for them. The compilations are all submitted
+ * before waiting for any of them, so the driver can run them in parallel.
+ * Calling this function is optional and requires the GL context to be
+ * current.
+ */
+int ngl_prepare_shaders(struct ngl_ctx *s);
+
+typedef void (*ngl_progress_callback_type)(void *arg, int done, int total);
+
+/*
+ * Initialize and prefetch every node of the current scene needed between
+ * t_start and t_end (shaders, textures, medias, ...) so the draws in that
+ * time window do not stall on resource allocation. The prepared nodes are not
+ * released as long as the drawn time stays in that window. The optional
+ * callback is called after each prefetched node with the number of nodes
+ * done so far and the total number of nodes to prefetch.
+ *
+ * This function requires the GL context to be current.
+ */
+int ngl_prepare(struct ngl_ctx *s, double t_start, double t_end,
+                ngl_progress_callback_type callback, void *arg);
+
+/*
+ * Enable or disable the collection of statistics: CPU time spent in the
+ * init, prefetch, update and draw of every node, draw calls, GL state changes
+ * and texture bytes uploaded. Enabling them resets the values collected so
+ * far. They are disabled by default, and cost close to nothing then.
+ */
+int ngl_set_stats(struct ngl_ctx *s, int enabled);
+
+/*
+ * Return the statistics of the current scene in CSV, one line per node
+ * followed by one line per node class. The times are in microseconds, and
+ * the times and counters of a node include the ones of its children. The
+ * values of a class are the sums of the values of its nodes, so the work of
+ * nested nodes is counted several times in them. The *_last columns hold the
+ * values of the last drawn frame. The returned string must be freed by the
+ * caller.
+ */
+char *ngl_get_stats(struct ngl_ctx *s);
+
+/*
+ * Record the begin and end of the frames and of the init, prefetch, update,
+ * draw and release of every node in a ring buffer of nb_events events, with
+ * their timestamp, thread and frame time. When it is full, the oldest events
+ * are overwritten. Recording is cheap and lock-free, so it can be left on. A
+ * size of 0 (the default) disables it and drops the recorded events. The
+ * size can not be changed while a scene is set with the async prefetch
+ * enabled.
+ */
+int ngl_set_trace(struct ngl_ctx *s, int nb_events);
+
+/*
+ * Return the recorded events in the Chrome trace event JSON format, which
+ * can be loaded in chrome://tracing or Perfetto. The returned string must be
+ * freed by the caller.
+ */
+char *ngl_get_trace(struct ngl_ctx *s);
+
+/*
+ * Return the GL calls recorded by a context using NGL_GLPLATFORM_NULL since
+ * the previous call (or its creation), and reset them. The report is made of
+ * 3 CSV sections separated by an empty line: the counters (draw calls, binds,
+ * uploads, gets, total, and calls dropped from the log), the number of calls
+ * per GL function, and the log of the calls in their order, limited to the
+ * first 65536 ones. The calls of the loader thread are not included. The
+ * returned string must be freed by the caller.
+ */
+char *ngl_get_gl_log(struct ngl_ctx *s);
 int ngl_draw(struct ngl_ctx *s, double t);
 void ngl_free(struct ngl_ctx **ss);
 
+/*
+ * Frame ring
+ *
+ * Shared memory alternative to the Camera pipe for a consumer running in
+ * another process: the Camera reads the frames back directly into the slots
+ * of the ring, which the consumer maps and reads in place, without any copy
+ * through the kernel. The ring starts with a struct ngl_framering_header
+ * immediately followed by nb_slots struct ngl_framering_slot, and the frames
+ * are stored every slot_size bytes from data_offset (page aligned).
+ *
+ * Frame n goes to slot n % nb_slots. The producer fills the slot and its
+ * descriptor, then increments nb_written. The consumer reads the frames until
+ * nb_read reaches nb_written, and increments nb_read once it is done with a
+ * slot so the producer can overwrite it. The counters wrap around and must be
+ * accessed atomically. The producer increments seq after every frame and at
+ * the end of the stream (when the Camera is released, setting eos): this is
+ * the futex word the consumer waits on, while the producer waits on nb_read,
+ * so both sides must use shared (not private) futex operations. A consumer
+ * setting consumer_pid lets the producer drop the frames instead of waiting
+ * forever if it exits early.
+ */
+#define NGL_FRAMERING_MAGIC   0x52474e4e /* "NNGR" */
+#define NGL_FRAMERING_VERSION 1
+
+/* Frame layouts, see the pipe_format parameter of the Camera */
+enum {
+    NGL_PIXFMT_RGBA,
+    NGL_PIXFMT_NV12,
+    NGL_PIXFMT_I420,
+};
+
+struct ngl_framering_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t format;            /* NGL_PIXFMT_* */
+    uint32_t width;
+    uint32_t height;
+    uint32_t nb_planes;
+    uint32_t linesizes[4];      /* bytes per row of each plane */
+    uint64_t plane_offsets[4];  /* offset of each plane from the start of a frame */
+    uint64_t frame_size;
+    uint64_t slot_size;
+    uint64_t data_offset;
+    uint32_t nb_slots;
+    int32_t  producer_pid;
+    int32_t  consumer_pid;
+    uint32_t seq;
+    uint32_t nb_written;
+    uint32_t nb_read;
+    uint32_t eos;
+    uint32_t reserved;
+};
+
+struct ngl_framering_slot {
+    uint64_t frame_index;       /* index of the frame in the stream */
+    double   time;              /* scene time of the frame, in seconds */
+};
+
+/*
+ * Create a frame ring of nb_slots frames and return its file descriptor (a
+ * memfd, not closed on exec so it can be inherited by the consumer), or -1
+ * on error. It is then set as the shm_fd parameter of a Camera with the same
+ * pipe dimensions and format. The caller owns the file descriptor. Only
+ * supported on Linux.
+ */
+int ngl_framering_create(int width, int height, int format, int nb_slots);
+
 /* Android */
 int ngl_jni_set_java_vm(void *vm);
 void *ngl_jni_get_java_vm(void);
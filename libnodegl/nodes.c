@@ -19,6 +19,7 @@
  * under the License.
  */
 
+#include <math.h>
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -31,6 +32,7 @@
 #include "nodegl.h"
 #include "nodes.h"
 #include "params.h"
+#include "transforms.h"
 #include "utils.h"
 
 extern const struct node_class ngli_camera_class;
@@ -119,9 +121,11 @@ static const char *param_type_strings[] = {
 
 #define OFFSET(x) offsetof(struct ngl_node, x)
 const struct node_param ngli_base_node_params[] = {
-    {"glstates", PARAM_TYPE_NODELIST, OFFSET(glstates), .flags=PARAM_FLAG_DOT_DISPLAY_PACKED},
-    {"ranges",   PARAM_TYPE_NODELIST, OFFSET(ranges),   .flags=PARAM_FLAG_DOT_DISPLAY_PACKED},
-    {"name",     PARAM_TYPE_STR,      OFFSET(name)},
+    {"glstates",      PARAM_TYPE_NODELIST, OFFSET(glstates),      .flags=PARAM_FLAG_DOT_DISPLAY_PACKED},
+    {"ranges",        PARAM_TYPE_NODELIST, OFFSET(ranges),        .flags=PARAM_FLAG_DOT_DISPLAY_PACKED},
+    {"name",          PARAM_TYPE_STR,      OFFSET(name),          .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"prefetch_time", PARAM_TYPE_DBL,      OFFSET(prefetch_time), {.dbl=-1.0}, .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
+    {"measure_gpu",   PARAM_TYPE_INT,      OFFSET(measure_gpu),   .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE},
     {NULL}
 };
 
@@ -176,16 +180,19 @@ static void *aligned_allocz(size_t size)
     return ptr;
 }
 
-#define ALIGN(v, a) ((v) + (((v) + (a) - 1) & ~((v) - 1)))
+#define ALIGN(v, a) (((v) + (a) - 1) & ~((a) - 1))
 
-static struct ngl_node *node_create(const struct node_class *class)
+static struct ngl_node *node_create(struct arena *arena, const struct node_class *class)
 {
     struct ngl_node *node;
     const size_t node_size = ALIGN(sizeof(*node), NGLI_ALIGN);
+    const size_t size = node_size + class->priv_size;
 
-    node = aligned_allocz(node_size + class->priv_size);
+    node = arena ? ngli_arena_allocz(arena, size) : aligned_allocz(size);
     if (!node)
         return NULL;
+    if (arena)
+        node->arena = ngli_arena_ref(arena);
     node->priv_data = ((uint8_t *)node) + node_size;
 
     /* Make sure the node and its private data are properly aligned */
@@ -199,16 +206,10 @@ static struct ngl_node *node_create(const struct node_class *class)
     node->refcount = 1;
 
     node->state = STATE_UNINITIALIZED;
-
-    node->modelview_matrix[ 0] =
-    node->modelview_matrix[ 5] =
-    node->modelview_matrix[10] =
-    node->modelview_matrix[15] = 1.f;
-
-    node->projection_matrix[ 0] =
-    node->projection_matrix[ 5] =
-    node->projection_matrix[10] =
-    node->projection_matrix[15] = 1.f;
+    node->dirty = 1;
+    node->init_duration = -1;
+    node->prefetch_duration = -1;
+    node->gputimer.time = -1;
 
     return node;
 }
@@ -224,13 +225,23 @@ char *ngli_node_default_name(const char *class_name)
     return name;
 }
 
-struct ngl_node *ngli_node_create_noconstructor(int type)
+static void node_free(struct ngl_node *node)
+{
+    /* The node memory may be owned by its arena, so unref a copy */
+    struct arena *arena = node->arena;
+    if (arena)
+        ngli_arena_unrefp(&arena);
+    else
+        free(node);
+}
+
+struct ngl_node *ngli_node_create_noconstructor(struct arena *arena, int type)
 {
     struct ngl_node *node = NULL;
 
     if (type < 0 || type >= NGLI_ARRAY_NB(node_class_map))
         return NULL;
-    node = node_create(node_class_map[type]);
+    node = node_create(arena, node_class_map[type]);
     if (!node)
         return NULL;
 
@@ -239,7 +250,7 @@ struct ngl_node *ngli_node_create_noconstructor(int type)
 
     node->name = ngli_node_default_name(node->class->name);
     if (!node->name) {
-        free(node);
+        node_free(node);
         return NULL;
     }
 
@@ -248,7 +259,7 @@ struct ngl_node *ngli_node_create_noconstructor(int type)
 
 struct ngl_node *ngl_node_create(int type, ...)
 {
-    struct ngl_node *node = ngli_node_create_noconstructor(type);
+    struct ngl_node *node = ngli_node_create_noconstructor(NULL, type);
     if (!node)
         return NULL;
 
@@ -257,6 +268,11 @@ struct ngl_node *ngl_node_create(int type, ...)
     ngli_params_set_constructors(node->priv_data, node->class->params, &ap);
     va_end(ap);
 
+    if (ngli_node_cache_children(node) < 0) {
+        ngl_node_unrefp(&node);
+        return NULL;
+    }
+
     LOG(VERBOSE, "CREATED %s @ %p", node->name, node);
 
     return node;
@@ -268,7 +284,14 @@ static int compare_range(const void *p1, const void *p2)
     const struct ngl_node *n2 = *(const struct ngl_node **)p2;
     const struct renderrange *r1 = n1->priv_data;
     const struct renderrange *r2 = n2->priv_data;
-    return r1->start_time > r2->start_time;
+    return (r1->start_time > r2->start_time) - (r1->start_time < r2->start_time);
+}
+
+static void trace_node(const struct ngl_node *node, int op, char phase, double t)
+{
+    struct trace *trace = node->ctx->trace;
+    if (trace)
+        ngli_trace_add(trace, op, phase, node->class->name, node->name, t);
 }
 
 void ngli_node_release(struct ngl_node *node)
@@ -276,15 +299,23 @@ void ngli_node_release(struct ngl_node *node)
     if (node->state == STATE_IDLE)
         return;
 
+    /* A prefetch running in the loader must complete before it is undone */
+    if (node->prefetch_job)
+        ngli_node_prefetch(node);
+
     if (node->state != STATE_READY)
         return;
 
     ngli_assert(node->ctx);
     if (node->class->release) {
         LOG(DEBUG, "RELEASE %s @ %p", node->name, node);
+        trace_node(node, NGLI_TRACE_RELEASE, 'B', NAN);
         node->class->release(node);
+        trace_node(node, NGLI_TRACE_RELEASE, 'E', NAN);
     }
+    ngli_gputimer_reset(&node->gputimer);
     node->state = STATE_IDLE;
+    node->dirty = 1;
 }
 
 static const size_t opt_sizes[] = {
@@ -334,45 +365,109 @@ static void node_uninit(struct ngl_node *node)
         node->class->uninit(node);
     }
     reset_non_params(node);
+    ngli_timeline_reset(&node->ranges_timeline);
+    ngli_timeline_reset(&node->animkf_timeline);
     node->state = STATE_UNINITIALIZED;
+    node->dirty = 1;
 }
 
-static int node_set_children_ctx(uint8_t *base_ptr, const struct node_param *params,
-                                 struct ngl_ctx *ctx)
+static int fetch_children(struct node_child *children, uint8_t *base_ptr,
+                          const struct node_param *par)
 {
-    if (!params)
-        return 0;
-    for (int i = 0; params[i].key; i++) {
-        const struct node_param *par = &params[i];
-
-        if (par->type == PARAM_TYPE_NODE) {
-            uint8_t *node_p = base_ptr + par->offset;
-            struct ngl_node *node = *(struct ngl_node **)node_p;
-            if (node) {
-                int ret = ngli_node_attach_ctx(node, ctx);
-                if (ret < 0)
-                    return ret;
+    int nb_children = 0;
+
+    while (par && par->key) {
+        switch (par->type) {
+            case PARAM_TYPE_NODE: {
+                struct ngl_node *child = *(struct ngl_node **)(base_ptr + par->offset);
+                if (child) {
+                    if (children)
+                        children[nb_children] = (struct node_child){child, par, NULL};
+                    nb_children++;
+                }
+                break;
             }
-        } else if (par->type == PARAM_TYPE_NODELIST) {
-            uint8_t *elems_p = base_ptr + par->offset;
-            uint8_t *nb_elems_p = base_ptr + par->offset + sizeof(struct ngl_node **);
-            struct ngl_node **elems = *(struct ngl_node ***)elems_p;
-            const int nb_elems = *(int *)nb_elems_p;
-            for (int j = 0; j < nb_elems; j++) {
-                int ret = ngli_node_attach_ctx(elems[j], ctx);
-                if (ret < 0)
-                    return ret;
+            case PARAM_TYPE_NODELIST: {
+                uint8_t *elems_p = base_ptr + par->offset;
+                uint8_t *nb_elems_p = base_ptr + par->offset + sizeof(struct ngl_node **);
+                struct ngl_node **elems = *(struct ngl_node ***)elems_p;
+                const int nb_elems = *(int *)nb_elems_p;
+                for (int i = 0; i < nb_elems; i++) {
+                    if (children)
+                        children[nb_children] = (struct node_child){elems[i], par, NULL};
+                    nb_children++;
+                }
+                break;
             }
-        } else if (par->type == PARAM_TYPE_NODEDICT) {
-            struct ndict *ndict = *(struct ndict **)(base_ptr + par->offset);
-            struct ndict_entry *entry = NULL;
-            while ((entry = ngli_ndict_get(ndict, NULL, entry))) {
-                struct ngl_node *node = entry->node;
-                int ret = ngli_node_attach_ctx(node, ctx);
-                if (ret < 0)
-                    return ret;
+            case PARAM_TYPE_NODEDICT: {
+                struct ndict *ndict = *(struct ndict **)(base_ptr + par->offset);
+                struct ndict_entry *entry = NULL;
+                while ((entry = ngli_ndict_get(ndict, NULL, entry))) {
+                    if (children)
+                        children[nb_children] = (struct node_child){entry->node, par, entry->name};
+                    nb_children++;
+                }
+                break;
             }
         }
+        par++;
+    }
+    return nb_children;
+}
+
+/*
+ * Build the children array of the node from its parameters. This needs to be
+ * called every time a node parameter is set, so the graph crawling never has
+ * to go through the parameters reflection again.
+ */
+int ngli_node_cache_children(struct ngl_node *node)
+{
+    uint8_t *base_ptr = (uint8_t *)node;
+    uint8_t *priv_ptr = node->priv_data;
+    const struct node_param *base_params = ngli_base_node_params;
+    const struct node_param *priv_params = node->class->params;
+
+    const int nb_base_children = fetch_children(NULL, base_ptr, base_params);
+    const int nb_children = nb_base_children + fetch_children(NULL, priv_ptr, priv_params);
+
+    free(node->children);
+    node->children = NULL;
+    node->nb_children = 0;
+    node->nb_base_children = 0;
+
+    if (!nb_children)
+        return 0;
+
+    node->children = calloc(nb_children, sizeof(*node->children));
+    if (!node->children)
+        return -1;
+
+    int n = fetch_children(node->children, base_ptr, base_params);
+    n += fetch_children(node->children + n, priv_ptr, priv_params);
+    ngli_assert(n == nb_children);
+    node->nb_children = nb_children;
+    node->nb_base_children = nb_base_children;
+
+    return 0;
+}
+
+const struct node_child *ngli_node_get_child(const struct ngl_node *node,
+                                             const struct node_child *prev)
+{
+    if (!node->nb_children)
+        return NULL;
+    if (!prev)
+        return node->children;
+    const struct node_child *next = prev + 1;
+    return next < node->children + node->nb_children ? next : NULL;
+}
+
+static int node_set_children_ctx(struct ngl_node *node, struct ngl_ctx *ctx)
+{
+    for (int i = 0; i < node->nb_children; i++) {
+        int ret = ngli_node_attach_ctx(node->children[i].node, ctx);
+        if (ret < 0)
+            return ret;
     }
     return 0;
 }
@@ -393,10 +488,12 @@ static int node_set_ctx(struct ngl_node *node, struct ngl_ctx *ctx)
     } else {
         node_uninit(node);
         node->ctx = NULL;
+        node->is_static = 0;
+        node->can_update_async = 0;
+        node->update_async = 0;
     }
 
-    if ((ret = node_set_children_ctx(node->priv_data, node->class->params, ctx)) < 0 ||
-        (ret = node_set_children_ctx((uint8_t *)node, ngli_base_node_params, ctx)) < 0)
+    if ((ret = node_set_children_ctx(node, ctx)) < 0)
         return ret;
     return 0;
 }
@@ -412,6 +509,60 @@ void ngli_node_detach_ctx(struct ngl_node *node)
     ngli_assert(ret == 0);
 }
 
+static int is_animkf(const struct ngl_node *node)
+{
+    const int id = node->class->id;
+    return id == NGL_NODE_ANIMKEYFRAMESCALAR ||
+           id == NGL_NODE_ANIMKEYFRAMEVEC2   ||
+           id == NGL_NODE_ANIMKEYFRAMEVEC3   ||
+           id == NGL_NODE_ANIMKEYFRAMEVEC4;
+}
+
+/*
+ * Reference the start times of the render ranges and the times of the
+ * animation keyframes so they can be looked up by bisection. The ranges must be sorted
+ * at this point. Node classes have at most one list of keyframes, so they are
+ * picked from the children cache.
+ */
+static int build_timelines(struct ngl_node *node)
+{
+    int ret = ngli_timeline_init(&node->ranges_timeline, node->nb_ranges);
+    if (ret < 0)
+        return ret;
+
+    for (int i = 0; i < node->nb_ranges; i++) {
+        const struct renderrange *rr = node->ranges[i]->priv_data;
+        node->ranges_timeline.times[i] = &rr->start_time;
+    }
+
+    int nb_animkf = 0;
+    for (int i = node->nb_base_children; i < node->nb_children; i++)
+        nb_animkf += is_animkf(node->children[i].node);
+
+    ret = ngli_timeline_init(&node->animkf_timeline, nb_animkf);
+    if (ret < 0)
+        return ret;
+
+    int n = 0;
+    for (int i = node->nb_base_children; i < node->nb_children; i++) {
+        const struct ngl_node *child = node->children[i].node;
+        if (is_animkf(child)) {
+            const struct animkeyframe *kf = child->priv_data;
+            node->animkf_timeline.times[n++] = &kf->time;
+        }
+    }
+
+    return 0;
+}
+
+#define LATENCY_AVG_WINDOW 8
+
+static void record_latency(int64_t *avg, int *nb, int64_t duration)
+{
+    *nb = NGLI_MIN(*nb + 1, LATENCY_AVG_WINDOW);
+    *avg += (duration - *avg) / *nb;
+}
+
 int ngli_node_init(struct ngl_node *node)
 {
     if (node->state == STATE_INITIALIZED)
@@ -423,36 +574,49 @@ int ngli_node_init(struct ngl_node *node)
     ngli_assert(node->ctx);
     if (node->class->init) {
         LOG(VERBOSE, "INIT %s @ %p", node->name, node);
+        struct stats_probe probe;
+        if (node->ctx->stats_enabled)
+            ngli_stats_probe_start(node->ctx, &probe);
+        trace_node(node, NGLI_TRACE_INIT, 'B', NAN);
+        const int64_t start = ngli_gettime();
         int ret = node->class->init(node);
+        trace_node(node, NGLI_TRACE_INIT, 'E', NAN);
         if (ret < 0)
             return ret;
+        node->init_duration = ngli_gettime() - start;
+        if (node->ctx->stats_enabled)
+            ngli_stats_probe_end(node, NGLI_STATS_INIT, &probe);
+
+        struct class_latency *cl = &node->ctx->class_latency[node->class->id];
+        record_latency(&cl->init, &cl->nb_inits, node->init_duration);
     }
     // Sort the ranges by start time. We also skip the ngli_node_init as, for
     // now, render ranges don't have any
     // TODO: merge successive continuous and norender ones?
     qsort(node->ranges, node->nb_ranges, sizeof(*node->ranges), compare_range);
 
+    int ret = build_timelines(node);
+    if (ret < 0)
+        goto fail;
+
     for (int i = 0; i < node->nb_glstates; i++) {
-        int ret = ngli_node_init(node->glstates[i]);
+        ret = ngli_node_init(node->glstates[i]);
         if (ret < 0)
-            return ret;
+            goto fail;
     }
 
     node->state = STATE_INITIALIZED;
 
     return 0;
-}
 
-static int get_rr_id(const struct ngl_node *node, int start, double t)
-{
-    int ret = -1;
-
-    for (int i = start; i < node->nb_ranges; i++) {
-        const struct renderrange *rr = node->ranges[i]->priv_data;
-        if (rr->start_time > t)
-            break;
-        ret = i;
+fail:
+    if (node->class->uninit) {
+        LOG(VERBOSE, "UNINIT %s @ %p", node->name, node);
+        node->class->uninit(node);
     }
+    reset_non_params(node);
+    ngli_timeline_reset(&node->ranges_timeline);
+    ngli_timeline_reset(&node->animkf_timeline);
     return ret;
 }
 
@@ -461,13 +625,8 @@ static int update_rr_state(struct ngl_node *node, double t)
     if (!node->nb_ranges)
         return -1;
 
-    int rr_id = get_rr_id(node, node->current_range, t);
-    if (rr_id < 0) {
-        // range not found, probably backward in time so look from the
-        // start
-        // TODO: look for rr using bsearch?
-        rr_id = get_rr_id(node, 0, t);
-    }
+    ngli_assert(node->ranges_timeline.nb_times == node->nb_ranges);
+    const int rr_id = ngli_timeline_find(&node->ranges_timeline, node->current_range, t, 1);
 
     if (rr_id >= 0) {
         if (node->current_range != rr_id) {
@@ -486,8 +645,27 @@ static int update_rr_state(struct ngl_node *node, double t)
     return rr_id;
 }
 
-static void node_update(struct ngl_node *node, double t)
+static void mark_updated(struct ngl_node *node, double t)
+{
+    node->last_update_time = t;
+    node->last_use = node->ctx->frame_index;
+    node->drawme = 1;
+}
+
+/*
+ * Start the update of a node at the time of its parent. Return 1 if the node
+ * and its subtree need to be updated, in which case the update is completed by
+ * node_update_end() once the children are updated, with the time set in *tp
+ * (render ranges can freeze it for the subtree).
+ */
+static int node_update_begin(struct ngl_node *node, double *tp, struct stats_probe *probe)
 {
+    double t = *tp;
+
+    int ret = ngli_node_init(node);
+    if (ret < 0)
+        return 0;
+
     node->drawme = 0;
 
     const int rr_id = update_rr_state(node, t);
@@ -495,195 +673,733 @@ static void node_update(struct ngl_node *node, double t)
         struct ngl_node *rr = node->ranges[rr_id];
 
         if (rr->class->id == NGL_NODE_RENDERRANGENORENDER)
-            return;
+            return 0;
 
         if (rr->class->id == NGL_NODE_RENDERRANGEONCE) {
             struct renderrange *rro = rr->priv_data;
             if (rro->updated)
-                return;
+                return 0;
             t = rro->render_time;
             rro->updated = 1;
         }
     }
 
-    if (node->last_update_time != t) {
-        // Sometimes the node might not be prefetched by the node_check_prefetch()
-        // crawling: this could happen when the node was for instance instantiated
-        // internally and not through the options. So just to be safe, we
-        // "prefetch" it now (a bit late for sure).
-        ngli_node_prefetch(node);
+    if (node->last_update_time == t) {
+        LOG(VERBOSE, "%s already updated for t=%g, skip it", node->name, t);
+        mark_updated(node, t);
+        return 0;
+    }
 
-        LOG(VERBOSE, "UPDATE %s @ %p with t=%g", node->name, node, t);
+    if (node->is_static && !node->dirty && node->state == STATE_READY) {
+        // Nothing changed in the subtree since the last update, so the
+        // previously computed states (matrices, uniforms, ...) are still
+        // valid.
+        LOG(VERBOSE, "%s is static and clean, skip update", node->name);
+        mark_updated(node, t);
+        return 0;
+    }
+
+    // Sometimes the node might not be prefetched by the node_check_prefetch()
+    // crawling: this could happen when the node was for instance instantiated
+    // internally and not through the options. So just to be safe, we
+    // "prefetch" it now (a bit late for sure).
+    ngli_node_prefetch(node);
+
+    LOG(VERBOSE, "UPDATE %s @ %p with t=%g", node->name, node, t);
+    if (node->ctx->stats_enabled)
+        ngli_stats_probe_start(node->ctx, probe);
+    trace_node(node, NGLI_TRACE_UPDATE, 'B', t);
+    if (node->class->pre_update)
+        node->class->pre_update(node, t);
+
+    *tp = t;
+    return 1;
+}
+
+static void node_update_end(struct ngl_node *node, double t, const struct stats_probe *probe)
+{
+    if (node->class->update)
         node->class->update(node, t);
-    } else {
-        LOG(VERBOSE, "%s already updated for t=%g, skip it", node->name, t);
+    trace_node(node, NGLI_TRACE_UPDATE, 'E', t);
+    if (node->ctx->stats_enabled)
+        ngli_stats_probe_end(node, NGLI_STATS_UPDATE, probe);
+    node->dirty = 0;
+    mark_updated(node, t);
+}
+
+static int node_draw_begin(struct ngl_node *node, struct stats_probe *probe)
+{
+    if (!node->drawme) {
+        LOG(VERBOSE, "%s @ %p not marked for drawing, skip it", node->name, node);
+        return 0;
     }
-    node->last_update_time = t;
-    node->drawme = 1;
+
+    LOG(VERBOSE, "DRAW %s @ %p", node->name, node);
+    if (node->ctx->stats_enabled)
+        ngli_stats_probe_start(node->ctx, probe);
+    trace_node(node, NGLI_TRACE_DRAW, 'B', node->last_update_time);
+    if (node->measure_gpu)
+        ngli_gputimer_start(&node->gputimer, node->ctx->glcontext);
+    ngli_honor_glstates(node->ctx, node->nb_glstates, node->glstates);
+    if (node->class->draw)
+        node->class->draw(node);
+    return 1;
 }
 
-#define PREFETCH_TIME 1.0
-#define MAX_IDLE_TIME (PREFETCH_TIME + 3.0)
+static void node_draw_end(struct ngl_node *node, const struct stats_probe *probe)
+{
+    if (node->class->post_draw)
+        node->class->post_draw(node);
+    ngli_restore_glstates(node->ctx, node->nb_glstates, node->glstates);
+    ngli_gputimer_stop(&node->gputimer);
+    trace_node(node, NGLI_TRACE_DRAW, 'E', node->last_update_time);
+    if (node->ctx->stats_enabled)
+        ngli_stats_probe_end(node, NGLI_STATS_DRAW, probe);
+}
 
-// TODO: render once
-static void check_activity(struct ngl_node *node, double t, int parent_is_active)
+/*
+ * Nodes with a draw callback, or drawing some of their children, are drawn;
+ * the others (textures, uniforms, shapes, ...) are only used by the draw of
+ * their parent.
+ */
+static int is_drawable(const struct ngl_node *node)
 {
-    int is_active = parent_is_active;
+    if (node->class->draw || node->class->post_draw)
+        return 1;
+    const struct node_param *par = node->class->params;
+    while (par && par->key) {
+        if (par->flags & PARAM_FLAG_DRAW_CHILD)
+            return 1;
+        par++;
+    }
+    return 0;
+}
 
-    int ret = ngli_node_init(node);
-    if (ret < 0)
-        return;
+#define DEFAULT_PREFETCH_TIME 1.0
+#define KEEP_ALIVE_TIME 3.0
+
+static int count_entries(struct ngl_node *node, int depth, int *max_depth)
+{
+    int nb_entries = 1;
+    node->graph_refs = 0;
+    for (int i = 0; i < node->nb_ranges; i++)
+        node->ranges[i]->graph_refs = 0;
+    *max_depth = NGLI_MAX(*max_depth, depth);
+    for (int i = node->nb_base_children; i < node->nb_children; i++)
+        nb_entries += count_entries(node->children[i].node, depth + 1, max_depth);
+    return nb_entries;
+}
+
+static int is_time_dependent(const struct ngl_node *node)
+{
+    if (node->nb_ranges)
+        return 1;
+
+    switch (node->class->id) {
+    case NGL_NODE_MEDIA:
+    case NGL_NODE_FPS:
+    case NGL_NODE_ANIMKEYFRAMESCALAR:
+    case NGL_NODE_ANIMKEYFRAMEVEC2:
+    case NGL_NODE_ANIMKEYFRAMEVEC3:
+    case NGL_NODE_ANIMKEYFRAMEVEC4:
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * Textures upload the media frames and FPS measures the time spent in its
+ * subtree, so these updates must happen on the GL thread.
+ */
+static int is_update_gl_free(const struct ngl_node *node)
+{
+    switch (node->class->id) {
+    case NGL_NODE_TEXTURE:
+    case NGL_NODE_MEDIA:
+    case NGL_NODE_FPS:
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * The update of a node marks its current RenderRangeOnce as done, so a range
+ * shared with another node must not be updated from concurrent threads.
+ */
+static int has_shared_range_once(const struct ngl_node *node)
+{
+    for (int i = 0; i < node->nb_ranges; i++) {
+        const struct ngl_node *rr = node->ranges[i];
+        if (rr->class->id == NGL_NODE_RENDERRANGEONCE && rr->graph_refs > 1)
+            return 1;
+    }
+    return 0;
+}
+
+static void fill_entries(struct ngl_ctx *ctx, struct ngl_node *node, int parent, int draw,
+                         int *nb_entries, int *nb_postorder)
+{
+    const int id = (*nb_entries)++;
+    struct graph_entry *e = &ctx->graph[id];
+
+    e->node = node;
+    e->parent = parent;
+    e->draw = draw && is_drawable(node);
+
+    node->graph_refs++;
+    for (int i = 0; i < node->nb_ranges; i++)
+        node->ranges[i]->graph_refs++;
+    node->is_static = !is_time_dependent(node);
+    node->dirty = 1;
+
+    for (int i = node->nb_base_children; i < node->nb_children; i++) {
+        struct ngl_node *child = node->children[i].node;
+        const int draw_child = e->draw && (node->children[i].par->flags & PARAM_FLAG_DRAW_CHILD);
+        fill_entries(ctx, child, id, draw_child, nb_entries, nb_postorder);
+        node->is_static &= child->is_static;
+    }
+
+    e->next = *nb_entries;
+    ctx->graph_postorder[(*nb_postorder)++] = id;
+}
+
+void ngli_node_reset_graph(struct ngl_ctx *ctx)
+{
+    free(ctx->graph);
+    free(ctx->graph_postorder);
+    ctx->graph = NULL;
+    ctx->graph_postorder = NULL;
+    ctx->nb_graph_entries = 0;
+    ctx->graph_changed = 0;
+    ctx->shaders_submitted = 0;
+    ngli_matrix_stack_reset(&ctx->modelview);
+    ngli_matrix_stack_reset(&ctx->projection);
+}
+
+int ngli_node_compile_graph(struct ngl_ctx *ctx)
+{
+    ngli_node_reset_graph(ctx);
+
+    if (!ctx->scene)
+        return 0;
+
+    int max_depth = 0;
+    const int nb_entries = count_entries(ctx->scene, 0, &max_depth);
+    ctx->graph = calloc(nb_entries, sizeof(*ctx->graph));
+    ctx->graph_postorder = calloc(nb_entries, sizeof(*ctx->graph_postorder));
 
     /*
-     * The life of the parent takes over the life of its children: if the
-     * parent is dead, the children are likely dead as well. However, a living
-     * children from a dead parent can be revealed by another living branch.
+     * Every node of a path pushes at most one matrix on each stack, and some
+     * nodes can be drawn internally (outside the graph) with one more level.
      */
-    if (parent_is_active) {
-        const int rr_id = update_rr_state(node, t);
-
-        if (rr_id >= 0) {
-            struct ngl_node *rr = node->ranges[rr_id];
-
-            node->current_range = rr_id;
-
-            if (rr->class->id == NGL_NODE_RENDERRANGENORENDER) {
-                is_active = 0;
-
-                if (rr_id < node->nb_ranges - 1) {
-                    // We assume here the next range requires the node started
-                    // as the current one doesn't.
-                    const struct renderrange *next = node->ranges[rr_id + 1]->priv_data;
-                    const double next_use_in = next->start_time - t;
-
-                    if (next_use_in < PREFETCH_TIME) {
-                        // The node will actually be needed soon, so we need to
-                        // start it if necessary.
-                        is_active = 1;
-                    } else if (next_use_in < MAX_IDLE_TIME && node->state == STATE_READY) {
-                        // The node will be needed in a slight amount of time;
-                        // a bit longer than a prefetch period so we don't need
-                        // to start it, but in the case where it's actually
-                        // already active it's not worth releasing it to start
-                        // it again soon after, so we keep it active.
-                        is_active = 1;
+    const int stack_size = max_depth + 3;
+    if (!ctx->graph || !ctx->graph_postorder ||
+        ngli_matrix_stack_init(&ctx->modelview, stack_size) < 0 ||
+        ngli_matrix_stack_init(&ctx->projection, stack_size) < 0) {
+        ngli_node_reset_graph(ctx);
+        return -1;
+    }
+
+    int nb_postorder = 0;
+    fill_entries(ctx, ctx->scene, -1, 1, &ctx->nb_graph_entries, &nb_postorder);
+    ngli_assert(ctx->nb_graph_entries == nb_entries);
+    ngli_assert(nb_postorder == nb_entries);
+
+    for (int i = 0; i < nb_entries; i++) {
+        struct ngl_node *node = ctx->graph[ctx->graph_postorder[i]].node;
+        node->can_update_async = node->graph_refs == 1 && is_update_gl_free(node) &&
+                                 !has_shared_range_once(node);
+        for (int j = node->nb_base_children; j < node->nb_children; j++)
+            node->can_update_async &= node->children[j].node->can_update_async;
+    }
+
+    LOG(DEBUG, "compiled scene %s into %d entries", ctx->scene->name, nb_entries);
+    return 0;
+}
+
+static int64_t get_latency(int64_t duration, int64_t class_avg, int class_nb)
+{
+    if (duration >= 0)
+        return duration;
+    return class_nb ? class_avg : -1;
+}
+
+/*
+ * Estimate the time needed to get the node ready from its current state, or
+ * -1 if neither the node nor its class has been measured yet.
+ */
+static int64_t get_start_latency(const struct ngl_ctx *ctx, const struct ngl_node *node)
+{
+    const struct class_latency *cl = &ctx->class_latency[node->class->id];
+    int64_t latency = 0;
+
+    if (node->state == STATE_UNINITIALIZED && node->class->init) {
+        const int64_t init = get_latency(node->init_duration, cl->init, cl->nb_inits);
+        if (init < 0)
+            return -1;
+        latency += init;
+    }
+
+    if (node->state != STATE_READY && node->class->prefetch) {
+        const int64_t prefetch = get_latency(node->prefetch_duration, cl->prefetch, cl->nb_prefetches);
+        if (prefetch < 0)
+            return -1;
+        latency += prefetch;
+    }
+
+    return latency;
+}
+
+/*
+ * The nodes of a subtree are started one after the other, so their latencies
+ * add up. The sums of all the subtrees are computed in a single pass over the
+ * graph in post-order, where the children come before their parent.
+ */
+static void compute_subtree_latencies(struct ngl_ctx *ctx)
+{
+    for (int i = 0; i < ctx->nb_graph_entries; i++) {
+        struct graph_entry *e = &ctx->graph[i];
+        e->latency = get_start_latency(ctx, e->node);
+    }
+
+    for (int i = 0; i < ctx->nb_graph_entries; i++) {
+        const struct graph_entry *e = &ctx->graph[ctx->graph_postorder[i]];
+        if (e->parent < 0)
+            continue;
+
+        struct graph_entry *parent = &ctx->graph[e->parent];
+        if (e->latency < 0 || parent->latency < 0)
+            parent->latency = -1;
+        else
+            parent->latency += e->latency;
+    }
+}
+
+/*
+ * Time ahead of its next use at which the subtree of a graph entry must be
+ * prefetched. Until the latencies of the whole subtree are known, the default
+ * lead time is used.
+ */
+static double get_prefetch_time(const struct ngl_ctx *ctx, int entry_id)
+{
+    const struct graph_entry *e = &ctx->graph[entry_id];
+
+    if (e->node->prefetch_time >= 0)
+        return e->node->prefetch_time;
+
+    if (e->latency < 0)
+        return DEFAULT_PREFETCH_TIME;
+
+    return e->latency / 1000000. + ctx->prefetch_margin;
+}
+
+// TODO: render once
+static void check_activity(struct ngl_ctx *ctx, double t)
+{
+    int i = 0;
+
+    compute_subtree_latencies(ctx);
+
+    while (i < ctx->nb_graph_entries) {
+        const struct graph_entry *e = &ctx->graph[i];
+        struct ngl_node *node = e->node;
+        const int parent_is_active = e->parent < 0 ? 1 : ctx->graph[e->parent].node->is_active;
+        int is_active = parent_is_active;
+
+        int ret = ngli_node_init(node);
+        if (ret < 0) {
+            i = e->next;
+            continue;
+        }
+
+        /*
+         * The life of the parent takes over the life of its children: if the
+         * parent is dead, the children are likely dead as well. However, a
+         * living children from a dead parent can be revealed by another living
+         * branch.
+         */
+        if (parent_is_active) {
+            const int rr_id = update_rr_state(node, t);
+
+            if (rr_id >= 0) {
+                struct ngl_node *rr = node->ranges[rr_id];
+
+                node->current_range = rr_id;
+
+                if (rr->class->id == NGL_NODE_RENDERRANGENORENDER) {
+                    is_active = 0;
+
+                    if (rr_id < node->nb_ranges - 1) {
+                        // We assume here the next range requires the node
+                        // started as the current one doesn't.
+                        const struct renderrange *next = node->ranges[rr_id + 1]->priv_data;
+                        const double next_use_in = next->start_time - t;
+                        const double prefetch_time = get_prefetch_time(ctx, i);
+
+                        if (next_use_in < prefetch_time) {
+                            // The node will actually be needed soon, so we
+                            // need to start it if necessary.
+                            is_active = 1;
+                        } else if (next_use_in < prefetch_time + KEEP_ALIVE_TIME &&
+                                   node->state == STATE_READY) {
+                            // The node will be needed in a slight amount of
+                            // time; a bit longer than a prefetch period so we
+                            // don't need to start it, but in the case where
+                            // it's actually already active it's not worth
+                            // releasing it to start it again soon after, so
+                            // we keep it active.
+                            is_active = 1;
+                        }
                     }
                 }
             }
         }
+
+        /*
+         * If a node is inactive and is already in a dead state, there is no
+         * need to check for resources below as we can assume they were
+         * already released as well (unless they're shared with another
+         * branch) by honor_release_prefetch().
+         *
+         * On the other hand, we cannot do the same if the node is active,
+         * because we have to mark every node below for activity to prevent an
+         * early release from another branch.
+         */
+        if (!is_active && node->state == STATE_IDLE) {
+            i = e->next;
+            continue;
+        }
+
+        if (node->active_time != t) {
+            // If we never passed through this node for that given time, the
+            // new active state takes over to replace the one from a previous
+            // update.
+            node->is_active = is_active;
+            node->active_time = t;
+        } else {
+            // This is not the first time we come across that node, so if it's
+            // needed in that part of the branch we mark it as active so it
+            // doesn't get released.
+            node->is_active |= is_active;
+        }
+
+        i++;
     }
+}
 
-    /*
-     * If a node is inactive and is already in a dead state, there is no need
-     * to check for resources below as we can assume they were already released
-     * as well (unless they're shared with another branch) by
-     * honor_release_prefetch().
-     *
-     * On the other hand, we cannot do the same if the node is active, because
-     * we have to mark every node below for activity to prevent an early
-     * release from another branch.
-     */
-    if (!is_active && node->state == STATE_IDLE)
+static void prefetch_job(struct glcontext *glcontext, void *arg)
+{
+    struct ngl_node *node = arg;
+    LOG(DEBUG, "PREFETCH %s @ %p (loader)", node->name, node);
+    trace_node(node, NGLI_TRACE_PREFETCH, 'B', NAN);
+    const int64_t start = ngli_gettime();
+    node->class->prefetch(node);
+    node->prefetch_duration = ngli_gettime() - start;
+    trace_node(node, NGLI_TRACE_PREFETCH, 'E', NAN);
+}
+
+/*
+ * Hand the prefetch over to the loader thread when possible. The node becomes
+ * ready in a later frame once the job is complete, or as soon as it is
+ * actually needed by an update (ngli_node_prefetch() then waits for the job).
+ */
+static void prefetch_async(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+
+    if (node->state == STATE_READY || node->evicted)
         return;
 
-    if (node->active_time != t) {
-        // If we never passed through this node for that given time, the new
-        // active state takes over to replace the one from a previous update.
-        node->is_active = is_active;
-        node->active_time = t;
-    } else {
-        // This is not the first time we come across that node, so if it's
-        // needed in that part of the branch we mark it as active so it doesn't
-        // get released.
-        node->is_active |= is_active;
+    if (node->prefetch_job) {
+        if (ngli_loader_is_done(ctx->loader, node->prefetch_job))
+            ngli_node_prefetch(node);
+        return;
+    }
+
+    if (!ctx->loader || !node->class->async_prefetch) {
+        ngli_node_prefetch(node);
+        return;
     }
 
+    int ret = ngli_node_init(node);
+    if (ret < 0)
+        return;
+
+    node->prefetch_job = ngli_loader_submit(ctx->loader, prefetch_job, node);
+    if (!node->prefetch_job)
+        ngli_node_prefetch(node);
+}
+
+static int is_kept_prepared(const struct ngl_ctx *ctx, const struct ngl_node *node, double t)
+{
+    return node->is_prepared && t >= ctx->prepare_start && t <= ctx->prepare_end;
+}
+
+static void honor_release_prefetch(struct ngl_ctx *ctx, double t)
+{
     /*
-     * Now we check activity for all the children
-     *
-     * Note: this is currently only needed for private options as the base node
-     * doesn't contain anything worth prefetching or releasing.
+     * A subtree is only honored if every node on the path leading to it has
+     * been crawled for that given time.
      */
-    uint8_t *base_ptr = node->priv_data;
-    const struct node_param *par = node->class->params;
+    for (int i = 0; i < ctx->nb_graph_entries; i++) {
+        struct graph_entry *e = &ctx->graph[i];
+        const int parent_honor = e->parent < 0 ? 1 : ctx->graph[e->parent].honor;
+        e->honor = parent_honor && e->node->active_time == t;
+    }
 
-    while (par && par->key) {
-        switch (par->type) {
-            case PARAM_TYPE_NODE: {
-                uint8_t *child_p = base_ptr + par->offset;
-                struct ngl_node *child = *(struct ngl_node **)child_p;
-                if (child)
-                    check_activity(child, t, node->is_active);
-                break;
-            }
-            case PARAM_TYPE_NODELIST: {
-                uint8_t *elems_p = base_ptr + par->offset;
-                uint8_t *nb_elems_p = base_ptr + par->offset + sizeof(struct ngl_node **);
-                struct ngl_node **elems = *(struct ngl_node ***)elems_p;
-                const int nb_elems = *(int *)nb_elems_p;
-                for (int i = 0; i < nb_elems; i++)
-                    check_activity(elems[i], t, node->is_active);
-                break;
-            }
-            case PARAM_TYPE_NODEDICT: {
-                struct ndict *ndict = *(struct ndict **)(base_ptr + par->offset);
-                struct ndict_entry *entry = NULL;
-                while ((entry = ngli_ndict_get(ndict, NULL, entry)))
-                    check_activity(entry->node, t, node->is_active);
-                break;
-            }
-        }
-        par++;
+    /* Children are released or prefetched before their parents */
+    for (int i = 0; i < ctx->nb_graph_entries; i++) {
+        const struct graph_entry *e = &ctx->graph[ctx->graph_postorder[i]];
+        if (!e->honor)
+            continue;
+        if (e->node->is_active)
+            prefetch_async(e->node);
+        else if (!is_kept_prepared(ctx, e->node, t))
+            ngli_node_release(e->node);
     }
 }
 
-static void honor_release_prefetch(struct ngl_node *node, double t)
+/*
+ * Mark every ancestor of a dirty node as dirty as well, so the static subtrees
+ * leading to it are not skipped during the update.
+ */
+static void propagate_dirty(struct ngl_ctx *ctx)
 {
-    uint8_t *base_ptr = node->priv_data;
-    const struct node_param *par = node->class->params;
+    for (int i = 0; i < ctx->nb_graph_entries; i++) {
+        const struct graph_entry *e = &ctx->graph[ctx->graph_postorder[i]];
+        struct ngl_node *node = e->node;
+        if (!node->dirty)
+            continue;
+        if (e->parent >= 0)
+            ctx->graph[e->parent].node->dirty = 1;
+    }
+}
 
-    if (node->active_time != t)
+/*
+ * A node can only be updated from a worker thread if its whole subtree is
+ * ready, since the initialization and prefetch operations may require GL.
+ */
+static void check_async_updates(struct ngl_ctx *ctx)
+{
+    for (int i = 0; i < ctx->nb_graph_entries; i++) {
+        struct ngl_node *node = ctx->graph[ctx->graph_postorder[i]].node;
+        node->update_async = node->can_update_async && node->state == STATE_READY;
+        for (int j = node->nb_base_children; j < node->nb_children; j++)
+            node->update_async &= node->children[j].node->update_async;
+    }
+}
+
+/*
+ * Initializing a Shader only submits the compilation of its program, so doing
+ * it for the whole graph at once lets the driver compile all the programs
+ * concurrently instead of waiting for each of them in turn when the
+ * TexturedShapes are initialized.
+ */
+void ngli_node_submit_shaders(struct ngl_ctx *ctx)
+{
+    if (ctx->shaders_submitted)
         return;
 
-    while (par && par->key) {
-        switch (par->type) {
-            case PARAM_TYPE_NODE: {
-                uint8_t *child_p = base_ptr + par->offset;
-                struct ngl_node *child = *(struct ngl_node **)child_p;
-                if (child)
-                    honor_release_prefetch(child, t);
-                break;
-            }
-            case PARAM_TYPE_NODELIST: {
-                uint8_t *elems_p = base_ptr + par->offset;
-                uint8_t *nb_elems_p = base_ptr + par->offset + sizeof(struct ngl_node **);
-                struct ngl_node **elems = *(struct ngl_node ***)elems_p;
-                const int nb_elems = *(int *)nb_elems_p;
-                for (int i = 0; i < nb_elems; i++)
-                    honor_release_prefetch(elems[i], t);
-                break;
-            }
-            case PARAM_TYPE_NODEDICT: {
-                struct ndict *ndict = *(struct ndict **)(base_ptr + par->offset);
-                struct ndict_entry *entry = NULL;
-                while ((entry = ngli_ndict_get(ndict, NULL, entry)))
-                    honor_release_prefetch(entry->node, t);
-                break;
-            }
-        }
-        par++;
+    for (int i = 0; i < ctx->nb_graph_entries; i++) {
+        struct ngl_node *node = ctx->graph[i].node;
+        if (node->class->id == NGL_NODE_SHADER)
+            ngli_node_init(node);
     }
+    ctx->shaders_submitted = 1;
+}
 
-    if (node->is_active)
-        ngli_node_prefetch(node);
-    else
+int ngli_node_finalize_shaders(struct ngl_ctx *ctx)
+{
+    int ret = 0;
+
+    ngli_node_submit_shaders(ctx);
+
+    for (int i = 0; i < ctx->nb_graph_entries; i++) {
+        struct ngl_node *node = ctx->graph[i].node;
+        if (node->class->id != NGL_NODE_SHADER)
+            continue;
+        if (ngli_node_init(node) < 0 || ngli_shader_finalize(node) < 0)
+            ret = -1;
+    }
+
+    return ret;
+}
+
+void ngli_node_check_resources(struct ngl_ctx *ctx, double t)
+{
+    ngli_node_submit_shaders(ctx);
+    check_activity(ctx, t);
+    honor_release_prefetch(ctx, t);
+    propagate_dirty(ctx);
+    if (ctx->threadpool)
+        check_async_updates(ctx);
+}
+
+void ngli_node_set_gpu_memory(struct ngl_node *node, int type, size_t size)
+{
+    struct ngl_ctx *ctx = node->ctx;
+
+    ctx->gpu_memory[type] += size - node->gpu_memory;
+    ctx->gpu_memory_total += size - node->gpu_memory;
+    node->gpu_memory = size;
+}
+
+static int compare_last_use(const void *p1, const void *p2)
+{
+    const struct ngl_node *n1 = *(const struct ngl_node **)p1;
+    const struct ngl_node *n2 = *(const struct ngl_node **)p2;
+    return (n1->last_use > n2->last_use) - (n1->last_use < n2->last_use);
+}
+
+/*
+ * Release the least recently used nodes holding GPU memory among the ones
+ * which are ready but were not used in the current frame (the nodes kept
+ * around because they are needed soon), until the budget is honored. Only
+ * the memory freed by the release callbacks (textures) can be reclaimed this
+ * way.
+ */
+void ngli_node_honor_gpu_memory_budget(struct ngl_ctx *ctx)
+{
+    if (!ctx->gpu_memory_budget || ctx->gpu_memory_total <= ctx->gpu_memory_budget)
+        return;
+
+    struct ngl_node **candidates = calloc(ctx->nb_graph_entries, sizeof(*candidates));
+    if (!candidates)
+        return;
+
+    int nb_candidates = 0;
+    for (int i = 0; i < ctx->nb_graph_entries; i++) {
+        struct ngl_node *node = ctx->graph[i].node;
+        if (node->state != STATE_READY || !node->gpu_memory || !node->class->release ||
+            node->last_use == ctx->frame_index || node->evicted)
+            continue;
+        node->evicted = 1; /* also prevents duplicates in the list */
+        candidates[nb_candidates++] = node;
+    }
+
+    qsort(candidates, nb_candidates, sizeof(*candidates), compare_last_use);
+
+    int i;
+    for (i = 0; i < nb_candidates && ctx->gpu_memory_total > ctx->gpu_memory_budget; i++) {
+        struct ngl_node *node = candidates[i];
+        LOG(DEBUG, "GPU memory budget exceeded (%zu > %zu bytes), evict %s (%zu bytes)",
+            ctx->gpu_memory_total, ctx->gpu_memory_budget, node->name, node->gpu_memory);
         ngli_node_release(node);
+    }
+    for (; i < nb_candidates; i++)
+        candidates[i]->evicted = 0;
+
+    if (ctx->gpu_memory_total > ctx->gpu_memory_budget)
+        LOG(DEBUG, "GPU memory budget still exceeded: %zu > %zu bytes",
+            ctx->gpu_memory_total, ctx->gpu_memory_budget);
+
+    free(candidates);
 }
 
-void ngli_node_check_resources(struct ngl_node *node, double t)
+/*
+ * Check if the render ranges of a node require it at some point of the given
+ * time window. The ranges must have been sorted (by ngli_node_init()).
+ */
+static int is_needed_within(const struct ngl_node *node, double t_start, double t_end)
 {
-    check_activity(node, t, 1);
-    honor_release_prefetch(node, t);
+    if (!node->nb_ranges)
+        return 1;
+
+    const struct renderrange *first = node->ranges[0]->priv_data;
+    if (t_start < first->start_time)
+        return 1;
+
+    for (int i = 0; i < node->nb_ranges; i++) {
+        const struct ngl_node *rr = node->ranges[i];
+        const struct renderrange *range = rr->priv_data;
+
+        if (rr->class->id == NGL_NODE_RENDERRANGENORENDER)
+            continue;
+        if (range->start_time > t_end)
+            break;
+        if (i == node->nb_ranges - 1)
+            return 1;
+
+        const struct renderrange *next = node->ranges[i + 1]->priv_data;
+        if (next->start_time > t_start)
+            return 1;
+    }
+
+    return 0;
+}
+
+int ngli_node_prepare(struct ngl_ctx *ctx, double t_start, double t_end,
+                      ngl_progress_callback_type callback, void *arg)
+{
+    const int nb_entries = ctx->nb_graph_entries;
+    int *needed = calloc(nb_entries, sizeof(*needed));
+    if (!needed)
+        return -1;
+
+    ngli_node_submit_shaders(ctx);
+
+    for (int i = 0; i < nb_entries; i++) {
+        ctx->graph[i].node->is_prepared = 0;
+        ctx->graph[i].node->is_prepare_done = 0;
+    }
+
+    /*
+     * A node is needed if it is needed by itself and if its parent is needed
+     * as well (along that path). The nodes are counted once even if they
+     * appear in multiple paths.
+     */
+    int ret = 0;
+    int nb_todo = 0;
+    for (int i = 0; i < nb_entries; i++) {
+        const struct graph_entry *e = &ctx->graph[i];
+        struct ngl_node *node = e->node;
+        const int parent_needed = e->parent < 0 ? 1 : needed[e->parent];
+
+        if (!parent_needed)
+            continue;
+
+        if (ngli_node_init(node) < 0) {
+            ret = -1;
+            continue;
+        }
+
+        needed[i] = is_needed_within(node, t_start, t_end);
+        if (!needed[i] || node->is_prepared)
+            continue;
+
+        node->is_prepared = 1;
+        if (node->state != STATE_READY)
+            nb_todo++;
+    }
+
+    LOG(DEBUG, "prepare %d nodes for [%f,%f]", nb_todo, t_start, t_end);
+
+    /*
+     * Children are prefetched before their parents, same as in the draw. The
+     * progress is counted per node, not per path, to match nb_todo.
+     */
+    int nb_done = 0;
+    for (int i = 0; i < nb_entries; i++) {
+        const int id = ctx->graph_postorder[i];
+        struct ngl_node *node = ctx->graph[id].node;
+
+        if (!needed[id] || node->state == STATE_READY || node->is_prepare_done)
+            continue;
+
+        ngli_node_prefetch(node);
+        if (node->state != STATE_READY)
+            ret = -1;
+        node->is_prepare_done = 1;
+        nb_done++;
+        if (callback)
+            callback(arg, nb_done, nb_todo);
+    }
+
+    ctx->prepare_start = t_start;
+    ctx->prepare_end = t_end;
+
+    free(needed);
+    return ret;
 }
 
 void ngli_node_prefetch(struct ngl_node *node)
@@ -691,93 +1407,205 @@ void ngli_node_prefetch(struct ngl_node *node)
     if (node->state == STATE_READY)
         return;
 
-    int ret = ngli_node_init(node);
-    if (ret < 0)
-        return;
+    if (node->prefetch_job) {
+        ngli_loader_wait(node->ctx->loader, &node->prefetch_job);
+        if (node->ctx->stats_enabled)
+            ngli_stats_add_time(node, NGLI_STATS_PREFETCH, node->prefetch_duration);
+    } else {
+        int ret = ngli_node_init(node);
+        if (ret < 0)
+            return;
+
+        if (node->class->prefetch) {
+            LOG(DEBUG, "PREFETCH %s @ %p", node->name, node);
+            struct stats_probe probe;
+            if (node->ctx->stats_enabled)
+                ngli_stats_probe_start(node->ctx, &probe);
+            trace_node(node, NGLI_TRACE_PREFETCH, 'B', NAN);
+            const int64_t start = ngli_gettime();
+            node->class->prefetch(node);
+            node->prefetch_duration = ngli_gettime() - start;
+            trace_node(node, NGLI_TRACE_PREFETCH, 'E', NAN);
+            if (node->ctx->stats_enabled)
+                ngli_stats_probe_end(node, NGLI_STATS_PREFETCH, &probe);
+        }
+    }
 
     if (node->class->prefetch) {
-        LOG(DEBUG, "PREFETCH %s @ %p", node->name, node);
-        node->class->prefetch(node);
+        struct class_latency *cl = &node->ctx->class_latency[node->class->id];
+        record_latency(&cl->prefetch, &cl->nb_prefetches, node->prefetch_duration);
     }
+
     node->state = STATE_READY;
+    node->evicted = 0;
+    node->dirty = 1;
+}
+
+static void update_entries(struct ngl_ctx *ctx, int root, double t);
+
+static void update_task(void *arg)
+{
+    struct graph_entry *e = arg;
+    struct ngl_ctx *ctx = e->node->ctx;
+    update_entries(ctx, e - ctx->graph, ctx->graph[e->parent].t);
+}
+
+/*
+ * Dispatch the update of the children of a Group which can be updated
+ * asynchronously to the thread pool, and update the others from the current
+ * thread meanwhile. Groups nested in a subtree already being updated by the
+ * pool are updated sequentially.
+ */
+static int update_children_threaded(struct ngl_ctx *ctx, int id)
+{
+    const struct graph_entry *e = &ctx->graph[id];
+
+    if (e->node->class->id != NGL_NODE_GROUP || !ctx->threadpool || ctx->threaded_update)
+        return -1;
+
+    int nb_async = 0;
+    for (int i = id + 1; i < e->next; i = ctx->graph[i].next)
+        nb_async += ctx->graph[i].node->update_async;
+    if (nb_async < 2)
+        return -1;
+
+    ctx->threaded_update = 1;
+
+    for (int i = id + 1; i < e->next; i = ctx->graph[i].next) {
+        struct graph_entry *child = &ctx->graph[i];
+        if (!child->node->update_async || ngli_threadpool_submit(ctx->threadpool, update_task, child) < 0)
+            update_task(child);
+    }
+
+    ngli_threadpool_wait(ctx->threadpool);
+
+    ctx->threaded_update = 0;
+
+    return 0;
 }
 
+/*
+ * Update the subtree of a graph entry, the children of every node being
+ * updated before the node itself. The update of a node is completed when the
+ * crawling reaches the end of its subtree.
+ */
+static void update_entries(struct ngl_ctx *ctx, int root, double t)
+{
+    struct graph_entry *graph = ctx->graph;
+    const int end = graph[root].next;
+    int i = root;
+
+    while (i < end) {
+        struct graph_entry *e = &graph[i];
+
+        e->t = i == root ? t : graph[e->parent].t;
+        if (node_update_begin(e->node, &e->t, &e->probe)) {
+            if (e->next > i + 1 && update_children_threaded(ctx, i) < 0) {
+                i++;
+                continue;
+            }
+            node_update_end(e->node, e->t, &e->probe);
+        }
+
+        for (int p = e->parent; p >= root && graph[p].next == e->next; p = graph[p].parent)
+            node_update_end(graph[p].node, graph[p].t, &graph[p].probe);
+
+        i = e->next;
+    }
+}
+
+void ngli_node_update_graph(struct ngl_ctx *ctx, double t)
+{
+    if (ctx->nb_graph_entries)
+        update_entries(ctx, 0, t);
+}
+
+/*
+ * Recursive update of a node which is not part of the compiled graph (drawn
+ * internally by another node).
+ */
 void ngli_node_update(struct ngl_node *node, double t)
 {
-    int ret = ngli_node_init(node);
-    if (ret < 0)
+    struct stats_probe probe;
+    if (!node_update_begin(node, &t, &probe))
         return;
-    if (node->class->update)
-        node_update(node, t);
+    for (int i = node->nb_base_children; i < node->nb_children; i++)
+        ngli_node_update(node->children[i].node, t);
+    node_update_end(node, t, &probe);
 }
 
 void ngli_honor_glstates(struct ngl_ctx *ctx, int nb_glstates, struct ngl_node **glstates)
 {
     struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
 
     for (int i = 0; i < nb_glstates; i++) {
         struct ngl_node *glstate_node = glstates[i];
         struct glstate *glstate = glstate_node->priv_data;
 
         if (glstate_node->class->id == NGL_NODE_GLBLENDSTATE) {
-            ngli_glGetIntegerv(gl, glstate->capability, (GLint *)&glstate->enabled[1]);
+            glstate->enabled[1] = ngli_glcache_is_enabled(glcontext, glstate->capability);
+            ngli_glcache_set_enabled(glcontext, glstate->capability, glstate->enabled[0]);
             if (glstate->enabled[0]) {
-                ngli_glGetIntegerv(gl, GL_BLEND_SRC_RGB, (GLint *)&glstate->src_rgb[1]);
-                ngli_glGetIntegerv(gl, GL_BLEND_DST_RGB, (GLint *)&glstate->dst_rgb[1]);
-                ngli_glGetIntegerv(gl, GL_BLEND_SRC_ALPHA, (GLint *)&glstate->src_alpha[1]);
-                ngli_glGetIntegerv(gl, GL_BLEND_DST_ALPHA, (GLint *)&glstate->dst_alpha[1]);
-                ngli_glGetIntegerv(gl, GL_BLEND_EQUATION_RGB, (GLint *)&glstate->mode_rgb[1]);
-                ngli_glGetIntegerv(gl, GL_BLEND_EQUATION_ALPHA, (GLint *)&glstate->mode_alpha[1]);
-
-                ngli_glEnable(gl, glstate->capability);
-                ngli_glBlendFuncSeparate(gl, glstate->src_rgb[0], glstate->dst_rgb[0],
-                                    glstate->src_alpha[0], glstate->dst_alpha[0]);
-                ngli_glBlendEquationSeparate(gl, glstate->mode_rgb[0], glstate->mode_alpha[0]);
-            } else {
-                ngli_glDisable(gl, glstate->capability);
+                const struct glcache_blend *blend = ngli_glcache_get_blend(glcontext);
+                glstate->src_rgb[1]    = blend->src_rgb;
+                glstate->dst_rgb[1]    = blend->dst_rgb;
+                glstate->src_alpha[1]  = blend->src_alpha;
+                glstate->dst_alpha[1]  = blend->dst_alpha;
+                glstate->mode_rgb[1]   = blend->mode_rgb;
+                glstate->mode_alpha[1] = blend->mode_alpha;
+
+                const struct glcache_blend new_blend = {
+                    .src_rgb    = glstate->src_rgb[0],
+                    .dst_rgb    = glstate->dst_rgb[0],
+                    .src_alpha  = glstate->src_alpha[0],
+                    .dst_alpha  = glstate->dst_alpha[0],
+                    .mode_rgb   = glstate->mode_rgb[0],
+                    .mode_alpha = glstate->mode_alpha[0],
+                };
+                ngli_glcache_set_blend(glcontext, &new_blend);
             }
         } else if (glstate_node->class->id == NGL_NODE_GLCOLORSTATE) {
-            GLboolean rgba[4];
-
-            ngli_glGetBooleanv(gl, GL_COLOR_WRITEMASK, rgba);
+            const GLboolean *rgba = ngli_glcache_get_color_mask(glcontext);
 
             glstate->rgba[1][0] = rgba[0];
             glstate->rgba[1][1] = rgba[1];
             glstate->rgba[1][2] = rgba[2];
             glstate->rgba[1][3] = rgba[3];
 
-            ngli_glColorMask(gl, glstate->rgba[0][0],
-                          glstate->rgba[0][1],
-                          glstate->rgba[0][2],
-                          glstate->rgba[0][3]);
+            const GLboolean new_rgba[4] = {
+                glstate->rgba[0][0],
+                glstate->rgba[0][1],
+                glstate->rgba[0][2],
+                glstate->rgba[0][3],
+            };
+            ngli_glcache_set_color_mask(glcontext, new_rgba);
         } else if (glstate_node->class->id == NGL_NODE_GLSTENCILSTATE) {
-            ngli_glGetIntegerv(gl, glstate->capability, (GLint *)&glstate->enabled[1]);
+            glstate->enabled[1] = ngli_glcache_is_enabled(glcontext, glstate->capability);
+            ngli_glcache_set_enabled(glcontext, glstate->capability, glstate->enabled[0]);
             if (glstate->enabled[0]) {
-                ngli_glGetIntegerv(gl, GL_STENCIL_WRITEMASK, (GLint *)&glstate->writemask[1]);
-                ngli_glGetIntegerv(gl, GL_STENCIL_FUNC, (GLint *)&glstate->func[1]);
-                ngli_glGetIntegerv(gl, GL_STENCIL_REF, (GLint *)&glstate->func_ref[1]);
-                ngli_glGetIntegerv(gl, GL_STENCIL_VALUE_MASK, (GLint *)&glstate->func_mask[1]);
-                ngli_glGetIntegerv(gl, GL_STENCIL_FAIL, (GLint *)&glstate->op_sfail[1]);
-                ngli_glGetIntegerv(gl, GL_STENCIL_PASS_DEPTH_FAIL, (GLint *)&glstate->op_dpfail[1]);
-                ngli_glGetIntegerv(gl, GL_STENCIL_PASS_DEPTH_PASS, (GLint *)&glstate->op_dppass[1]);
-
-                ngli_glEnable(gl, glstate->capability);
-                ngli_glStencilMask(gl, glstate->writemask[0]);
-                ngli_glStencilFunc(gl, glstate->func[0], glstate->func_ref[0], glstate->func_mask[0]);
-                ngli_glStencilOp(gl, glstate->op_sfail[0], glstate->op_dpfail[0], glstate->op_dppass[0]);
-            } else {
-                ngli_glDisable(gl, glstate->capability);
+                const struct glcache_stencil *stencil = ngli_glcache_get_stencil(glcontext);
+                glstate->writemask[1] = stencil->writemask;
+                glstate->func[1]      = stencil->func;
+                glstate->func_ref[1]  = stencil->func_ref;
+                glstate->func_mask[1] = stencil->func_mask;
+                glstate->op_sfail[1]  = stencil->op_sfail;
+                glstate->op_dpfail[1] = stencil->op_dpfail;
+                glstate->op_dppass[1] = stencil->op_dppass;
+
+                const struct glcache_stencil new_stencil = {
+                    .writemask = glstate->writemask[0],
+                    .func      = glstate->func[0],
+                    .func_ref  = glstate->func_ref[0],
+                    .func_mask = glstate->func_mask[0],
+                    .op_sfail  = glstate->op_sfail[0],
+                    .op_dpfail = glstate->op_dpfail[0],
+                    .op_dppass = glstate->op_dppass[0],
+                };
+                ngli_glcache_set_stencil(glcontext, &new_stencil);
             }
         } else {
-            ngli_glGetIntegerv(gl, glstate->capability, (GLint *)&glstate->enabled[1]);
-            if (glstate->enabled[0] != glstate->enabled[1]) {
-                if (glstate->enabled[0]) {
-                    ngli_glEnable(gl, glstate->capability);
-                } else {
-                    ngli_glDisable(gl, glstate->capability);
-                }
-            }
+            glstate->enabled[1] = ngli_glcache_is_enabled(glcontext, glstate->capability);
+            ngli_glcache_set_enabled(glcontext, glstate->capability, glstate->enabled[0]);
         }
     }
 }
@@ -785,60 +1613,99 @@ void ngli_honor_glstates(struct ngl_ctx *ctx, int nb_glstates, struct ngl_node *
 void ngli_restore_glstates(struct ngl_ctx *ctx, int nb_glstates, struct ngl_node **glstates)
 {
     struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
 
     for (int i = 0; i < nb_glstates; i++) {
         struct ngl_node *glstate_node = glstates[i];
         struct glstate *glstate = glstates[i]->priv_data;
         if (glstate_node->class->id == NGL_NODE_GLBLENDSTATE) {
-            if (glstate->enabled[1]) {
-                ngli_glEnable(gl, glstate->capability);
-                ngli_glBlendFuncSeparate(gl, glstate->src_rgb[1], glstate->dst_rgb[1],
-                                    glstate->src_alpha[1], glstate->dst_alpha[1]);
-                ngli_glBlendEquationSeparate(gl, glstate->mode_rgb[1], glstate->mode_alpha[1]);
-            } else {
-                ngli_glDisable(gl, glstate->capability);
+            if (glstate->enabled[0]) {
+                const struct glcache_blend blend = {
+                    .src_rgb    = glstate->src_rgb[1],
+                    .dst_rgb    = glstate->dst_rgb[1],
+                    .src_alpha  = glstate->src_alpha[1],
+                    .dst_alpha  = glstate->dst_alpha[1],
+                    .mode_rgb   = glstate->mode_rgb[1],
+                    .mode_alpha = glstate->mode_alpha[1],
+                };
+                ngli_glcache_set_blend(glcontext, &blend);
             }
+            ngli_glcache_set_enabled(glcontext, glstate->capability, glstate->enabled[1]);
         } else if (glstate_node->class->id == NGL_NODE_GLCOLORSTATE) {
-            ngli_glColorMask(gl, glstate->rgba[1][0],
-                          glstate->rgba[1][1],
-                          glstate->rgba[1][2],
-                          glstate->rgba[1][3]);
+            const GLboolean rgba[4] = {
+                glstate->rgba[1][0],
+                glstate->rgba[1][1],
+                glstate->rgba[1][2],
+                glstate->rgba[1][3],
+            };
+            ngli_glcache_set_color_mask(glcontext, rgba);
         } else if (glstate_node->class->id == NGL_NODE_GLSTENCILSTATE) {
-            if (glstate->enabled[1]) {
-                ngli_glEnable(gl, glstate->capability);
-                ngli_glStencilMask(gl, glstate->writemask[1]);
-                ngli_glStencilFunc(gl, glstate->func[1], glstate->func_ref[1], glstate->func_mask[1]);
-                ngli_glStencilOp(gl, glstate->op_sfail[1], glstate->op_dpfail[1], glstate->op_dppass[1]);
-            } else {
-                ngli_glDisable(gl, glstate->capability);
+            if (glstate->enabled[0]) {
+                const struct glcache_stencil stencil = {
+                    .writemask = glstate->writemask[1],
+                    .func      = glstate->func[1],
+                    .func_ref  = glstate->func_ref[1],
+                    .func_mask = glstate->func_mask[1],
+                    .op_sfail  = glstate->op_sfail[1],
+                    .op_dpfail = glstate->op_dpfail[1],
+                    .op_dppass = glstate->op_dppass[1],
+                };
+                ngli_glcache_set_stencil(glcontext, &stencil);
             }
+            ngli_glcache_set_enabled(glcontext, glstate->capability, glstate->enabled[1]);
         } else {
-            if (glstate->enabled[0] != glstate->enabled[1]) {
-                if (glstate->enabled[1]) {
-                    ngli_glEnable(gl, glstate->capability);
-                } else {
-                    ngli_glDisable(gl, glstate->capability);
-                }
+            ngli_glcache_set_enabled(glcontext, glstate->capability, glstate->enabled[1]);
+        }
+    }
+}
+
+/*
+ * Draw the entries marked for drawing in the graph. The children of a node
+ * are drawn between its draw and post_draw callbacks, the latter being called
+ * when the crawling reaches the end of its subtree.
+ */
+void ngli_node_draw_graph(struct ngl_ctx *ctx)
+{
+    struct graph_entry *graph = ctx->graph;
+    int i = 0;
+
+    while (i < ctx->nb_graph_entries) {
+        struct graph_entry *e = &graph[i];
+
+        if (e->draw && node_draw_begin(e->node, &e->probe)) {
+            if (e->next > i + 1) {
+                i++;
+                continue;
             }
+            node_draw_end(e->node, &e->probe);
         }
+
+        for (int p = e->parent; p >= 0 && graph[p].next == e->next; p = graph[p].parent)
+            node_draw_end(graph[p].node, &graph[p].probe);
+
+        i = e->next;
     }
 }
 
+/*
+ * Recursive draw of a node which is not part of the compiled graph (drawn
+ * internally by another node).
+ */
 void ngli_node_draw(struct ngl_node *node)
 {
-    if (!node->drawme) {
-        LOG(VERBOSE, "%s @ %p not marked for drawing, skip it", node->name, node);
+    struct stats_probe probe;
+    if (!is_drawable(node) || !node_draw_begin(node, &probe))
         return;
+    for (int i = node->nb_base_children; i < node->nb_children; i++) {
+        const struct node_child *child = &node->children[i];
+        if (child->par->flags & PARAM_FLAG_DRAW_CHILD)
+            ngli_node_draw(child->node);
     }
+    node_draw_end(node, &probe);
+}
 
-    if (node->class->draw) {
-        LOG(VERBOSE, "DRAW %s @ %p", node->name, node);
-
-        ngli_honor_glstates(node->ctx, node->nb_glstates, node->glstates);
-        node->class->draw(node);
-        ngli_restore_glstates(node->ctx, node->nb_glstates, node->glstates);
-    }
+int64_t ngl_node_get_gpu_time(const struct ngl_node *node)
+{
+    return node->gputimer.time;
 }
 
 const struct node_param *ngli_node_param_find(const struct ngl_node *node, const char *key,
@@ -856,6 +1723,35 @@ const struct node_param *ngli_node_param_find(const struct ngl_node *node, const
     return par;
 }
 
+static int node_params_changed(struct ngl_node *node, const struct node_param *par)
+{
+    if (par->type != PARAM_TYPE_NODE &&
+        par->type != PARAM_TYPE_NODELIST &&
+        par->type != PARAM_TYPE_NODEDICT)
+        return 0;
+
+    /* The topology of the scene changed, so it will need to be recompiled */
+    if (node->ctx)
+        node->ctx->graph_changed = 1;
+
+    return ngli_node_cache_children(node);
+}
+
+/*
+ * A parameter flagged with PARAM_FLAG_ALLOW_LIVE_CHANGE is applied in place on
+ * an initialized node, the class being notified through its live_change
+ * callback (if any). Any other change requires the node to be reinitialized.
+ */
+static void apply_param_change(struct ngl_node *node, const struct node_param *par)
+{
+    if ((par->flags & PARAM_FLAG_ALLOW_LIVE_CHANGE) && node->state != STATE_UNINITIALIZED &&
+        (!node->class->live_change || node->class->live_change(node, par) >= 0))
+        LOG(VERBOSE, "LIVE CHANGE %s.%s", node->name, par->key);
+    else
+        node_uninit(node); // need a reinit after changing options
+    node->dirty = 1;
+}
+
 int ngl_node_param_add(struct ngl_node *node, const char *key,
                        int nb_elems, void *elems)
 {
@@ -869,7 +1765,9 @@ int ngl_node_param_add(struct ngl_node *node, const char *key,
     ret = ngli_params_add(base_ptr, par, nb_elems, elems);
     if (ret < 0)
         LOG(ERROR, "unable to add elements to %s.%s", node->name, key);
-    node_uninit(node); // need a reinit after changing options
+    apply_param_change(node, par);
+    if (node_params_changed(node, par) < 0)
+        return -1;
     return ret;
 }
 
@@ -888,7 +1786,9 @@ int ngl_node_param_set(struct ngl_node *node, const char *key, ...)
     if (ret < 0)
         LOG(ERROR, "unable to set %s.%s", node->name, key);
     va_end(ap);
-    node_uninit(node); // need a reinit after changing options
+    apply_param_change(node, par);
+    if (node_params_changed(node, par) < 0)
+        return -1;
     return ret;
 }
 
@@ -911,7 +1811,10 @@ void ngl_node_unrefp(struct ngl_node **nodep)
         ngli_assert(!node->ctx);
         ngli_params_free((uint8_t *)node, ngli_base_node_params);
         ngli_params_free(node->priv_data, node->class->params);
-        free(node);
+        free(node->children);
+        ngli_timeline_reset(&node->ranges_timeline);
+        ngli_timeline_reset(&node->animkf_timeline);
+        node_free(node);
     }
     *nodep = NULL;
 }
@@ -33,12 +33,32 @@
 #include <CoreVideo/CoreVideo.h>
 #endif
 
+#include "arena.h"
+#include "framering.h"
+#include "framewriter.h"
 #include "glincludes.h"
 #include "glcontext.h"
+#include "gputimer.h"
+#include "loader.h"
+#include "nodegl.h"
 #include "params.h"
+#include "programcache.h"
+#include "stats.h"
+#include "threadpool.h"
+#include "trace.h"
+#include "timeline.h"
 
 struct node_class;
 
+/*
+ * Child node as referenced by one of the parameters of its parent
+ */
+struct node_child {
+    struct ngl_node *node;
+    const struct node_param *par;
+    const char *key; /* entry name if par is a PARAM_TYPE_NODEDICT */
+};
+
 enum {
     STATE_UNINITIALIZED = 0, /* post uninit(), default */
     STATE_INITIALIZED   = 1, /* post init() */
@@ -46,38 +66,196 @@ enum {
     STATE_IDLE          = 3, /* post release() */
 };
 
+/*
+ * Scene graph flattened in depth-first order, with one entry per path from the
+ * root. It is built by ngli_node_compile_graph() and crawled linearly every
+ * frame instead of recursing through the node parameters.
+ */
+struct graph_entry {
+    struct ngl_node *node;
+    int parent; /* index of the parent entry, -1 for the root */
+    int next;   /* index of the first entry following the subtree */
+    int honor;
+    int draw;   /* the node is drawn from this path */
+    int64_t latency; /* start-up latency of the subtree in microseconds, -1 if unknown */
+
+    /* State of the update and draw of the entry while its subtree is crawled */
+    double t;
+    struct stats_probe probe;
+};
+
+/*
+ * Stack of matrices, with the identity at the bottom. The transformations are
+ * pushed on it while drawing, so a node referenced from different paths of
+ * the graph is drawn with the transformations of each path.
+ */
+struct matrix_stack {
+    float *matrices;
+    int depth;
+    int size;
+};
+
+/* GPU memory accounting categories, as exposed by ngl_get_gpu_memory() */
+enum {
+    NGLI_GPU_MEMORY_BUFFERS       = NGL_GPU_MEMORY_BUFFERS,
+    NGLI_GPU_MEMORY_TEXTURES      = NGL_GPU_MEMORY_TEXTURES,
+    NGLI_GPU_MEMORY_RENDERBUFFERS = NGL_GPU_MEMORY_RENDERBUFFERS,
+    NGLI_GPU_MEMORY_NB
+};
+
+/*
+ * Start-up latency of a node class in microseconds, as a moving average of the
+ * durations measured on its instances.
+ */
+struct class_latency {
+    int64_t init;
+    int64_t prefetch;
+    int nb_inits;
+    int nb_prefetches;
+};
+
+#define NGLI_NB_NODE_CLASSES (NGL_NODE_IDENTITY + 1) /* must follow the last class */
+
 struct ngl_ctx {
     struct glcontext *glcontext;
     struct ngl_node *scene;
 
     struct ngl_node **glstates;
     int nb_glstates;
+
+    struct graph_entry *graph;
+    int *graph_postorder;
+    int nb_graph_entries;
+    int graph_changed;
+    int shaders_submitted;
+
+    /* Time window prepared by ngli_node_prepare() */
+    double prepare_start;
+    double prepare_end;
+
+    struct threadpool *threadpool;
+    int threaded_update; /* set while update tasks are running in the pool */
+
+    struct loader *loader; /* optional, see ngl_set_async_prefetch() */
+
+    struct matrix_stack modelview;
+    struct matrix_stack projection;
+
+    /* GPU memory currently allocated by the nodes, per category and in total */
+    size_t gpu_memory[NGLI_GPU_MEMORY_NB];
+    size_t gpu_memory_total;
+    size_t gpu_memory_budget; /* 0 for no limit */
+
+    int64_t frame_index; /* incremented on every draw */
+
+    /*
+     * The prefetch of a node is scheduled ahead of its use according to the
+     * start-up latency measured for its subtree, plus a safety margin (in
+     * seconds, see ngl_set_prefetch_margin()).
+     */
+    struct class_latency class_latency[NGLI_NB_NODE_CLASSES];
+    double prefetch_margin;
+
+    int stats_enabled; /* see ngl_set_stats() */
+    struct stats_counters counters; /* the state changes are counted by the glcontext */
+
+    struct trace *trace; /* optional, see ngl_set_trace() */
+
+    struct programcache programcache;
 };
 
 struct ngl_node {
     const struct node_class *class;
     struct ngl_ctx *ctx;
+    struct arena *arena; /* NULL if the node was allocated on its own */
 
     int refcount;
-    NGLI_ALIGNED_MAT(modelview_matrix);
-    NGLI_ALIGNED_MAT(projection_matrix);
     int state;
 
     double last_update_time;
     int drawme;
 
+    /*
+     * A static node has no time dependent input (animation keyframes, media,
+     * render ranges, ...) in its whole subtree. Its update is skipped unless
+     * it is marked dirty (parameter change, state transition, ...). The static
+     * flag is set by ngli_node_compile_graph().
+     */
+    int is_static;
+    int dirty;
+
+    /*
+     * Number of times the node is referenced in the compiled graph (or as a
+     * render range of the nodes of the graph). A subtree where every node is
+     * only referenced once, does not share a RenderRangeOnce, and does not
+     * involve any GL call during the update can be updated from a worker thread
+     * (can_update_async). The update_async flag additionally requires the
+     * whole subtree to be ready, and is refreshed every frame.
+     */
+    int graph_refs;
+    int can_update_async;
+    int update_async;
+
     struct ngl_node **glstates;
     int nb_glstates;
 
     struct ngl_node **ranges;
     int nb_ranges;
     int current_range;
+    struct timeline ranges_timeline;
+
+    /* Times of the animation keyframes (animkf parameter) of the node, if any */
+    struct timeline animkf_timeline;
 
     int is_active;
     double active_time;
 
+    /*
+     * Set on the nodes prefetched by ngli_node_prepare(); they are kept ready
+     * as long as the time stays in the prepared window of the context.
+     */
+    int is_prepared;
+    int is_prepare_done; /* reported to the progress callback of ngli_node_prepare() */
+
+    /* Pending prefetch in the loader thread; the node is not ready until it completes */
+    struct loader_job *prefetch_job;
+
+    /*
+     * GPU memory allocated by the node itself (a node only allocates in one
+     * category), and index of the last frame where it was used. Nodes evicted
+     * to honor the memory budget are only prefetched again when used.
+     */
+    size_t gpu_memory;
+    int64_t last_use;
+    int evicted;
+
     char *name;
 
+    /*
+     * Prefetch lead time in seconds (prefetch_time parameter, negative for
+     * automatic), and last durations measured for the init and prefetch of the
+     * node, in microseconds (negative if not measured yet).
+     */
+    double prefetch_time;
+    int64_t init_duration;
+    int64_t prefetch_duration;
+
+    /* GPU time of the draw, measured when the measure_gpu parameter is set */
+    int measure_gpu;
+    struct gputimer gputimer;
+
+    struct node_stats stats;
+
+    /*
+     * Cached children from both the base and private parameters, in that
+     * order. The base ones (GL states and render ranges) are handled by the
+     * node itself, so the graph only goes through the children following the
+     * first nb_base_children.
+     */
+    struct node_child *children;
+    int nb_children;
+    int nb_base_children;
+
     void *priv_data;
 };
 
@@ -114,6 +292,16 @@ struct glstate {
     GLenum op_dppass[2];
 };
 
+/*
+ * The frame read back in a PBO is transferred to the writer thread once the
+ * NB_PIPE_PBOS-1 following frames are rendered, which leaves time for the
+ * transfer to complete without stalling the pipeline.
+ */
+#define NB_PIPE_PBOS 3
+
+/* Frames waiting for the writer thread before the rendering blocks */
+#define NB_PIPE_QUEUED_FRAMES 3
+
 struct camera {
     struct ngl_node *child;
     float eye[3];
@@ -131,10 +319,37 @@ struct camera {
 
     int pipe_fd;
     int pipe_width, pipe_height;
-    uint8_t *pipe_buf;
+    const char *pipe_format_str;
+    const char *pipe_colorspace_str;
+    int pipe_format;
+    int pipe_colorspace;
+    int pipe_frame_width;   /* dimensions of the RGBA surface read back, */
+    int pipe_frame_height;  /* holding the YUV planes when converted     */
+    int shm_fd;
+    struct framewriter *pipe_writer;
+    struct framering *pipe_ring;
+    GLuint pipe_pbo_ids[NB_PIPE_PBOS];
+    double pipe_pbo_times[NB_PIPE_PBOS];
+    int nb_pipe_pbos;       /* 0 when the readback is synchronous */
+    int pipe_pbo_index;     /* next PBO to read the framebuffer into */
+    int nb_pipe_pending;    /* PBOs holding a frame not yet queued for writing */
 
     GLuint framebuffer_id;
     GLuint texture_id;
+
+    GLuint yuv_framebuffer_id;
+    GLuint yuv_texture_id;
+    GLuint yuv_vertices_id;
+    GLuint yuv_vao_id;
+    struct program *yuv_program;
+    GLint yuv_position_location_id;
+    GLint yuv_source_location_id;
+    GLint yuv_size_location_id;
+    GLint yuv_luma_location_id;
+    GLint yuv_planar_location_id;
+
+    NGLI_ALIGNED_MAT(view_matrix);
+    NGLI_ALIGNED_MAT(projection_matrix);
 };
 
 struct shapeprimitive {
@@ -173,9 +388,8 @@ struct shape {
 
     GLfloat *vertices;
     int nb_vertices;
-    GLuint vertices_buffer_id;
-    GLuint texcoords_buffer_id;
-    GLuint normals_buffer_id;
+    GLuint vertices_buffer_id; /* interleaved coordinates, texcoords and normals */
+    int vertices_changed; /* the buffer is updated before the next draw */
 
     GLushort *indices;
     int nb_indices;
@@ -186,6 +400,8 @@ struct shape {
 };
 
 void ngli_shape_generate_buffers(struct ngl_node *node);
+void ngli_shape_release_buffers(struct ngl_node *node);
+void ngli_shape_sync_buffers(struct ngl_node *node);
 
 struct uniform {
     double scalar;
@@ -211,12 +427,17 @@ struct rtt {
     int height;
     GLuint framebuffer_id;
     GLuint renderbuffer_id;
+
+    /* Restored once the child is drawn */
+    GLuint prev_framebuffer_id;
+    GLint prev_viewport[4];
 };
 
 struct shader {
     const char *vertex_data;
     const char *fragment_data;
 
+    struct program *program;
     GLuint program_id;
     GLint position_location_id;
     GLint normal_location_id;
@@ -225,6 +446,12 @@ struct shader {
     GLint normal_matrix_location_id;
 };
 
+/*
+ * The Shader init only submits the program compilation; this waits for its
+ * completion and fetches the locations of the builtin attributes/uniforms.
+ */
+int ngli_shader_finalize(struct ngl_node *node);
+
 struct texture {
     GLenum target;
     GLint format;
@@ -239,6 +466,8 @@ struct texture {
     struct ngl_node *data_src;
     GLuint external_id;
 
+    int params_changed; /* sampling parameters to apply on the next update */
+
     NGLI_ALIGNED_MAT(coordinates_matrix);
     GLuint id;
     GLuint local_id;
@@ -257,6 +486,12 @@ struct texture {
 #endif
 };
 
+/* Account the GPU memory of the local texture storage after a (re)allocation */
+void ngli_texture_set_gpu_memory(struct ngl_node *node, int width, int height);
+
+/* Account the bytes of a frame uploaded to the texture in the statistics */
+void ngli_texture_count_upload(struct ngl_node *node, int width, int height);
+
 struct textureshaderinfo {
     int sampler_id;
     int coordinates_id;
@@ -316,6 +551,8 @@ struct rotate {
     struct ngl_node **animkf;
     int nb_animkf;
     int current_kf;
+
+    NGLI_ALIGNED_MAT(matrix);
 };
 
 struct translate {
@@ -324,6 +561,8 @@ struct translate {
     struct ngl_node **animkf;
     int nb_animkf;
     int current_kf;
+
+    NGLI_ALIGNED_MAT(matrix);
 };
 
 struct scale {
@@ -333,12 +572,15 @@ struct scale {
     struct ngl_node **animkf;
     int nb_animkf;
     int current_kf;
+
+    NGLI_ALIGNED_MAT(matrix);
 };
 
 typedef double easing_type;
 typedef easing_type (*easing_function)(easing_type, int, const easing_type *);
 
-void ngli_animkf_interpolate(float *dst, struct ngl_node **animkf, int nb_animkf,
+void ngli_animkf_interpolate(float *dst, const struct timeline *tl,
+                             struct ngl_node **animkf, int nb_animkf,
                              int *current_kf, double t);
 
 struct animkeyframe {
@@ -359,6 +601,7 @@ struct fps {
     int create_databuf;
     int64_t update_start;
     int64_t update_end;
+    int64_t draw_start;
     uint8_t *data_buf;
     int data_w, data_h;
 };
@@ -404,11 +647,24 @@ struct node_class {
     const char *name;
     int (*init)(struct ngl_node *node);
     void (*prefetch)(struct ngl_node *node);
+
+    /*
+     * The children of a node are updated between its pre_update and update
+     * callbacks, and the children referenced by the parameters flagged with
+     * PARAM_FLAG_DRAW_CHILD are drawn between its draw and post_draw
+     * callbacks. Node classes never update nor draw their children by
+     * themselves.
+     */
+    void (*pre_update)(struct ngl_node *node, double t);
     void (*update)(struct ngl_node *node, double t);
     void (*draw)(struct ngl_node *node);
+    void (*post_draw)(struct ngl_node *node);
+
     void (*release)(struct ngl_node *node);
     void (*uninit)(struct ngl_node *node);
+    int (*live_change)(struct ngl_node *node, const struct node_param *par);
     char *(*info_str)(const struct ngl_node *node);
+    int async_prefetch; /* the prefetch callback can run in the loader thread */
     size_t priv_size;
     const struct node_param *params;
 };
@@ -417,16 +673,30 @@ void ngli_node_print_specs(void);
 
 int ngli_node_init(struct ngl_node *node);
 void ngli_node_prefetch(struct ngl_node *node);
-void ngli_node_check_resources(struct ngl_node *node, double t);
+int ngli_node_compile_graph(struct ngl_ctx *ctx);
+void ngli_node_reset_graph(struct ngl_ctx *ctx);
+void ngli_node_submit_shaders(struct ngl_ctx *ctx);
+int ngli_node_finalize_shaders(struct ngl_ctx *ctx);
+int ngli_node_prepare(struct ngl_ctx *ctx, double t_start, double t_end,
+                      ngl_progress_callback_type callback, void *arg);
+void ngli_node_check_resources(struct ngl_ctx *ctx, double t);
+void ngli_node_set_gpu_memory(struct ngl_node *node, int type, size_t size);
+void ngli_node_honor_gpu_memory_budget(struct ngl_ctx *ctx);
+void ngli_node_update_graph(struct ngl_ctx *ctx, double t);
+void ngli_node_draw_graph(struct ngl_ctx *ctx);
 void ngli_node_update(struct ngl_node *node, double t);
 void ngli_node_draw(struct ngl_node *node);
 void ngli_node_release(struct ngl_node *node);
 
+int ngli_node_cache_children(struct ngl_node *node);
+const struct node_child *ngli_node_get_child(const struct ngl_node *node,
+                                             const struct node_child *prev);
+
 int ngli_node_attach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
 void ngli_node_detach_ctx(struct ngl_node *node);
 
 char *ngli_node_default_name(const char *class_name);
-struct ngl_node *ngli_node_create_noconstructor(int type);
+struct ngl_node *ngli_node_create_noconstructor(struct arena *arena, int type);
 const struct node_param *ngli_node_param_find(const struct ngl_node *node, const char *key,
                                               uint8_t **base_ptrp);
 
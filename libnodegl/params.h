@@ -43,6 +43,8 @@ enum {
 #define PARAM_FLAG_CONSTRUCTOR (1<<0)
 #define PARAM_FLAG_DOT_DISPLAY_PACKED (1<<1)
 #define PARAM_FLAG_DOT_DISPLAY_FIELDNAME (1<<2)
+#define PARAM_FLAG_ALLOW_LIVE_CHANGE (1<<3) /* changed in place, without a reinit of the node */
+#define PARAM_FLAG_DRAW_CHILD (1<<4) /* the node(s) are drawn within the draw of the parent */
 struct node_param {
     const char *key;
     int type;
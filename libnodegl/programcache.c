@@ -0,0 +1,516 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "glcontext.h"
+#include "log.h"
+#include "nodes.h"
+#include "programcache.h"
+#include "utils.h"
+
+#define DEFINE_GET_INFO_LOG_FUNCTION(func, name)                                      \
+static void get_##func##_info_log(const struct glfunctions *gl, GLuint id,            \
+                                  char **info_logp, int *info_log_lengthp)            \
+{                                                                                     \
+    ngli_glGet##name##iv(gl, id, GL_INFO_LOG_LENGTH, info_log_lengthp);               \
+    if (!*info_log_lengthp) {                                                         \
+        *info_logp = NULL;                                                            \
+        return;                                                                       \
+    }                                                                                 \
+                                                                                      \
+    *info_logp = malloc(*info_log_lengthp);                                           \
+    if (!*info_logp) {                                                                \
+        *info_log_lengthp = 0;                                                        \
+        return;                                                                       \
+    }                                                                                 \
+                                                                                      \
+    ngli_glGet##name##InfoLog(gl, id, *info_log_lengthp, NULL, *info_logp);           \
+    while (*info_log_lengthp && strchr(" \r\n", (*info_logp)[*info_log_lengthp - 1])) \
+        (*info_logp)[--*info_log_lengthp] = 0;                                        \
+}                                                                                     \
+
+DEFINE_GET_INFO_LOG_FUNCTION(shader, Shader)
+DEFINE_GET_INFO_LOG_FUNCTION(program, Program)
+
+/*
+ * Queue the compilation and link of the program without querying any status
+ * so the driver is free to process it asynchronously (and in parallel with
+ * the other submitted programs if GL_KHR_parallel_shader_compile is
+ * available). The result is checked by ngli_program_finalize().
+ */
+static void submit_program(struct ngl_ctx *ctx, struct glcontext *glcontext, struct program *program)
+{
+    const struct glfunctions *gl = &glcontext->funcs;
+    const char *vertex_data = program->vertex_data;
+    const char *fragment_data = program->fragment_data;
+
+    program->id = ngli_glCreateProgram(gl);
+    program->vertex_shader = ngli_glCreateShader(gl, GL_VERTEX_SHADER);
+    program->fragment_shader = ngli_glCreateShader(gl, GL_FRAGMENT_SHADER);
+
+    ngli_glShaderSource(gl, program->vertex_shader, 1, &vertex_data, NULL);
+    ngli_glCompileShader(gl, program->vertex_shader);
+
+    ngli_glShaderSource(gl, program->fragment_shader, 1, &fragment_data, NULL);
+    ngli_glCompileShader(gl, program->fragment_shader);
+
+    ngli_glAttachShader(gl, program->id, program->vertex_shader);
+    ngli_glAttachShader(gl, program->id, program->fragment_shader);
+
+    /*
+     * Some drivers only return a binary if they were told so before the
+     * link (the hint is not available with GL_OES_get_program_binary)
+     */
+    if (ctx->programcache.dir && gl->ProgramParameteri)
+        ngli_glProgramParameteri(gl, program->id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    ngli_glLinkProgram(gl, program->id);
+
+    program->state = PROGRAM_STATE_SUBMITTED;
+}
+
+static void delete_shaders(struct glcontext *glcontext, struct program *program)
+{
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if (program->vertex_shader) {
+        ngli_glDeleteShader(gl, program->vertex_shader);
+        program->vertex_shader = 0;
+    }
+
+    if (program->fragment_shader) {
+        ngli_glDeleteShader(gl, program->fragment_shader);
+        program->fragment_shader = 0;
+    }
+}
+
+static int check_program(struct glcontext *glcontext, struct program *program)
+{
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    char *info_log = NULL;
+    int info_log_length = 0;
+
+    GLint result = GL_FALSE;
+
+    ngli_glGetShaderiv(gl, program->vertex_shader, GL_COMPILE_STATUS, &result);
+    if (!result) {
+        get_shader_info_log(gl, program->vertex_shader, &info_log, &info_log_length);
+        goto fail;
+    }
+
+    ngli_glGetShaderiv(gl, program->fragment_shader, GL_COMPILE_STATUS, &result);
+    if (!result) {
+        get_shader_info_log(gl, program->fragment_shader, &info_log, &info_log_length);
+        goto fail;
+    }
+
+    ngli_glGetProgramiv(gl, program->id, GL_LINK_STATUS, &result);
+    if (!result) {
+        get_program_info_log(gl, program->id, &info_log, &info_log_length);
+        goto fail;
+    }
+
+    return 0;
+
+fail:
+    if (info_log) {
+        LOG(ERROR, "could not compile or link shader: %s", info_log);
+        free(info_log);
+    }
+
+    return -1;
+}
+
+/* 64-bit FNV-1a */
+static uint64_t hash_str(uint64_t hash, const char *s)
+{
+    for (int i = 0; s[i]; i++) {
+        hash ^= (uint8_t)s[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+uint64_t ngli_program_hash(const char *vertex_data, const char *fragment_data)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    hash = hash_str(hash, vertex_data);
+    hash = hash_str(hash ^ 0xff, fragment_data);
+    return hash;
+}
+
+/*
+ * Program binaries are stored in the cache directory in files named after
+ * the hash of the sources and the hash of the driver identification strings
+ * (a driver update invalidates all the binaries). A binary file is made of
+ * a small header followed by the opaque data returned by the driver.
+ */
+#define BINARY_MAGIC "NGLPROG1"
+
+struct binary_header {
+    char magic[8];
+    uint32_t format;
+    uint32_t size;
+};
+
+static char *get_binary_path(struct ngl_ctx *ctx, uint64_t hash)
+{
+    const struct glcontext *glcontext = ctx->glcontext;
+
+    uint64_t driver_hash = ngli_program_hash(glcontext->vendor   ? glcontext->vendor   : "",
+                                             glcontext->renderer ? glcontext->renderer : "");
+    driver_hash = hash_str(driver_hash, glcontext->version ? glcontext->version : "");
+
+    return ngli_asprintf("%s/%016" PRIx64 "-%016" PRIx64 ".bin",
+                         ctx->programcache.dir, hash, driver_hash);
+}
+
+static GLuint submit_program_binary(struct ngl_ctx *ctx, struct glcontext *glcontext, uint64_t hash)
+{
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    char *path = get_binary_path(ctx, hash);
+    if (!path)
+        return 0;
+
+    GLuint program = 0;
+    void *data = NULL;
+    struct binary_header header;
+
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        goto end;
+
+    if (fread(&header, sizeof(header), 1, fp) != 1 ||
+        memcmp(header.magic, BINARY_MAGIC, sizeof(header.magic))) {
+        LOG(WARNING, "invalid program binary %s", path);
+        goto end;
+    }
+
+    data = malloc(header.size);
+    if (!data || fread(data, 1, header.size, fp) != header.size)
+        goto end;
+
+    program = ngli_glCreateProgram(gl);
+    ngli_glProgramBinary(gl, program, header.format, data, header.size);
+
+    LOG(DEBUG, "submitted program binary %s", path);
+
+end:
+    if (fp)
+        fclose(fp);
+    free(data);
+    free(path);
+    return program;
+}
+
+static void save_program_binary(struct ngl_ctx *ctx, struct glcontext *glcontext,
+                                uint64_t hash, GLuint program)
+{
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    GLint size = 0;
+    ngli_glGetProgramiv(gl, program, GL_PROGRAM_BINARY_LENGTH, &size);
+    if (size <= 0)
+        return;
+
+    void *data = malloc(size);
+    if (!data)
+        return;
+
+    struct binary_header header = {.magic = BINARY_MAGIC};
+    GLsizei length = 0;
+    GLenum format = 0;
+    ngli_glGetProgramBinary(gl, program, size, &length, &format, data);
+    if (length <= 0) {
+        free(data);
+        return;
+    }
+    header.format = format;
+    header.size = length;
+
+    char *path = get_binary_path(ctx, hash);
+    char *tmp_path = path ? ngli_asprintf("%s.tmp", path) : NULL;
+    if (!tmp_path)
+        goto end;
+
+    /*
+     * Write to a temporary file and rename it so that concurrent processes
+     * sharing the same cache directory never load a partial binary.
+     */
+    FILE *fp = fopen(tmp_path, "wb");
+    if (!fp) {
+        LOG(WARNING, "could not open %s for writing", tmp_path);
+        goto end;
+    }
+    const int ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+                   fwrite(data, 1, length, fp) == (size_t)length;
+    if (fclose(fp) || !ok || rename(tmp_path, path)) {
+        LOG(WARNING, "could not write program binary %s", path);
+        remove(tmp_path);
+        goto end;
+    }
+
+    LOG(DEBUG, "saved program binary %s (%d bytes)", path, length);
+
+end:
+    free(tmp_path);
+    free(path);
+    free(data);
+}
+
+int ngli_programcache_set_dir(struct ngl_ctx *ctx, const char *dir)
+{
+    struct programcache *cache = &ctx->programcache;
+
+    free(cache->dir);
+    cache->dir = NULL;
+
+    if (!dir)
+        return 0;
+
+    cache->dir = ngli_strdup(dir);
+    if (!cache->dir)
+        return -1;
+
+    return 0;
+}
+
+static int use_program_binary(struct ngl_ctx *ctx)
+{
+    return ctx->programcache.dir && ctx->glcontext->has_program_binary_compatibility;
+}
+
+static void start_program(struct ngl_ctx *ctx, struct glcontext *glcontext, struct program *program)
+{
+    if (use_program_binary(ctx)) {
+        program->id = submit_program_binary(ctx, glcontext, program->hash);
+        if (program->id)
+            program->state = PROGRAM_STATE_BINARY;
+    }
+
+    if (!program->id)
+        submit_program(ctx, glcontext, program);
+}
+
+static int finalize_program(struct ngl_ctx *ctx, struct glcontext *glcontext, struct program *program)
+{
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if (program->state == PROGRAM_STATE_READY)
+        return 0;
+    if (program->state == PROGRAM_STATE_FAILED)
+        return -1;
+
+    if (program->state == PROGRAM_STATE_BINARY) {
+        GLint result = GL_FALSE;
+        ngli_glGetProgramiv(gl, program->id, GL_LINK_STATUS, &result);
+        if (result) {
+            program->state = PROGRAM_STATE_READY;
+            return 0;
+        }
+
+        LOG(WARNING, "program binary %016" PRIx64 " rejected by the driver", program->hash);
+        ngli_glcache_delete_program(glcontext, program->id);
+        submit_program(ctx, glcontext, program);
+    }
+
+    int ret = check_program(glcontext, program);
+    delete_shaders(glcontext, program);
+    if (ret < 0) {
+        ngli_glcache_delete_program(glcontext, program->id);
+        program->id = 0;
+        program->state = PROGRAM_STATE_FAILED;
+        return ret;
+    }
+
+    if (use_program_binary(ctx))
+        save_program_binary(ctx, glcontext, program->hash, program->id);
+
+    program->state = PROGRAM_STATE_READY;
+    return 0;
+}
+
+static void load_program_job(struct glcontext *glcontext, void *arg)
+{
+    struct program *program = arg;
+    start_program(program->ctx, glcontext, program);
+    finalize_program(program->ctx, glcontext, program);
+}
+
+static void program_free(struct ngl_ctx *ctx, struct program *program)
+{
+    struct glcontext *glcontext = ctx->glcontext;
+
+    if (program->job)
+        ngli_loader_wait(ctx->loader, &program->job);
+
+    delete_shaders(glcontext, program);
+    if (program->id)
+        ngli_glcache_delete_program(glcontext, program->id);
+    for (int i = 0; i < program->nb_locations; i++)
+        free(program->locations[i].name);
+    free(program->locations);
+    free(program->vertex_data);
+    free(program->fragment_data);
+    free(program);
+}
+
+struct program *ngli_programcache_get(struct ngl_ctx *ctx,
+                                      const char *vertex_data,
+                                      const char *fragment_data)
+{
+    struct programcache *cache = &ctx->programcache;
+
+    const uint64_t hash = ngli_program_hash(vertex_data, fragment_data);
+    struct program **bucket = &cache->buckets[hash % NGLI_PROGRAMCACHE_NB_BUCKETS];
+
+    for (struct program *program = *bucket; program; program = program->next) {
+        if (program->hash == hash &&
+            !strcmp(program->vertex_data, vertex_data) &&
+            !strcmp(program->fragment_data, fragment_data)) {
+            LOG(DEBUG, "reuse program %016" PRIx64 " (%d references)", program->hash, program->refcount + 1);
+            program->refcount++;
+            return program;
+        }
+    }
+
+    struct program *program = calloc(1, sizeof(*program));
+    if (!program)
+        return NULL;
+
+    program->hash = hash;
+    program->refcount = 1;
+    program->vertex_data = ngli_strdup(vertex_data);
+    program->fragment_data = ngli_strdup(fragment_data);
+    if (!program->vertex_data || !program->fragment_data) {
+        program_free(ctx, program);
+        return NULL;
+    }
+
+    /*
+     * With a loader thread, the whole compilation happens there and the
+     * finalization only has to wait for it.
+     */
+    program->ctx = ctx;
+    if (ctx->loader)
+        program->job = ngli_loader_submit(ctx->loader, load_program_job, program);
+    if (!program->job)
+        start_program(ctx, ctx->glcontext, program);
+
+    program->next = *bucket;
+    *bucket = program;
+
+    return program;
+}
+
+void ngli_programcache_release(struct ngl_ctx *ctx, struct program **programp)
+{
+    struct programcache *cache = &ctx->programcache;
+    struct program *program = *programp;
+
+    if (!program)
+        return;
+    *programp = NULL;
+
+    if (--program->refcount)
+        return;
+
+    struct program **prevp = &cache->buckets[program->hash % NGLI_PROGRAMCACHE_NB_BUCKETS];
+    while (*prevp != program)
+        prevp = &(*prevp)->next;
+    *prevp = program->next;
+
+    program_free(ctx, program);
+}
+
+void ngli_programcache_reset(struct ngl_ctx *ctx)
+{
+    struct programcache *cache = &ctx->programcache;
+
+    for (int i = 0; i < NGLI_ARRAY_NB(cache->buckets); i++) {
+        struct program *program = cache->buckets[i];
+        while (program) {
+            struct program *next = program->next;
+            LOG(WARNING, "program %u still has %d references", program->id, program->refcount);
+            program_free(ctx, program);
+            program = next;
+        }
+        cache->buckets[i] = NULL;
+    }
+
+    free(cache->dir);
+    cache->dir = NULL;
+}
+
+int ngli_program_finalize(struct ngl_ctx *ctx, struct program *program)
+{
+    if (program->job)
+        ngli_loader_wait(ctx->loader, &program->job);
+    return finalize_program(ctx, ctx->glcontext, program);
+}
+
+static GLint get_location(struct ngl_ctx *ctx, struct program *program,
+                          const char *name, int is_uniform)
+{
+    const struct glfunctions *gl = &ctx->glcontext->funcs;
+
+    for (int i = 0; i < program->nb_locations; i++) {
+        const struct program_location *loc = &program->locations[i];
+        if (loc->is_uniform == is_uniform && !strcmp(loc->name, name))
+            return loc->location;
+    }
+
+    const GLint location = is_uniform ? ngli_glGetUniformLocation(gl, program->id, name)
+                                      : ngli_glGetAttribLocation(gl, program->id, name);
+
+    struct program_location *locations = realloc(program->locations,
+                                                 (program->nb_locations + 1) * sizeof(*locations));
+    if (!locations)
+        return location;
+    program->locations = locations;
+
+    char *location_name = ngli_strdup(name);
+    if (!location_name)
+        return location;
+
+    struct program_location *loc = &locations[program->nb_locations++];
+    loc->name = location_name;
+    loc->is_uniform = is_uniform;
+    loc->location = location;
+
+    return location;
+}
+
+GLint ngli_program_get_attrib_location(struct ngl_ctx *ctx, struct program *program, const char *name)
+{
+    return get_location(ctx, program, name, 0);
+}
+
+GLint ngli_program_get_uniform_location(struct ngl_ctx *ctx, struct program *program, const char *name)
+{
+    return get_location(ctx, program, name, 1);
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef PROGRAMCACHE_H
+#define PROGRAMCACHE_H
+
+#include <stdint.h>
+
+#include "glincludes.h"
+#include "loader.h"
+
+#define NGLI_PROGRAMCACHE_NB_BUCKETS 64
+
+struct ngl_ctx;
+
+struct program_location {
+    char *name;
+    int is_uniform;
+    GLint location;
+};
+
+enum {
+    PROGRAM_STATE_SUBMITTED, /* compilation and link queued, status unknown */
+    PROGRAM_STATE_BINARY,    /* binary loaded from the disk cache, status unknown */
+    PROGRAM_STATE_READY,
+    PROGRAM_STATE_FAILED,
+};
+
+/*
+ * Linked GL program shared by all the Shader nodes using the same vertex
+ * and fragment sources. The attribute and uniform locations are queried
+ * once and then answered from memory.
+ */
+struct program {
+    struct ngl_ctx *ctx;
+    uint64_t hash;
+    char *vertex_data;
+    char *fragment_data;
+    int refcount;
+    int state;
+    GLuint id;
+    GLuint vertex_shader;
+    GLuint fragment_shader;
+    struct loader_job *job; /* pending compilation in the loader thread */
+
+    struct program_location *locations;
+    int nb_locations;
+
+    struct program *next;
+};
+
+struct programcache {
+    struct program *buckets[NGLI_PROGRAMCACHE_NB_BUCKETS];
+    char *dir; /* optional directory where the program binaries are stored */
+};
+
+uint64_t ngli_program_hash(const char *vertex_data, const char *fragment_data);
+
+/*
+ * Return a new reference to a program, submitting its compilation if needed.
+ * The program must go through ngli_program_finalize() before being used.
+ */
+struct program *ngli_programcache_get(struct ngl_ctx *ctx,
+                                      const char *vertex_data,
+                                      const char *fragment_data);
+void ngli_programcache_release(struct ngl_ctx *ctx, struct program **programp);
+int ngli_programcache_set_dir(struct ngl_ctx *ctx, const char *dir);
+void ngli_programcache_reset(struct ngl_ctx *ctx);
+
+/* Wait for the program to be linked and check the result */
+int ngli_program_finalize(struct ngl_ctx *ctx, struct program *program);
+
+GLint ngli_program_get_attrib_location(struct ngl_ctx *ctx, struct program *program, const char *name);
+GLint ngli_program_get_uniform_location(struct ngl_ctx *ctx, struct program *program, const char *name);
+
+#endif
@@ -204,36 +204,11 @@ static void serialize(struct serial_ctx *sctx,
 
 static void serialize_children(struct serial_ctx *sctx,
                                struct bstr *b,
-                               const struct ngl_node *node,
-                               uint8_t *priv,
-                               const struct node_param *p)
+                               const struct ngl_node *node)
 {
-    while (p && p->key) {
-        switch (p->type) {
-            case PARAM_TYPE_NODE: {
-                const struct ngl_node *child = *(struct ngl_node **)(priv + p->offset);
-                if (child)
-                    serialize(sctx, b, child);
-                break;
-            }
-            case PARAM_TYPE_NODELIST: {
-                struct ngl_node **children = *(struct ngl_node ***)(priv + p->offset);
-                const int nb_children = *(int *)(priv + p->offset + sizeof(struct ngl_node **));
-
-                for (int i = 0; i < nb_children; i++)
-                    serialize(sctx, b, children[i]);
-                break;
-            }
-            case PARAM_TYPE_NODEDICT: {
-                struct ndict *ndict = *(struct ndict **)(priv + p->offset);
-                struct ndict_entry *entry = NULL;
-                while ((entry = ngli_ndict_get(ndict, NULL, entry)))
-                    serialize(sctx, b, entry->node);
-                break;
-            }
-        }
-        p++;
-    }
+    const struct node_child *child = NULL;
+    while ((child = ngli_node_get_child(node, child)))
+        serialize(sctx, b, child->node);
 }
 
 static void serialize(struct serial_ctx *sctx,
@@ -244,8 +219,7 @@ static void serialize(struct serial_ctx *sctx,
     if (node_id != -1)
         return;
 
-    serialize_children(sctx, b, node, (uint8_t *)node, ngli_base_node_params);
-    serialize_children(sctx, b, node, node->priv_data, node->class->params);
+    serialize_children(sctx, b, node);
 
     ngli_bstr_print(b, "%x", node->class->id);
     serialize_options(sctx, b, node, node->priv_data, node->class->params);
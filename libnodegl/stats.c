@@ -0,0 +1,218 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bstr.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "stats.h"
+#include "utils.h"
+
+static void get_counters(struct ngl_ctx *ctx, struct stats_counters *counters)
+{
+    *counters = ctx->counters;
+    counters->state_changes = ctx->glcontext->nb_state_changes;
+}
+
+static struct stats_values *get_frame_values(struct ngl_node *node)
+{
+    struct node_stats *stats = &node->stats;
+    const int64_t frame_index = node->ctx->frame_index;
+
+    if (stats->frame_index != frame_index) {
+        memset(&stats->frame, 0, sizeof(stats->frame));
+        stats->frame_index = frame_index;
+    }
+    return &stats->frame;
+}
+
+static void add_values(struct stats_values *dst, int op, int64_t time,
+                       const struct stats_counters *counters)
+{
+    dst->ops[op].count++;
+    dst->ops[op].time += time;
+    if (counters) {
+        dst->counters.draw_calls    += counters->draw_calls;
+        dst->counters.state_changes += counters->state_changes;
+        dst->counters.upload_bytes  += counters->upload_bytes;
+    }
+}
+
+void ngli_stats_probe_start(struct ngl_ctx *ctx, struct stats_probe *probe)
+{
+    get_counters(ctx, &probe->counters);
+    probe->start = ngli_gettime();
+}
+
+void ngli_stats_probe_end(struct ngl_node *node, int op, const struct stats_probe *probe)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    const int64_t time = ngli_gettime() - probe->start;
+
+    /*
+     * The counters are shared by the whole context, so they can not be
+     * attributed to the nodes updated concurrently by the worker threads
+     * (which do not make any GL call anyway).
+     */
+    struct stats_counters counters;
+    const struct stats_counters *counters_p = NULL;
+    if (!ctx->threaded_update) {
+        get_counters(ctx, &counters);
+        counters.draw_calls    -= probe->counters.draw_calls;
+        counters.state_changes -= probe->counters.state_changes;
+        counters.upload_bytes  -= probe->counters.upload_bytes;
+        counters_p = &counters;
+    }
+
+    add_values(&node->stats.total, op, time, counters_p);
+    add_values(get_frame_values(node), op, time, counters_p);
+}
+
+void ngli_stats_add_time(struct ngl_node *node, int op, int64_t time)
+{
+    add_values(&node->stats.total, op, time, NULL);
+    add_values(get_frame_values(node), op, time, NULL);
+}
+
+void ngli_stats_reset(struct ngl_ctx *ctx)
+{
+    for (int i = 0; i < ctx->nb_graph_entries; i++) {
+        struct ngl_node *node = ctx->graph[i].node;
+        memset(&node->stats, 0, sizeof(node->stats));
+    }
+}
+
+struct class_stats {
+    const struct node_class *class;
+    int instances;
+    int ready;
+    size_t gpu_memory;
+    struct stats_values total;
+    struct stats_values frame;
+};
+
+static void sum_values(struct stats_values *dst, const struct stats_values *src)
+{
+    for (int i = 0; i < NGLI_STATS_NB_OPS; i++) {
+        dst->ops[i].count += src->ops[i].count;
+        dst->ops[i].time  += src->ops[i].time;
+    }
+    dst->counters.draw_calls    += src->counters.draw_calls;
+    dst->counters.state_changes += src->counters.state_changes;
+    dst->counters.upload_bytes  += src->counters.upload_bytes;
+}
+
+static void print_values(struct bstr *b, const struct stats_values *total,
+                         const struct stats_values *frame)
+{
+    for (int i = 0; i < NGLI_STATS_NB_OPS; i++)
+        ngli_bstr_print(b, ",%" PRId64 ",%" PRId64 ",%" PRId64,
+                        total->ops[i].count, total->ops[i].time, frame->ops[i].time);
+    ngli_bstr_print(b, ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 "\n",
+                    total->counters.draw_calls,    frame->counters.draw_calls,
+                    total->counters.state_changes, frame->counters.state_changes,
+                    total->counters.upload_bytes,  frame->counters.upload_bytes);
+}
+
+/* Quote a CSV field, the quotes it contains are doubled */
+static void print_csv_str(struct bstr *b, const char *s)
+{
+    ngli_bstr_print(b, "\"");
+    for (; s && *s; s++) {
+        if (*s == '"')
+            ngli_bstr_print(b, "\"\"");
+        else
+            ngli_bstr_print(b, "%c", *s);
+    }
+    ngli_bstr_print(b, "\"");
+}
+
+/*
+ * The values of a node include the ones of its children, and the values of a
+ * class are the sums of the values of its nodes. A class line therefore counts
+ * several times the work of nested nodes; the node lines are the reference.
+ */
+char *ngli_stats_report(struct ngl_ctx *ctx)
+{
+    static const struct stats_values zero_values;
+
+    struct class_stats *classes = calloc(NGLI_NB_NODE_CLASSES, sizeof(*classes));
+    struct bstr *b = ngli_bstr_create();
+    if (!classes || !b) {
+        free(classes);
+        ngli_bstr_freep(&b);
+        return NULL;
+    }
+
+    ngli_bstr_print(b, "type,class,name,instances,ready,gpu_memory,"
+                    "init_count,init_time,init_time_last,"
+                    "prefetch_count,prefetch_time,prefetch_time_last,"
+                    "update_count,update_time,update_time_last,"
+                    "draw_count,draw_time,draw_time_last,"
+                    "draw_calls,draw_calls_last,"
+                    "state_changes,state_changes_last,"
+                    "upload_bytes,upload_bytes_last\n");
+
+    for (int i = 0; i < ctx->nb_graph_entries; i++)
+        ctx->graph[i].node->stats.reported = 0;
+
+    for (int i = 0; i < ctx->nb_graph_entries; i++) {
+        struct ngl_node *node = ctx->graph[i].node;
+        struct node_stats *stats = &node->stats;
+        if (stats->reported)
+            continue;
+        stats->reported = 1;
+
+        const int ready = node->state == STATE_READY;
+        const struct stats_values *frame = stats->frame_index == ctx->frame_index ? &stats->frame
+                                                                                   : &zero_values;
+
+        ngli_bstr_print(b, "node,%s,", node->class->name);
+        print_csv_str(b, node->name);
+        ngli_bstr_print(b, ",1,%d,%zu", ready, node->gpu_memory);
+        print_values(b, &stats->total, frame);
+
+        struct class_stats *cs = &classes[node->class->id];
+        cs->class = node->class;
+        cs->instances++;
+        cs->ready += ready;
+        cs->gpu_memory += node->gpu_memory;
+        sum_values(&cs->total, &stats->total);
+        sum_values(&cs->frame, frame);
+    }
+
+    for (int i = 0; i < NGLI_NB_NODE_CLASSES; i++) {
+        const struct class_stats *cs = &classes[i];
+        if (!cs->instances)
+            continue;
+        ngli_bstr_print(b, "class,%s,,%d,%d,%zu",
+                        cs->class->name, cs->instances, cs->ready, cs->gpu_memory);
+        print_values(b, &cs->total, &cs->frame);
+    }
+
+    char *report = ngli_bstr_strdup(b);
+    ngli_bstr_freep(&b);
+    free(classes);
+    return report;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdint.h>
+
+struct ngl_ctx;
+struct ngl_node;
+
+enum {
+    NGLI_STATS_INIT,
+    NGLI_STATS_PREFETCH,
+    NGLI_STATS_UPDATE,
+    NGLI_STATS_DRAW,
+    NGLI_STATS_NB_OPS
+};
+
+/*
+ * Monotonic counters of the context; the share of a node is the difference
+ * between their values before and after its operations.
+ */
+struct stats_counters {
+    int64_t draw_calls;
+    int64_t state_changes;
+    int64_t upload_bytes;
+};
+
+struct stats_op {
+    int64_t count;
+    int64_t time; /* in microseconds */
+};
+
+struct stats_values {
+    struct stats_op ops[NGLI_STATS_NB_OPS];
+    struct stats_counters counters;
+};
+
+struct node_stats {
+    struct stats_values total;
+    struct stats_values frame;  /* values of the frame frame_index only */
+    int64_t frame_index;
+    int reported;
+};
+
+struct stats_probe {
+    int64_t start;
+    struct stats_counters counters;
+};
+
+/*
+ * Measure an operation of a node, including the operations of its children
+ * called from it. These functions must only be called when the statistics
+ * are enabled on the context.
+ */
+void ngli_stats_probe_start(struct ngl_ctx *ctx, struct stats_probe *probe);
+void ngli_stats_probe_end(struct ngl_node *node, int op, const struct stats_probe *probe);
+
+/* Account an operation measured outside of the rendering thread */
+void ngli_stats_add_time(struct ngl_node *node, int op, int64_t time);
+
+void ngli_stats_reset(struct ngl_ctx *ctx);
+char *ngli_stats_report(struct ngl_ctx *ctx);
+
+#endif
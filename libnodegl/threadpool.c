@@ -0,0 +1,263 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "log.h"
+#include "threadpool.h"
+
+struct task {
+    ngli_task_func func;
+    void *arg;
+};
+
+/*
+ * The owner of a queue pops the most recent task while the thieves take the
+ * oldest one.
+ */
+struct taskqueue {
+    pthread_mutex_t lock;
+    struct task *tasks;
+    int head;
+    int tail;
+    int size;
+};
+
+struct worker {
+    struct threadpool *tp;
+    int id;
+    pthread_t tid;
+    int started;
+};
+
+struct threadpool {
+    struct worker *workers;
+    int nb_workers;
+
+    struct taskqueue *queues;  /* one per worker */
+    int next_queue;
+
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
+    int nb_queued;
+    int nb_pending;
+    int stop;
+};
+
+static int queue_push(struct taskqueue *q, const struct task *task)
+{
+    pthread_mutex_lock(&q->lock);
+    if (q->tail == q->size) {
+        if (q->head) {
+            memmove(q->tasks, q->tasks + q->head, (q->tail - q->head) * sizeof(*q->tasks));
+            q->tail -= q->head;
+            q->head = 0;
+        } else {
+            const int size = q->size ? q->size * 2 : 16;
+            struct task *tasks = realloc(q->tasks, size * sizeof(*tasks));
+            if (!tasks) {
+                pthread_mutex_unlock(&q->lock);
+                return -1;
+            }
+            q->tasks = tasks;
+            q->size = size;
+        }
+    }
+    q->tasks[q->tail++] = *task;
+    pthread_mutex_unlock(&q->lock);
+    return 0;
+}
+
+static int queue_pop(struct taskqueue *q, struct task *task, int steal)
+{
+    int ret = 0;
+
+    pthread_mutex_lock(&q->lock);
+    if (q->head < q->tail) {
+        *task = steal ? q->tasks[q->head++] : q->tasks[--q->tail];
+        if (q->head == q->tail)
+            q->head = q->tail = 0;
+        ret = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ret;
+}
+
+/*
+ * Fetch a task from the queue of the specified worker first, then from the
+ * other queues. A negative id means the caller does not own any queue.
+ */
+static int get_task(struct threadpool *tp, int id, struct task *task)
+{
+    if (id >= 0 && queue_pop(&tp->queues[id], task, 0))
+        goto found;
+
+    for (int i = 0; i < tp->nb_workers; i++) {
+        if (i != id && queue_pop(&tp->queues[i], task, 1))
+            goto found;
+    }
+    return 0;
+
+found:
+    pthread_mutex_lock(&tp->lock);
+    tp->nb_queued--;
+    pthread_mutex_unlock(&tp->lock);
+    return 1;
+}
+
+static void run_task(struct threadpool *tp, const struct task *task)
+{
+    task->func(task->arg);
+
+    pthread_mutex_lock(&tp->lock);
+    if (!--tp->nb_pending)
+        pthread_cond_broadcast(&tp->done_cond);
+    pthread_mutex_unlock(&tp->lock);
+}
+
+static void *worker_thread(void *arg)
+{
+    struct worker *worker = arg;
+    struct threadpool *tp = worker->tp;
+
+    for (;;) {
+        pthread_mutex_lock(&tp->lock);
+        while (!tp->stop && !tp->nb_queued)
+            pthread_cond_wait(&tp->work_cond, &tp->lock);
+        const int stop = tp->stop;
+        pthread_mutex_unlock(&tp->lock);
+
+        if (stop)
+            break;
+
+        struct task task;
+        if (get_task(tp, worker->id, &task))
+            run_task(tp, &task);
+    }
+
+    return NULL;
+}
+
+struct threadpool *ngli_threadpool_create(int nb_threads)
+{
+    if (nb_threads <= 0)
+        return NULL;
+
+    struct threadpool *tp = calloc(1, sizeof(*tp));
+    if (!tp)
+        return NULL;
+
+    pthread_mutex_init(&tp->lock, NULL);
+    pthread_cond_init(&tp->work_cond, NULL);
+    pthread_cond_init(&tp->done_cond, NULL);
+
+    tp->workers = calloc(nb_threads, sizeof(*tp->workers));
+    tp->queues  = calloc(nb_threads, sizeof(*tp->queues));
+    if (!tp->workers || !tp->queues)
+        goto fail;
+
+    for (int i = 0; i < nb_threads; i++)
+        pthread_mutex_init(&tp->queues[i].lock, NULL);
+    tp->nb_workers = nb_threads;
+
+    for (int i = 0; i < nb_threads; i++) {
+        struct worker *worker = &tp->workers[i];
+        worker->tp = tp;
+        worker->id = i;
+        if (pthread_create(&worker->tid, NULL, worker_thread, worker)) {
+            LOG(ERROR, "unable to create worker thread %d", i);
+            goto fail;
+        }
+        worker->started = 1;
+    }
+
+    LOG(DEBUG, "thread pool created with %d workers", nb_threads);
+    return tp;
+
+fail:
+    ngli_threadpool_freep(&tp);
+    return NULL;
+}
+
+int ngli_threadpool_submit(struct threadpool *tp, ngli_task_func func, void *arg)
+{
+    const struct task task = {func, arg};
+
+    pthread_mutex_lock(&tp->lock);
+    struct taskqueue *q = &tp->queues[tp->next_queue];
+    int ret = queue_push(q, &task);
+    if (ret >= 0) {
+        tp->next_queue = (tp->next_queue + 1) % tp->nb_workers;
+        tp->nb_queued++;
+        tp->nb_pending++;
+        pthread_cond_signal(&tp->work_cond);
+    }
+    pthread_mutex_unlock(&tp->lock);
+    return ret;
+}
+
+void ngli_threadpool_wait(struct threadpool *tp)
+{
+    struct task task;
+    while (get_task(tp, -1, &task))
+        run_task(tp, &task);
+
+    pthread_mutex_lock(&tp->lock);
+    while (tp->nb_pending)
+        pthread_cond_wait(&tp->done_cond, &tp->lock);
+    pthread_mutex_unlock(&tp->lock);
+}
+
+void ngli_threadpool_freep(struct threadpool **tpp)
+{
+    struct threadpool *tp = *tpp;
+
+    if (!tp)
+        return;
+
+    pthread_mutex_lock(&tp->lock);
+    tp->stop = 1;
+    pthread_cond_broadcast(&tp->work_cond);
+    pthread_mutex_unlock(&tp->lock);
+
+    for (int i = 0; i < tp->nb_workers; i++)
+        if (tp->workers[i].started)
+            pthread_join(tp->workers[i].tid, NULL);
+
+    if (tp->queues) {
+        for (int i = 0; i < tp->nb_workers; i++) {
+            pthread_mutex_destroy(&tp->queues[i].lock);
+            free(tp->queues[i].tasks);
+        }
+    }
+    free(tp->queues);
+    free(tp->workers);
+
+    pthread_cond_destroy(&tp->done_cond);
+    pthread_cond_destroy(&tp->work_cond);
+    pthread_mutex_destroy(&tp->lock);
+
+    free(tp);
+    *tpp = NULL;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+typedef void (*ngli_task_func)(void *arg);
+
+struct threadpool;
+
+struct threadpool *ngli_threadpool_create(int nb_threads);
+
+/*
+ * Queue a task. Tasks are dispatched over the per-worker queues and idle
+ * workers steal from the other queues.
+ */
+int ngli_threadpool_submit(struct threadpool *tp, ngli_task_func func, void *arg);
+
+/*
+ * Wait for every submitted task to complete. The calling thread executes
+ * pending tasks as well while waiting.
+ */
+void ngli_threadpool_wait(struct threadpool *tp);
+
+void ngli_threadpool_freep(struct threadpool **tpp);
+
+#endif
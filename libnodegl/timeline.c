@@ -0,0 +1,73 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+
+#include "timeline.h"
+
+int ngli_timeline_init(struct timeline *tl, int nb_times)
+{
+    ngli_timeline_reset(tl);
+
+    if (!nb_times)
+        return 0;
+
+    tl->times = calloc(nb_times, sizeof(*tl->times));
+    if (!tl->times)
+        return -1;
+    tl->nb_times = nb_times;
+    return 0;
+}
+
+#define BEFORE(i) (inclusive ? *tl->times[i] <= t : *tl->times[i] < t)
+
+static int is_segment(const struct timeline *tl, int i, double t, int inclusive)
+{
+    return i >= 0 && i < tl->nb_times && BEFORE(i) &&
+           (i == tl->nb_times - 1 || !BEFORE(i + 1));
+}
+
+int ngli_timeline_find(const struct timeline *tl, int cursor, double t, int inclusive)
+{
+    /* Fast path: same segment as previously, or the following one */
+    if (is_segment(tl, cursor, t, inclusive))
+        return cursor;
+    if (is_segment(tl, cursor + 1, t, inclusive))
+        return cursor + 1;
+
+    int lo = 0;
+    int hi = tl->nb_times;
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (BEFORE(mid))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo - 1;
+}
+
+void ngli_timeline_reset(struct timeline *tl)
+{
+    free(tl->times);
+    tl->times = NULL;
+    tl->nb_times = 0;
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+/*
+ * Sorted array of times (render ranges start times, keyframes times, ...)
+ * used to locate the timeline segment containing a given time. The times are
+ * referenced from the nodes holding them, so a live change of one of them is
+ * taken into account by the next lookup.
+ */
+struct timeline {
+    const double **times;
+    int nb_times;
+};
+
+int ngli_timeline_init(struct timeline *tl, int nb_times);
+
+/*
+ * Return the index of the last time lower than t (or equal to t if inclusive
+ * is set), or -1 if there is none. The cursor is the index returned for the
+ * previous lookup; it is used as a hint so that a regular playback does not
+ * need a full bisection.
+ */
+int ngli_timeline_find(const struct timeline *tl, int cursor, double t, int inclusive);
+
+void ngli_timeline_reset(struct timeline *tl);
+
+#endif
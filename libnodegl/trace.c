@@ -0,0 +1,199 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bstr.h"
+#include "trace.h"
+#include "utils.h"
+
+#define NAME_SIZE 32
+
+struct trace_event {
+    uint64_t seq; /* index + 1 of the event once written, 0 while written */
+    int64_t ts;
+    pthread_t thread;
+    double t;
+    const char *class_name;
+    char name[NAME_SIZE];
+    char op;
+    char phase;
+};
+
+struct trace {
+    struct trace_event *events;
+    int nb_events;
+    uint64_t nb_written;
+    int64_t start;
+};
+
+static const char * const op_names[NGLI_TRACE_NB_OPS] = {
+    [NGLI_TRACE_FRAME]    = "frame",
+    [NGLI_TRACE_PREPARE]  = "prepare",
+    [NGLI_TRACE_INIT]     = "init",
+    [NGLI_TRACE_PREFETCH] = "prefetch",
+    [NGLI_TRACE_UPDATE]   = "update",
+    [NGLI_TRACE_DRAW]     = "draw",
+    [NGLI_TRACE_RELEASE]  = "release",
+};
+
+struct trace *ngli_trace_create(int nb_events)
+{
+    if (nb_events <= 0)
+        return NULL;
+
+    struct trace *trace = calloc(1, sizeof(*trace));
+    if (!trace)
+        return NULL;
+
+    trace->events = calloc(nb_events, sizeof(*trace->events));
+    if (!trace->events) {
+        free(trace);
+        return NULL;
+    }
+    trace->nb_events = nb_events;
+    trace->start = ngli_gettime();
+    return trace;
+}
+
+void ngli_trace_add(struct trace *trace, int op, char phase,
+                    const char *class_name, const char *name, double t)
+{
+    /*
+     * Every writer reserves its own slot. The sequence number tells the
+     * reader whether the slot holds a complete event, and which one.
+     */
+    const uint64_t index = __atomic_fetch_add(&trace->nb_written, 1, __ATOMIC_RELAXED);
+    struct trace_event *ev = &trace->events[index % trace->nb_events];
+
+    __atomic_store_n(&ev->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    ev->ts = ngli_gettime();
+    ev->thread = pthread_self();
+    ev->t = t;
+    ev->class_name = class_name;
+    snprintf(ev->name, sizeof(ev->name), "%s", name ? name : "");
+    ev->op = op;
+    ev->phase = phase;
+
+    __atomic_store_n(&ev->seq, index + 1, __ATOMIC_RELEASE);
+}
+
+/* Read an event, and return whether it is the expected one and complete */
+static int read_event(const struct trace_event *ev, uint64_t index, struct trace_event *dst)
+{
+    const uint64_t seq = __atomic_load_n(&ev->seq, __ATOMIC_ACQUIRE);
+    if (seq != index + 1)
+        return 0;
+    *dst = *ev;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&ev->seq, __ATOMIC_RELAXED) == seq;
+}
+
+/* Map the thread handles to small ids, in their order of appearance */
+static int get_tid(pthread_t **threads, int *nb_threads, pthread_t thread)
+{
+    for (int i = 0; i < *nb_threads; i++)
+        if (pthread_equal((*threads)[i], thread))
+            return i + 1;
+
+    pthread_t *new_threads = realloc(*threads, (*nb_threads + 1) * sizeof(**threads));
+    if (!new_threads)
+        return 0;
+    new_threads[(*nb_threads)++] = thread;
+    *threads = new_threads;
+    return *nb_threads;
+}
+
+static void print_json_str(struct bstr *b, const char *s)
+{
+    for (; *s; s++) {
+        const unsigned char c = *s;
+        if (c == '"' || c == '\\')
+            ngli_bstr_print(b, "\\%c", c);
+        else if (c < 0x20)
+            ngli_bstr_print(b, "\\u%04x", c);
+        else
+            ngli_bstr_print(b, "%c", c);
+    }
+}
+
+char *ngli_trace_dump(struct trace *trace)
+{
+    struct bstr *b = ngli_bstr_create();
+    if (!b)
+        return NULL;
+
+    pthread_t *threads = NULL;
+    int nb_threads = 0;
+    int nb_printed = 0;
+
+    const uint64_t end = __atomic_load_n(&trace->nb_written, __ATOMIC_ACQUIRE);
+    const uint64_t start = end > trace->nb_events ? end - trace->nb_events : 0;
+
+    ngli_bstr_print(b, "{\"traceEvents\":[");
+    for (uint64_t i = start; i < end; i++) {
+        struct trace_event ev;
+        if (!read_event(&trace->events[i % trace->nb_events], i, &ev))
+            continue;
+
+        const char *op_name = op_names[(int)ev.op];
+        ngli_bstr_print(b, "%s\n{\"name\":\"%s", nb_printed++ ? "," : "", op_name);
+        if (ev.class_name) {
+            ngli_bstr_print(b, " ");
+            print_json_str(b, ev.name);
+        }
+        ngli_bstr_print(b, "\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%" PRId64 ","
+                        "\"pid\":1,\"tid\":%d,\"args\":{",
+                        op_name, ev.phase, ev.ts - trace->start,
+                        get_tid(&threads, &nb_threads, ev.thread));
+        if (ev.class_name) {
+            ngli_bstr_print(b, "\"node\":\"");
+            print_json_str(b, ev.name);
+            ngli_bstr_print(b, "\",\"class\":\"%s\"%s", ev.class_name, isnan(ev.t) ? "" : ",");
+        }
+        if (!isnan(ev.t))
+            ngli_bstr_print(b, "\"t\":%g", ev.t);
+        ngli_bstr_print(b, "}}");
+    }
+    ngli_bstr_print(b, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    free(threads);
+
+    char *str = ngli_bstr_strdup(b);
+    ngli_bstr_freep(&b);
+    return str;
+}
+
+void ngli_trace_freep(struct trace **tracep)
+{
+    struct trace *trace = *tracep;
+    if (!trace)
+        return;
+    free(trace->events);
+    free(trace);
+    *tracep = NULL;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+enum {
+    NGLI_TRACE_FRAME,
+    NGLI_TRACE_PREPARE,
+    NGLI_TRACE_INIT,
+    NGLI_TRACE_PREFETCH,
+    NGLI_TRACE_UPDATE,
+    NGLI_TRACE_DRAW,
+    NGLI_TRACE_RELEASE,
+    NGLI_TRACE_NB_OPS
+};
+
+struct trace;
+
+struct trace *ngli_trace_create(int nb_events);
+
+/*
+ * Record the beginning ('B') or the end ('E') of an operation. This function
+ * is lock-free and can be called from any thread: when the ring is full, the
+ * oldest events are overwritten. The node name is copied, the class name must
+ * be a static string. A NAN time is not reported.
+ */
+void ngli_trace_add(struct trace *trace, int op, char phase,
+                    const char *class_name, const char *name, double t);
+
+/* Return the recorded events in the Chrome trace event JSON format */
+char *ngli_trace_dump(struct trace *trace);
+
+void ngli_trace_freep(struct trace **tracep);
+
+#endif
@@ -19,31 +19,113 @@
  * under the License.
  */
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "log.h"
+#include "math_utils.h"
 #include "nodegl.h"
 #include "transforms.h"
 
-const float *ngli_get_last_transformation_matrix(const struct ngl_node *node)
+static const float *get_local_matrix(const struct ngl_node *node, const struct ngl_node **child)
 {
+    const int id = node->class->id;
+    if (id == NGL_NODE_ROTATE) {
+        const struct rotate *rotate = node->priv_data;
+        *child = rotate->child;
+        return rotate->matrix;
+    } else if (id == NGL_NODE_TRANSLATE) {
+        const struct translate *translate = node->priv_data;
+        *child = translate->child;
+        return translate->matrix;
+    } else if (id == NGL_NODE_SCALE) {
+        const struct scale *scale = node->priv_data;
+        *child = scale->child;
+        return scale->matrix;
+    }
+    return NULL;
+}
+
+int ngli_get_last_transformation_matrix(const struct ngl_node *node, float *matrix)
+{
+    static const float id_matrix[4*4] = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f,
+    };
+
+    memcpy(matrix, id_matrix, sizeof(id_matrix));
+
     while (node) {
-        const int id = node->class->id;
-        if (id == NGL_NODE_ROTATE) {
-            const struct rotate *rotate = node->priv_data;
-            node = rotate->child;
-        } else if (id == NGL_NODE_TRANSLATE) {
-            const struct translate *translate = node->priv_data;
-            node = translate->child;
-        } else if (id == NGL_NODE_SCALE) {
-            const struct scale *scale = node->priv_data;
-            node = scale->child;
-        } else if (id == NGL_NODE_IDENTITY) {
-            return node->modelview_matrix;
-        } else {
+        if (node->class->id == NGL_NODE_IDENTITY)
+            return 0;
+
+        const struct ngl_node *child = NULL;
+        const float *local_matrix = get_local_matrix(node, &child);
+        if (!local_matrix) {
             LOG(ERROR, "%s (%s) is not an allowed type for a camera transformation",
                 node->name, node->class->name);
             break;
         }
+        ngli_mat4_mul(matrix, matrix, local_matrix);
+        node = child;
     }
 
-    return NULL;
+    return -1;
+}
+
+#define MAT_SIZE (4 * 4 * sizeof(float))
+
+int ngli_matrix_stack_init(struct matrix_stack *s, int size)
+{
+    ngli_matrix_stack_reset(s);
+
+    void *ptr = NULL;
+    if (posix_memalign(&ptr, NGLI_ALIGN, size * MAT_SIZE))
+        return -1;
+    s->matrices = ptr;
+    s->size = size;
+
+    /* The bottom of the stack is the identity matrix */
+    memset(s->matrices, 0, MAT_SIZE);
+    s->matrices[ 0] =
+    s->matrices[ 5] =
+    s->matrices[10] =
+    s->matrices[15] = 1.0f;
+    return 0;
+}
+
+static float *get_next(struct matrix_stack *s)
+{
+    ngli_assert(s->depth + 1 < s->size);
+    return s->matrices + ++s->depth * 4 * 4;
+}
+
+void ngli_matrix_stack_push(struct matrix_stack *s, const float *matrix)
+{
+    memcpy(get_next(s), matrix, MAT_SIZE);
+}
+
+void ngli_matrix_stack_push_mul(struct matrix_stack *s, const float *matrix)
+{
+    const float *top = ngli_matrix_stack_top(s);
+    ngli_mat4_mul(get_next(s), top, matrix);
+}
+
+void ngli_matrix_stack_pop(struct matrix_stack *s)
+{
+    ngli_assert(s->depth > 0);
+    s->depth--;
+}
+
+const float *ngli_matrix_stack_top(const struct matrix_stack *s)
+{
+    return s->matrices + s->depth * 4 * 4;
+}
+
+void ngli_matrix_stack_reset(struct matrix_stack *s)
+{
+    free(s->matrices);
+    memset(s, 0, sizeof(*s));
 }
@@ -24,6 +24,17 @@
 
 #include "nodes.h"
 
-const float *ngli_get_last_transformation_matrix(const struct ngl_node *node);
+/*
+ * Compute the matrix of a transformation chain (Rotate, Translate and Scale
+ * nodes ending with an Identity) from the local matrices of its nodes.
+ */
+int ngli_get_last_transformation_matrix(const struct ngl_node *node, float *matrix);
+
+int ngli_matrix_stack_init(struct matrix_stack *s, int size);
+void ngli_matrix_stack_push(struct matrix_stack *s, const float *matrix);
+void ngli_matrix_stack_push_mul(struct matrix_stack *s, const float *matrix);
+void ngli_matrix_stack_pop(struct matrix_stack *s);
+const float *ngli_matrix_stack_top(const struct matrix_stack *s);
+void ngli_matrix_stack_reset(struct matrix_stack *s);
 
 #endif
@@ -41,6 +41,8 @@
 } while (0)
 
 #define NGLI_ARRAY_NB(x) ((int)(sizeof(x)/sizeof(*(x))))
+#define NGLI_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define NGLI_MIN(a, b) ((a) < (b) ? (a) : (b))
 #define NGLI_SWAP(type, a, b) do { type tmp_swap = b; b = a; a = tmp_swap; } while (0)
 
 #define NGLI_ALIGN 16
@@ -20,9 +20,11 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <sys/time.h>
 
 #include <GLFW/glfw3.h>
+#include <nodegl.h>
 
 #include "common.h"
 
@@ -72,3 +74,21 @@ GLFWwindow *get_window(const char *title, int width, int height)
     glfwMakeContextCurrent(window);
     return window;
 }
+
+int dump_trace(struct ngl_ctx *ctx, const char *filename)
+{
+    char *trace = ngl_get_trace(ctx);
+    if (!trace)
+        return -1;
+
+    int ret = 0;
+    FILE *f = fopen(filename, "w");
+    if (!f || fputs(trace, f) == EOF) {
+        fprintf(stderr, "Unable to write trace to %s\n", filename);
+        ret = -1;
+    }
+    if (f)
+        fclose(f);
+    free(trace);
+    return ret;
+}
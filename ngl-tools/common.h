@@ -26,6 +26,9 @@
 #include <stdint.h>
 
 #include <GLFW/glfw3.h>
+#include <nodegl.h>
+
+#define TRACE_NB_EVENTS (1<<18)
 
 int64_t gettime(void);
 double clipd(double v, double min, double max);
@@ -33,4 +36,6 @@ double clipd(double v, double min, double max);
 int init_glfw(void);
 GLFWwindow *get_window(const char *title, int width, int height);
 
+int dump_trace(struct ngl_ctx *ctx, const char *filename);
+
 #endif
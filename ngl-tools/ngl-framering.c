@@ -0,0 +1,206 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Reference consumer of the frame rings created by ngl_framering_create():
+ * the frames are accessed in place in the shared memory, and optionally
+ * dumped to a file.
+ */
+
+#define _GNU_SOURCE /* syscall() */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <nodegl.h>
+
+#include "common.h"
+
+/* Delay between 2 checks of the producer liveness while waiting for it */
+#define PRODUCER_CHECK_DELAY_NS 100000000
+
+static const char * const pix_fmts[] = {
+    [NGL_PIXFMT_RGBA] = "rgba",
+    [NGL_PIXFMT_NV12] = "nv12",
+    [NGL_PIXFMT_I420] = "i420",
+};
+
+static int futex_wait(uint32_t *addr, uint32_t val, const struct timespec *timeout)
+{
+    return syscall(SYS_futex, addr, FUTEX_WAIT, val, timeout, NULL, 0);
+}
+
+static void futex_wake(uint32_t *addr)
+{
+    syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+static int write_frame(int fd, const uint8_t *buf, size_t size)
+{
+    while (size) {
+        const ssize_t n = write(fd, buf, size);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        buf  += n;
+        size -= n;
+    }
+    return 0;
+}
+
+static int producer_exited(const struct ngl_framering_header *h)
+{
+    const pid_t pid = __atomic_load_n(&h->producer_pid, __ATOMIC_RELAXED);
+    return pid > 0 && kill(pid, 0) < 0 && errno == ESRCH;
+}
+
+int main(int argc, char *argv[])
+{
+    int ret = EXIT_FAILURE;
+    const char *input = NULL;
+    const char *output = NULL;
+    int verbose = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-v")) {
+            verbose = 1;
+        } else if (!strcmp(argv[i], "-o") && i < argc - 1) {
+            output = argv[++i];
+        } else if (!input) {
+            input = argv[i];
+        } else {
+            fprintf(stderr, "Unexpected option \"%s\"\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!input) {
+        fprintf(stderr, "Usage: %s [-o out.raw] [-v] /proc/<pid>/fd/<fd>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int out_fd = -1;
+    void *map = MAP_FAILED;
+    struct stat st;
+
+    const int fd = open(input, O_RDWR);
+    if (fd == -1 || fstat(fd, &st) == -1) {
+        fprintf(stderr, "Unable to open %s\n", input);
+        goto end;
+    }
+
+    map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "Unable to map %s\n", input);
+        goto end;
+    }
+
+    struct ngl_framering_header *h = map;
+    if (st.st_size < sizeof(*h) ||
+        h->magic != NGL_FRAMERING_MAGIC || h->version != NGL_FRAMERING_VERSION ||
+        h->format >= sizeof(pix_fmts)/sizeof(*pix_fmts) ||
+        h->data_offset + h->nb_slots * h->slot_size > st.st_size) {
+        fprintf(stderr, "%s is not a frame ring\n", input);
+        goto end;
+    }
+    const struct ngl_framering_slot *slots = (const struct ngl_framering_slot *)(h + 1);
+    const uint8_t *data = (const uint8_t *)map + h->data_offset;
+
+    if (output) {
+        out_fd = open(output, O_WRONLY|O_CREAT|O_TRUNC, 0644);
+        if (out_fd == -1) {
+            fprintf(stderr, "Unable to open %s\n", output);
+            goto end;
+        }
+    }
+
+    printf("%s: %dx%d %s, %d slots of %llu bytes\n", input, h->width, h->height,
+           pix_fmts[h->format], h->nb_slots, (unsigned long long)h->frame_size);
+
+    __atomic_store_n(&h->consumer_pid, (int32_t)getpid(), __ATOMIC_RELAXED);
+
+    const struct timespec timeout = {.tv_nsec = PRODUCER_CHECK_DELAY_NS};
+    uint32_t nb_read = __atomic_load_n(&h->nb_read, __ATOMIC_RELAXED);
+    int nb_frames = 0;
+    int64_t start = 0;
+
+    for (;;) {
+        const uint32_t seq = __atomic_load_n(&h->seq, __ATOMIC_ACQUIRE);
+        const uint32_t nb_written = __atomic_load_n(&h->nb_written, __ATOMIC_ACQUIRE);
+
+        if (nb_read != nb_written) {
+            const uint32_t index = nb_read % h->nb_slots;
+            const struct ngl_framering_slot *slot = &slots[index];
+            const uint8_t *frame = data + index * h->slot_size;
+
+            if (!nb_frames)
+                start = gettime();
+            if (verbose)
+                printf("frame %llu @ t=%f in slot %u\n",
+                       (unsigned long long)slot->frame_index, slot->time, index);
+            if (out_fd != -1 && write_frame(out_fd, frame, h->frame_size) < 0) {
+                fprintf(stderr, "Unable to write frame to %s\n", output);
+                goto end;
+            }
+            nb_frames++;
+
+            /* Hand the slot back to the producer */
+            nb_read++;
+            __atomic_store_n(&h->nb_read, nb_read, __ATOMIC_RELEASE);
+            futex_wake(&h->nb_read);
+            continue;
+        }
+
+        if (__atomic_load_n(&h->eos, __ATOMIC_ACQUIRE))
+            break;
+
+        if (futex_wait(&h->seq, seq, &timeout) < 0 && errno == ETIMEDOUT && producer_exited(h)) {
+            fprintf(stderr, "The producer exited before the end of the stream\n");
+            break;
+        }
+    }
+
+    const double tdiff = nb_frames ? (gettime() - start) / 1000000. : 0.;
+    printf("Received %d frames in %g (FPS=%g)\n", nb_frames, tdiff, tdiff ? nb_frames / tdiff : 0.);
+    ret = 0;
+
+end:
+    if (map != MAP_FAILED)
+        munmap(map, st.st_size);
+    if (out_fd != -1)
+        close(out_fd);
+    if (fd != -1)
+        close(fd);
+    return ret;
+}
@@ -20,6 +20,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include <nodegl.h>
 #include <sxplayer.h>
@@ -129,17 +130,24 @@ static void tick_callback(struct player *p)
 int main(int argc, char *argv[])
 {
     int ret;
-
-    if (argc < 2) {
-        fprintf(stderr, "Usage: %s <media>\n", argv[0]);
+    const char *trace_file = NULL;
+    const char *media;
+
+    if (argc == 4 && !strcmp(argv[1], "-T")) {
+        trace_file = argv[2];
+        media = argv[3];
+    } else if (argc == 2) {
+        media = argv[1];
+    } else {
+        fprintf(stderr, "Usage: %s [-T trace.json] <media>\n", argv[0]);
         return -1;
     }
 
-    ret = probe(argv[1]);
+    ret = probe(media);
     if (ret < 0)
         return ret;
 
-    struct ngl_node *scene = get_scene(argv[1]);
+    struct ngl_node *scene = get_scene(media);
     if (!scene)
         return -1;
 
@@ -151,8 +159,16 @@ int main(int argc, char *argv[])
     ngl_node_unrefp(&scene);
     p.tick_callback = tick_callback;
 
+    if (trace_file && ngl_set_trace(p.ngl, TRACE_NB_EVENTS) < 0) {
+        ret = -1;
+        goto end;
+    }
+
     player_main_loop();
 
+    if (trace_file)
+        dump_trace(p.ngl, trace_file);
+
 end:
     player_uninit();
 
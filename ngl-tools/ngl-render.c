@@ -62,6 +62,14 @@ end:
     return scene;
 }
 
+static const char * const pix_fmts[] = {
+    [NGL_PIXFMT_RGBA] = "rgba",
+    [NGL_PIXFMT_NV12] = "nv12",
+    [NGL_PIXFMT_I420] = "i420",
+};
+
+#define FRAMERING_NB_SLOTS 4
+
 struct range {
     float start;
     float duration;
@@ -73,11 +81,15 @@ int main(int argc, char *argv[])
     int ret = 0;
     const char *input = NULL;
     const char *output = NULL;
+    const char *pix_fmt = NULL;
+    int shm = 0;
+    const char *trace_file = NULL;
     int width = 320, height = 240;
     struct range ranges[128] = {0};
     struct range *r;
     int nb_ranges = 0;
     int show_window = 0;
+    int headless = 0;
     int swap_interval = 0;
     int debug = 0;
 
@@ -86,6 +98,10 @@ int main(int argc, char *argv[])
             debug = 1;
         } else if (!strcmp(argv[i], "-w")) {
             show_window = 1;
+        } else if (!strcmp(argv[i], "-headless")) {
+            headless = 1;
+        } else if (!strcmp(argv[i], "-shm")) {
+            shm = 1;
         } else if (argv[i][0] == '-' && i < argc - 1) {
             const char opt = argv[i][1];
             const char *arg = argv[i + 1];
@@ -93,6 +109,9 @@ int main(int argc, char *argv[])
                 case 'o':
                     output = arg;
                     break;
+                case 'f':
+                    pix_fmt = arg;
+                    break;
                 case 's':
                     if (sscanf(arg, "%dx%d", &width, &height) != 2) {
                         fprintf(stderr, "Invalid size format: \"%s\" "
@@ -103,6 +122,9 @@ int main(int argc, char *argv[])
                 case 'z':
                     swap_interval = atoi(arg);
                     break;
+                case 'T':
+                    trace_file = arg;
+                    break;
                 case 't':
                     if (nb_ranges >= sizeof(ranges)/sizeof(*ranges)) {
                         fprintf(stderr, "Too much ranges specified (max:%d)\n",
@@ -130,7 +152,7 @@ int main(int argc, char *argv[])
     }
 
     if (!input) {
-        fprintf(stderr, "Usage: %s [-o out.raw] [-s WxH] [-w] [-d] [-z swapinterval] input.ngl\n", argv[0]);
+        fprintf(stderr, "Usage: %s [-o out.raw | -shm] [-f rgba|nv12|i420] [-s WxH] [-w | -headless] [-d] [-z swapinterval] [-T trace.json] input.ngl\n", argv[0]);
         return EXIT_FAILURE;
     }
 
@@ -139,21 +161,45 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
 
-    printf("%s -> %s %dx%d\n", input, output ? output : "-", width, height);
-
-    if (init_glfw() < 0)
+    if (headless && show_window) {
+        fprintf(stderr, "The window can not be shown in headless mode\n");
         return EXIT_FAILURE;
+    }
 
-    GLFWwindow *window = get_window("ngl-render", width, height);
-    if (!window) {
-        glfwTerminate();
+    if (output && shm) {
+        fprintf(stderr, "The frames can not be written to both a file and a frame ring\n");
         return EXIT_FAILURE;
     }
 
-    if (!show_window)
-        glfwHideWindow(window);
+    int pix_fmt_id = NGL_PIXFMT_RGBA;
+    if (pix_fmt) {
+        for (pix_fmt_id = 0; pix_fmt_id < sizeof(pix_fmts)/sizeof(*pix_fmts); pix_fmt_id++)
+            if (!strcmp(pix_fmts[pix_fmt_id], pix_fmt))
+                break;
+        if (pix_fmt_id == sizeof(pix_fmts)/sizeof(*pix_fmts)) {
+            fprintf(stderr, "Unknown pixel format \"%s\"\n", pix_fmt);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("%s -> %s %dx%d\n", input, output ? output : shm ? "frame ring" : "-", width, height);
+
+    GLFWwindow *window = NULL;
+    if (!headless) {
+        if (init_glfw() < 0)
+            return EXIT_FAILURE;
+
+        window = get_window("ngl-render", width, height);
+        if (!window) {
+            glfwTerminate();
+            return EXIT_FAILURE;
+        }
+
+        if (!show_window)
+            glfwHideWindow(window);
 
-    glfwSwapInterval(swap_interval);
+        glfwSwapInterval(swap_interval);
+    }
 
     int fd = -1;
     struct ngl_ctx *ctx = NULL;
@@ -164,26 +210,54 @@ int main(int argc, char *argv[])
         goto end;
     }
 
-    if (output) {
-        fd = open(output, O_WRONLY|O_CREAT|O_TRUNC, 0644);
-        if (fd == -1) {
-            fprintf(stderr, "Unable to open %s\n", output);
-            ret = EXIT_FAILURE;
-            goto end;
+    if (output || shm) {
+        if (shm) {
+            fd = ngl_framering_create(width, height, pix_fmt_id, FRAMERING_NB_SLOTS);
+            if (fd == -1) {
+                fprintf(stderr, "Unable to create the frame ring\n");
+                ret = EXIT_FAILURE;
+                goto end;
+            }
+            /* The consumer (ngl-framering for instance) opens the ring
+             * through this path, and the rendering waits for it */
+            printf("Frame ring: /proc/%d/fd/%d\n", (int)getpid(), fd);
+            fflush(stdout);
+        } else {
+            fd = open(output, O_WRONLY|O_CREAT|O_TRUNC, 0644);
+            if (fd == -1) {
+                fprintf(stderr, "Unable to open %s\n", output);
+                ret = EXIT_FAILURE;
+                goto end;
+            }
         }
-        if (ngl_node_param_set(scene, "pipe_fd", fd) < 0) {
+        const char *fd_key = shm ? "shm_fd" : "pipe_fd";
+        if (ngl_node_param_set(scene, fd_key, fd) < 0) {
             struct ngl_node *camera = ngl_node_create(NGL_NODE_CAMERA, scene);
             ngl_node_unrefp(&scene);
             scene = camera;
-            ngl_node_param_set(scene, "pipe_fd", fd);
+            ngl_node_param_set(scene, fd_key, fd);
         }
         ngl_node_param_set(scene, "pipe_width", width);
         ngl_node_param_set(scene, "pipe_height", height);
+        ngl_node_param_set(scene, "pipe_format", pix_fmts[pix_fmt_id]);
     }
 
     ctx = ngl_create();
-    ngl_set_glcontext(ctx, NULL, NULL, NULL, NGL_GLPLATFORM_AUTO, NGL_GLAPI_AUTO);
-    glViewport(0, 0, width, height);
+    if (headless) {
+        if (ngl_set_glcontext_offscreen(ctx, width, height, NGL_GLPLATFORM_AUTO, NGL_GLAPI_AUTO) < 0) {
+            fprintf(stderr, "Unable to create an offscreen GL context\n");
+            ret = EXIT_FAILURE;
+            goto end;
+        }
+    } else {
+        ngl_set_glcontext(ctx, NULL, NULL, NULL, NGL_GLPLATFORM_AUTO, NGL_GLAPI_AUTO);
+        glViewport(0, 0, width, height);
+    }
+
+    if (trace_file && ngl_set_trace(ctx, TRACE_NB_EVENTS) < 0) {
+        ret = EXIT_FAILURE;
+        goto end;
+    }
 
     ret = ngl_set_scene(ctx, scene);
     ngl_node_unrefp(&scene);
@@ -210,8 +284,10 @@ int main(int argc, char *argv[])
                 fprintf(stderr, "Unable to draw @ t=%g\n", t);
                 goto end;
             }
-            glfwSwapBuffers(window);
-            glfwPollEvents();
+            if (window) {
+                glfwSwapBuffers(window);
+                glfwPollEvents();
+            }
             k++;
         }
 
@@ -220,13 +296,17 @@ int main(int argc, char *argv[])
     }
 
 end:
+    if (ctx && trace_file)
+        dump_trace(ctx, trace_file);
     ngl_free(&ctx);
 
     if (fd != -1)
         close(fd);
 
-    glfwDestroyWindow(window);
-    glfwTerminate();
+    if (window) {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+    }
 
     return ret;
 }
@@ -28,8 +28,9 @@ class _PipeThread(QtCore.QThread):
 
 class _ReaderThread(_PipeThread):
 
-    def __init__(self, fd, unused_fd, w, h, fps, filename, extra_enc_args):
+    def __init__(self, fd, unused_fd, w, h, fps, pix_fmt, filename, extra_enc_args):
         super(_ReaderThread, self).__init__(fd, unused_fd, w, h, fps)
+        self._pix_fmt = pix_fmt
         self._filename = filename
         self._extra_enc_args = extra_enc_args if extra_enc_args else []
 
@@ -38,7 +39,7 @@ class _ReaderThread(_PipeThread):
                '-nostats', '-nostdin',
                '-f', 'rawvideo',
                '-video_size', '%dx%d' % (self.w, self.h),
-               '-pixel_format', 'rgba',
+               '-pixel_format', self._pix_fmt,
                '-i', 'pipe:%d' % self.fd] + \
                 self._extra_enc_args + \
                ['-y', self._filename]
@@ -64,7 +65,16 @@ class Exporter(QtCore.QObject):
         camera.set_pipe_width(w)
         camera.set_pipe_height(h)
 
-        reader = _ReaderThread(fd_r, fd_w, w, h, fps, filename, extra_enc_args)
+        # The frames are converted to YUV by node.gl whenever the dimensions
+        # allow it, sparing the conversion to ffmpeg and most of the pipe
+        # bandwidth
+        if w % 8 == 0 and h % 4 == 0:
+            camera.set_pipe_format('i420')
+            pix_fmt = 'yuv420p'
+        else:
+            pix_fmt = 'rgba'
+
+        reader = _ReaderThread(fd_r, fd_w, w, h, fps, pix_fmt, filename, extra_enc_args)
         reader.start()
 
         # GL context
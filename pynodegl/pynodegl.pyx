@@ -1,4 +1,5 @@
 from libc.stdlib cimport calloc
+from libc.stdint cimport int64_t
 
 cdef extern from "nodegl.h":
     cdef int NGL_LOG_VERBOSE
@@ -20,12 +21,14 @@ cdef extern from "nodegl.h":
     int ngl_node_param_set(ngl_node *node, const char *key, ...)
     char *ngl_node_dot(const ngl_node *node)
     char *ngl_node_serialize(const ngl_node *node)
+    int64_t ngl_node_get_gpu_time(const ngl_node *node)
 
     cdef int NGL_GLPLATFORM_AUTO
     cdef int NGL_GLPLATFORM_GLX
     cdef int NGL_GLPLATFORM_EGL
     cdef int NGL_GLPLATFORM_CGL
     cdef int NGL_GLPLATFORM_EAGL
+    cdef int NGL_GLPLATFORM_NULL
 
     cdef int NGL_GLAPI_AUTO
     cdef int NGL_GLAPI_OPENGL3
@@ -35,21 +38,60 @@ cdef extern from "nodegl.h":
 
     ngl_ctx *ngl_create()
     int ngl_set_glcontext(ngl_ctx *s, void *display, void *window, void *handle, int platform, int api)
+    int ngl_set_glcontext_offscreen(ngl_ctx *s, int width, int height, int platform, int api)
     int ngl_set_glstates(ngl_ctx *s, int nb_glstates,  ngl_node **glstates);
     int ngl_set_scene(ngl_ctx *s, ngl_node *scene)
+    int ngl_set_nb_threads(ngl_ctx *s, int nb_threads)
+    int ngl_set_async_prefetch(ngl_ctx *s, int enabled)
+    int ngl_set_program_cache_dir(ngl_ctx *s, const char *dir)
+    int ngl_set_gpu_memory_budget(ngl_ctx *s, int64_t budget)
+    cdef int NGL_GPU_MEMORY_BUFFERS
+    cdef int NGL_GPU_MEMORY_TEXTURES
+    cdef int NGL_GPU_MEMORY_RENDERBUFFERS
+    cdef int NGL_GPU_MEMORY_TOTAL
+    int64_t ngl_get_gpu_memory(ngl_ctx *s, int type)
+    int ngl_set_prefetch_margin(ngl_ctx *s, double margin)
+    int ngl_prepare_shaders(ngl_ctx *s)
+    ctypedef void (*ngl_progress_callback_type)(void *arg, int done, int total)
+    int ngl_prepare(ngl_ctx *s, double t_start, double t_end,
+                    ngl_progress_callback_type callback, void *arg)
+    int ngl_set_stats(ngl_ctx *s, int enabled)
+    char *ngl_get_stats(ngl_ctx *s)
+    int ngl_set_trace(ngl_ctx *s, int nb_events)
+    char *ngl_get_trace(ngl_ctx *s)
+    char *ngl_get_gl_log(ngl_ctx *s)
     int ngl_draw(ngl_ctx *s, double t) nogil
     void ngl_free(ngl_ctx **ss)
 
+    cdef int NGL_PIXFMT_RGBA
+    cdef int NGL_PIXFMT_NV12
+    cdef int NGL_PIXFMT_I420
+
+    int ngl_framering_create(int width, int height, int format, int nb_slots)
+
 GLPLATFORM_AUTO = NGL_GLPLATFORM_AUTO
 GLPLATFORM_GLX  = NGL_GLPLATFORM_GLX
 GLPLATFORM_EGL  = NGL_GLPLATFORM_EGL
 GLPLATFORM_CGL  = NGL_GLPLATFORM_CGL
 GLPLATFORM_EAGL = NGL_GLPLATFORM_EAGL
+GLPLATFORM_NULL = NGL_GLPLATFORM_NULL
 
 GLAPI_AUTO      = NGL_GLAPI_AUTO
 GLAPI_OPENGL3   = NGL_GLAPI_OPENGL3
 GLAPI_OPENGLES2 = NGL_GLAPI_OPENGLES2
 
+GPU_MEMORY_BUFFERS       = NGL_GPU_MEMORY_BUFFERS
+GPU_MEMORY_TEXTURES      = NGL_GPU_MEMORY_TEXTURES
+GPU_MEMORY_RENDERBUFFERS = NGL_GPU_MEMORY_RENDERBUFFERS
+GPU_MEMORY_TOTAL         = NGL_GPU_MEMORY_TOTAL
+
+PIXFMT_RGBA = NGL_PIXFMT_RGBA
+PIXFMT_NV12 = NGL_PIXFMT_NV12
+PIXFMT_I420 = NGL_PIXFMT_I420
+
+cdef void _progress_callback(void *arg, int done, int total) with gil:
+    (<object>arg)(done, total)
+
 LOG_VERBOSE = NGL_LOG_VERBOSE
 LOG_DEBUG   = NGL_LOG_DEBUG
 LOG_INFO    = NGL_LOG_INFO
@@ -61,6 +103,9 @@ include "nodes_def.pyx"
 def log_set_min_level(int level):
     ngl_log_set_min_level(level)
 
+def framering_create(int width, int height, int format, int nb_slots):
+    return ngl_framering_create(width, height, format, nb_slots)
+
 cdef class Viewer:
     cdef ngl_ctx *ctx
 
@@ -72,6 +117,9 @@ cdef class Viewer:
     def configure(self, int platform, int api):
         return ngl_set_glcontext(self.ctx, NULL, NULL, NULL, platform, api);
 
+    def configure_offscreen(self, int width, int height, int platform, int api):
+        return ngl_set_glcontext_offscreen(self.ctx, width, height, platform, api)
+
     def set_glstates(self, *glstates):
         if not glstates:
             return ngl_set_glstates(self.ctx, 0, NULL)
@@ -92,6 +140,47 @@ cdef class Viewer:
     def set_scene(self, _Node scene):
         return ngl_set_scene(self.ctx, scene.ctx)
 
+    def set_nb_threads(self, int nb_threads):
+        return ngl_set_nb_threads(self.ctx, nb_threads)
+
+    def set_async_prefetch(self, int enabled):
+        return ngl_set_async_prefetch(self.ctx, enabled)
+
+    def set_program_cache_dir(self, const char *dir):
+        return ngl_set_program_cache_dir(self.ctx, dir)
+
+    def set_gpu_memory_budget(self, int64_t budget):
+        return ngl_set_gpu_memory_budget(self.ctx, budget)
+
+    def get_gpu_memory(self, int type=NGL_GPU_MEMORY_TOTAL):
+        return ngl_get_gpu_memory(self.ctx, type)
+
+    def set_prefetch_margin(self, double margin):
+        return ngl_set_prefetch_margin(self.ctx, margin)
+
+    def prepare_shaders(self):
+        return ngl_prepare_shaders(self.ctx)
+
+    def prepare(self, double t_start, double t_end, progress_callback=None):
+        if progress_callback is None:
+            return ngl_prepare(self.ctx, t_start, t_end, NULL, NULL)
+        return ngl_prepare(self.ctx, t_start, t_end, _progress_callback, <void *>progress_callback)
+
+    def set_stats(self, int enabled):
+        return ngl_set_stats(self.ctx, enabled)
+
+    def get_stats(self):
+        return _ret_pystr(ngl_get_stats(self.ctx))
+
+    def set_trace(self, int nb_events):
+        return ngl_set_trace(self.ctx, nb_events)
+
+    def get_trace(self):
+        return _ret_pystr(ngl_get_trace(self.ctx))
+
+    def get_gl_log(self):
+        return _ret_pystr(ngl_get_gl_log(self.ctx))
+
     def draw(self, double t):
         with nogil:
             ngl_draw(self.ctx, t)
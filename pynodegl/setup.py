@@ -180,6 +180,9 @@ cdef class _Node:
     def dot(self):
         return _ret_pystr(ngl_node_dot(self.ctx))
 
+    def get_gpu_time(self):
+        return ngl_node_get_gpu_time(self.ctx)
+
     def __dealloc__(self):
         ngl_node_unrefp(&self.ctx)
 '''
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2017 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * Regression tests running on the null GL platform, so they do not need any
+ * GPU nor window system. They check the GL calls recorded by the context
+ * (see ngl_get_gl_log()) while drawing small scenes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nodegl.h>
+
+#define CHECK(cond) do {                                                \
+    if (!(cond)) {                                                      \
+        fprintf(stderr, "%s:%d: check failed: %s\n",                    \
+                __FILE__, __LINE__, #cond);                             \
+        ret = -1;                                                       \
+        goto end;                                                       \
+    }                                                                   \
+} while (0)
+
+/*
+ * Return the value of a counter or the number of calls to a GL function from
+ * a GL log, which are both reported as "name,value" lines.
+ */
+static long get_log_value(const char *log, const char *name)
+{
+    const size_t len = strlen(name);
+    const char *p = log;
+
+    while (p && *p) {
+        if (!strncmp(p, name, len) && p[len] == ',')
+            return strtol(p + len + 1, NULL, 10);
+        p = strchr(p, '\n');
+        if (p)
+            p++;
+    }
+    return 0;
+}
+
+static long get_draw_value(struct ngl_ctx *ctx, double t, const char *name)
+{
+    if (ngl_draw(ctx, t) < 0)
+        return -1;
+
+    char *log = ngl_get_gl_log(ctx);
+    if (!log)
+        return -1;
+
+    const long value = get_log_value(log, name);
+    free(log);
+    return value;
+}
+
+static struct ngl_ctx *create_context(void)
+{
+    struct ngl_ctx *ctx = ngl_create();
+    if (!ctx)
+        return NULL;
+
+    if (ngl_set_glcontext(ctx, NULL, NULL, NULL, NGL_GLPLATFORM_NULL, NGL_GLAPI_OPENGL3) < 0)
+        ngl_free(&ctx);
+
+    return ctx;
+}
+
+static struct ngl_node *create_shape(struct ngl_node *quad, struct ngl_node *shader)
+{
+    return ngl_node_create(NGL_NODE_TEXTUREDSHAPE, quad, shader);
+}
+
+/*
+ * The GL state is shadowed by the context: drawing the same scene again must
+ * not query it, and the program shared by the shapes is only bound once.
+ */
+static int test_redundant_calls(void)
+{
+    int ret = 0;
+    char *log = NULL;
+    struct ngl_node *quad   = ngl_node_create(NGL_NODE_QUAD);
+    struct ngl_node *shader = ngl_node_create(NGL_NODE_SHADER);
+    struct ngl_node *shapes[2] = {create_shape(quad, shader), create_shape(quad, shader)};
+    struct ngl_node *group  = ngl_node_create(NGL_NODE_GROUP);
+    struct ngl_ctx *ctx     = create_context();
+
+    CHECK(ctx && group && shapes[0] && shapes[1]);
+    CHECK(ngl_node_param_add(group, "children", 2, shapes) >= 0);
+    CHECK(ngl_set_scene(ctx, group) >= 0);
+
+    CHECK(ngl_draw(ctx, 0.0) >= 0);
+    free(ngl_get_gl_log(ctx));
+
+    CHECK(ngl_draw(ctx, 1.0) >= 0);
+    log = ngl_get_gl_log(ctx);
+    CHECK(log);
+    CHECK(get_log_value(log, "draw_calls") == 2);
+    CHECK(get_log_value(log, "glGetIntegerv") == 0);
+    CHECK(get_log_value(log, "glGetBooleanv") == 0);
+    CHECK(get_log_value(log, "glUseProgram") <= 1);
+    CHECK(get_log_value(log, "glBindVertexArray") <= 2);
+
+end:
+    free(log);
+    ngl_free(&ctx);
+    ngl_node_unrefp(&group);
+    ngl_node_unrefp(&shapes[0]);
+    ngl_node_unrefp(&shapes[1]);
+    ngl_node_unrefp(&shader);
+    ngl_node_unrefp(&quad);
+    return ret;
+}
+
+/* Live parameters are applied in place, without reinitializing the nodes */
+static int test_live_change(void)
+{
+    int ret = 0;
+    char *log = NULL;
+    struct ngl_node *quad   = ngl_node_create(NGL_NODE_QUAD);
+    struct ngl_node *shader = ngl_node_create(NGL_NODE_SHADER);
+    struct ngl_node *shape  = create_shape(quad, shader);
+    struct ngl_node *rotate = ngl_node_create(NGL_NODE_ROTATE, shape);
+    struct ngl_ctx *ctx     = create_context();
+
+    CHECK(ctx && rotate);
+    CHECK(ngl_set_scene(ctx, rotate) >= 0);
+
+    CHECK(ngl_draw(ctx, 0.0) >= 0);
+    free(ngl_get_gl_log(ctx));
+
+    CHECK(ngl_node_param_set(quad, "corner", (const float[3]){-1.0f, -1.0f, 0.0f}) >= 0);
+    CHECK(ngl_node_param_set(rotate, "angle", 45.0) >= 0);
+
+    CHECK(ngl_draw(ctx, 0.0) >= 0);
+    log = ngl_get_gl_log(ctx);
+    CHECK(log);
+    CHECK(get_log_value(log, "draw_calls") == 1);
+    CHECK(get_log_value(log, "glBufferSubData") == 1);
+    CHECK(get_log_value(log, "glGenBuffers") == 0);
+    CHECK(get_log_value(log, "glDeleteBuffers") == 0);
+    CHECK(get_log_value(log, "glCreateProgram") == 0);
+    CHECK(get_log_value(log, "glLinkProgram") == 0);
+
+end:
+    free(log);
+    ngl_free(&ctx);
+    ngl_node_unrefp(&rotate);
+    ngl_node_unrefp(&shape);
+    ngl_node_unrefp(&shader);
+    ngl_node_unrefp(&quad);
+    return ret;
+}
+
+/*
+ * Render ranges are looked up by bisection, so seeking anywhere, including
+ * backward, must land in the right range.
+ */
+#define NB_RANGES 101
+
+static int test_timeline_seek(void)
+{
+    int ret = 0;
+    struct ngl_node *ranges[NB_RANGES] = {0};
+    struct ngl_node *quad   = ngl_node_create(NGL_NODE_QUAD);
+    struct ngl_node *shader = ngl_node_create(NGL_NODE_SHADER);
+    struct ngl_node *shape  = create_shape(quad, shader);
+    struct ngl_ctx *ctx     = create_context();
+
+    CHECK(ctx && shape);
+
+    /* Even ranges are drawn, odd ranges are not */
+    for (int i = 0; i < NB_RANGES; i++) {
+        const int type = i & 1 ? NGL_NODE_RENDERRANGENORENDER : NGL_NODE_RENDERRANGECONTINUOUS;
+        ranges[i] = ngl_node_create(type, (double)i);
+        CHECK(ranges[i]);
+    }
+    CHECK(ngl_node_param_add(shape, "ranges", NB_RANGES, ranges) >= 0);
+    CHECK(ngl_set_scene(ctx, shape) >= 0);
+
+    for (int i = 0; i < NB_RANGES; i++) {
+        const int range = i * 37 % NB_RANGES;
+        const long draw_calls = get_draw_value(ctx, range + 0.5, "draw_calls");
+        CHECK(draw_calls == !(range & 1));
+    }
+
+    /* Same sequence from the end, one range at a time */
+    for (int i = NB_RANGES - 1; i >= 0; i--)
+        CHECK(get_draw_value(ctx, i + 0.5, "draw_calls") == !(i & 1));
+
+end:
+    ngl_free(&ctx);
+    for (int i = 0; i < NB_RANGES; i++)
+        ngl_node_unrefp(&ranges[i]);
+    ngl_node_unrefp(&shape);
+    ngl_node_unrefp(&shader);
+    ngl_node_unrefp(&quad);
+    return ret;
+}
+
+struct progress {
+    int nb_calls;
+    int done;
+    int total;
+    int error;
+};
+
+static void progress_callback(void *arg, int done, int total)
+{
+    struct progress *p = arg;
+
+    if (done != p->done + 1 || done > total || (p->nb_calls && total != p->total))
+        p->error = 1;
+    p->nb_calls++;
+    p->done = done;
+    p->total = total;
+}
+
+/* Everything is ready after ngl_prepare(), and the progress is consistent */
+static int test_prepare(void)
+{
+    int ret = 0;
+    char *log = NULL;
+    struct progress progress = {0};
+    struct ngl_node *quad   = ngl_node_create(NGL_NODE_QUAD);
+    struct ngl_node *shader = ngl_node_create(NGL_NODE_SHADER);
+    struct ngl_node *shapes[2] = {create_shape(quad, shader), create_shape(quad, shader)};
+    struct ngl_node *group  = ngl_node_create(NGL_NODE_GROUP);
+    struct ngl_ctx *ctx     = create_context();
+
+    CHECK(ctx && group && shapes[0] && shapes[1]);
+    CHECK(ngl_node_param_add(group, "children", 2, shapes) >= 0);
+    CHECK(ngl_set_scene(ctx, group) >= 0);
+
+    CHECK(ngl_prepare(ctx, 0.0, 10.0, progress_callback, &progress) >= 0);
+    CHECK(!progress.error);
+    CHECK(progress.nb_calls > 0);
+    CHECK(progress.done == progress.total);
+    free(ngl_get_gl_log(ctx));
+
+    CHECK(ngl_draw(ctx, 0.0) >= 0);
+    log = ngl_get_gl_log(ctx);
+    CHECK(log);
+    CHECK(get_log_value(log, "draw_calls") == 2);
+    CHECK(get_log_value(log, "glCreateProgram") == 0);
+    CHECK(get_log_value(log, "glGenBuffers") == 0);
+    CHECK(get_log_value(log, "glGenTextures") == 0);
+
+end:
+    free(log);
+    ngl_free(&ctx);
+    ngl_node_unrefp(&group);
+    ngl_node_unrefp(&shapes[0]);
+    ngl_node_unrefp(&shapes[1]);
+    ngl_node_unrefp(&shader);
+    ngl_node_unrefp(&quad);
+    return ret;
+}
+
+static const struct {
+    const char *name;
+    int (*func)(void);
+} tests[] = {
+    {"redundant_calls", test_redundant_calls},
+    {"live_change",     test_live_change},
+    {"timeline_seek",   test_timeline_seek},
+    {"prepare",         test_prepare},
+};
+
+int main(int ac, char **av)
+{
+    int nb_failed = 0;
+
+    ngl_log_set_min_level(NGL_LOG_WARNING);
+
+    for (int i = 0; i < sizeof(tests) / sizeof(*tests); i++) {
+        if (ac > 1 && strcmp(av[1], tests[i].name))
+            continue;
+        const int failed = tests[i].func() < 0;
+        printf("%-16s %s\n", tests[i].name, failed ? "FAIL" : "OK");
+        nb_failed += failed;
+    }
+
+    return nb_failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}